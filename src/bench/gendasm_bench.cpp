@@ -0,0 +1,525 @@
+//
+//	Benchmark Harness
+//	for the Generic Code-Seeking Disassembler
+//	Copyright(c)2021 by Donna Whisnant
+//
+
+//
+//	This times the hot paths of gendasm and funcanal against the test data
+//	in src/test/data, staged into a work directory:
+//
+//		gendasm/<dataset>/<image>/ReadControlFile	-- Control file and source image loading
+//		gendasm/<dataset>/<image>/Pass1				-- Finding Code, Data, and Labels
+//		gendasm/<dataset>/<image>/Pass2				-- Disassembly output
+//		gendasm/<dataset>/<image>/Pass3				-- Functions output
+//		funcanal/<dataset>/<image>/ReadFuncDescFile	-- Reading the functions output of Pass3
+//		funcanal/<dataset>/CompareFunctions/<method>/<bucket>
+//													-- Individual comparisons of pairs of functions
+//													   that are both within a size bucket
+//		funcanal/<dataset>/Matrix/<method>/threads:<n>
+//													-- Whole function comparison matrix generation
+//
+//	Each benchmark is run for the specified number of repetitions and the
+//	results are written as JSON (to stdout or the -o file) so that they can
+//	be tracked over time.  Progress is written to stderr.
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <thread>
+
+#include <gdc.h>
+#include <dfc.h>
+#include <stringhelp.h>
+
+#include <dfc/binary/binarydfc.h>
+#include <dfc/intel/inteldfc.h>
+#include <dfc/srec/srecdfc.h>
+#ifdef ELF_SUPPORT
+#include <dfc/elf/elfdfc.h>
+#endif
+
+#include <cpu/m6811/m6811gdc.h>
+#include <cpu/avr/avrgdc.h>
+
+#include <funcanal.h>
+#include <funcdesc.h>
+#include <funccomp.h>
+#include <funcmtx.h>
+
+#include <assert.h>
+
+#define VERSION 0x100				// Benchmark Harness Version number 1.00
+#define RESULTS_FORMAT_VERSION 1	// Version of the JSON results layout
+
+// ============================================================================
+
+//////////////////////////////////////////////////////////////////////
+// CBenchResults Class
+//////////////////////////////////////////////////////////////////////
+//		Collects the timing samples of each benchmark, in the order the
+//		benchmarks were first run, and writes them out as JSON.  Items is
+//		the number of operations timed by each sample (such as the number
+//		of function pairs compared), used to report the time per item.
+class CBenchResults
+{
+public:
+	void add(const std::string &strName, double nMilliseconds, std::size_t nItems = 1)
+	{
+		auto itrResult = std::find_if(m_arrResults.begin(), m_arrResults.end(),
+										[&strName](const CResult &aResult)->bool { return (aResult.m_strName == strName); });
+		if (itrResult == m_arrResults.end()) {
+			m_arrResults.push_back({ strName, nItems, {} });
+			itrResult = m_arrResults.end() - 1;
+		}
+		assert(itrResult->m_nItems == nItems);
+		itrResult->m_arrSamples.push_back(nMilliseconds);
+		std::cerr << "  " << strName << " : " << std::fixed << std::setprecision(3) << nMilliseconds << " ms\n";
+	}
+
+	void writeJSON(std::ostream &outFile, int nRepetitions, unsigned int nMaxThreads) const
+	{
+		outFile << "{\n";
+		outFile << "  \"benchmark\": \"gendasm_bench\",\n";
+		outFile << "  \"format_version\": " << RESULTS_FORMAT_VERSION << ",\n";
+		outFile << "  \"repetitions\": " << nRepetitions << ",\n";
+		outFile << "  \"max_threads\": " << nMaxThreads << ",\n";
+		outFile << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+		outFile << "  \"results\": [";
+		for (std::size_t ndx = 0; ndx < m_arrResults.size(); ++ndx) {
+			const CResult &aResult = m_arrResults.at(ndx);
+			std::vector<double> arrSorted = aResult.m_arrSamples;
+			std::sort(arrSorted.begin(), arrSorted.end());
+			double nMedian = ((arrSorted.size() & 1) ? arrSorted.at(arrSorted.size()/2) :
+								((arrSorted.at((arrSorted.size()/2)-1) + arrSorted.at(arrSorted.size()/2)) / 2.0));
+			double nMean = 0.0;
+			for (auto const &nSample : arrSorted) nMean += nSample;
+			nMean /= arrSorted.size();
+
+			outFile << (ndx ? ",\n" : "\n");
+			outFile << "    { \"name\": \"" << aResult.m_strName << "\""
+					<< ", \"items\": " << aResult.m_nItems
+					<< ", \"samples\": " << arrSorted.size()
+					<< std::fixed << std::setprecision(6)
+					<< ", \"min_ms\": " << arrSorted.front()
+					<< ", \"median_ms\": " << nMedian
+					<< ", \"mean_ms\": " << nMean
+					<< ", \"max_ms\": " << arrSorted.back()
+					<< std::setprecision(1)
+					<< ", \"median_ns_per_item\": " << ((nMedian * 1000000.0) / aResult.m_nItems)
+					<< " }";
+		}
+		outFile << "\n  ]\n";
+		outFile << "}\n";
+	}
+
+private:
+	struct CResult {
+		std::string m_strName;
+		std::size_t m_nItems;
+		std::vector<double> m_arrSamples;
+	};
+	std::vector<CResult> m_arrResults;
+};
+
+// ----------------------------------------------------------------------------
+
+// Times a single call of fnWork, returning milliseconds:
+template<typename TFunction>
+static double timeIt(const TFunction &fnWork)
+{
+	auto tStart = std::chrono::steady_clock::now();
+	fnWork();
+	auto tEnd = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::milli>(tEnd - tStart).count();
+}
+
+// ============================================================================
+
+//////////////////////////////////////////////////////////////////////
+// CBenchDisassembler Class
+//////////////////////////////////////////////////////////////////////
+//		Exposes the passes of a disassembler so they can be timed
+//		individually rather than through Disassemble():
+template<class TDisassembler>
+class CBenchDisassembler : public TDisassembler
+{
+public:
+	using TDisassembler::Pass1;
+	using TDisassembler::Pass2;
+	using TDisassembler::Pass3;
+
+	std::string outputFilename() const { return this->m_sOutputFilename; }
+};
+
+// Runs and times the disassembly of one control file, returning the
+//	functions output filename (if any) or an empty string on failure:
+template<class TDisassembler>
+static std::string benchDisassembly(CBenchResults &results, const std::string &strPrefix,
+										const std::string &strControlFile, int nRepetitions)
+{
+	std::string strFunctionsFilename;
+
+	for (int nRep = 0; nRep < nRepetitions; ++nRep) {
+		CBenchDisassembler<TDisassembler> aDisassembler;
+		aDisassembler.setDeterministic(true);
+		std::ostringstream ssMessages;			// Disassembler messages aren't needed, but still need to be generated
+
+		ifstreamControlFile CtrlFile(strControlFile);
+		if (!CtrlFile.is_open()) {
+			std::cerr << "*** Error: Opening control file \"" << strControlFile << "\" for reading...\n";
+			return std::string();
+		}
+		bool bOK = true;
+		results.add(strPrefix + "/ReadControlFile", timeIt([&]()->void {
+			bOK = aDisassembler.ReadControlFile(CtrlFile, true, &ssMessages, &ssMessages);
+		}));
+		CtrlFile.close();
+		if (!bOK) {
+			std::cerr << "*** Error: Reading control file \"" << strControlFile << "\"\n" << ssMessages.str();
+			return std::string();
+		}
+
+		std::fstream fileOutput(aDisassembler.outputFilename(), std::ios_base::out | std::ios_base::trunc);
+		if (!fileOutput.is_open()) {
+			std::cerr << "*** Error: Opening file \"" << aDisassembler.outputFilename() << "\" for writing...\n";
+			return std::string();
+		}
+		results.add(strPrefix + "/Pass1", timeIt([&]()->void {
+			bOK = aDisassembler.Pass1(fileOutput, &ssMessages, &ssMessages);
+		}));
+		if (bOK) {
+			results.add(strPrefix + "/Pass2", timeIt([&]()->void {
+				bOK = aDisassembler.Pass2(fileOutput, &ssMessages, &ssMessages);
+			}));
+		}
+		if (bOK && !aDisassembler.functionsFilename().empty()) {
+			results.add(strPrefix + "/Pass3", timeIt([&]()->void {
+				bOK = aDisassembler.Pass3(fileOutput, &ssMessages, &ssMessages);
+			}));
+			strFunctionsFilename = aDisassembler.functionsFilename();
+		}
+		fileOutput.close();
+		if (!bOK) {
+			std::cerr << "*** Error: Disassembling \"" << strControlFile << "\"\n" << ssMessages.str();
+			return std::string();
+		}
+	}
+
+	return strFunctionsFilename;
+}
+
+// ============================================================================
+
+static const char *methodName(FUNC_COMPARE_METHOD nMethod)
+{
+	switch (nMethod) {
+		case FCM_DYNPROG_XDROP:
+			return "xdrop";
+		case FCM_DYNPROG_GREEDY:
+			return "greedy";
+		case FCM_DYNPROG_XDROP_VECTOR:
+			return "xdrop_vector";
+		default:
+			break;
+	}
+	return "unknown";
+}
+
+// Size buckets (in function objects) for timing individual comparisons:
+struct CSizeBucket {
+	const char *m_pszName;
+	CFuncDesc::size_type m_nMinSize;
+	CFuncDesc::size_type m_nMaxSize;		// Inclusive
+};
+
+static const CSizeBucket g_arrSizeBuckets[] = {
+	{ "size:1-15", 1, 15 },
+	{ "size:16-63", 16, 63 },
+	{ "size:64-255", 64, 255 },
+	{ "size:256+", 256, static_cast<CFuncDesc::size_type>(-1) },
+};
+
+#define MAX_BUCKET_PAIRS 256		// Maximum number of function pairs to compare in each size bucket
+
+static volatile double g_nResultSink = 0.0;
+
+static std::shared_ptr<CFuncDescFile> benchReadFuncDescFile(CBenchResults &results, const std::string &strPrefix,
+																const std::string &strFilename, int nRepetitions)
+{
+	std::shared_ptr<CFuncDescFile> pFuncDescFile;
+
+	for (int nRep = 0; nRep < nRepetitions; ++nRep) {
+		pFuncDescFile = std::make_shared<CFuncDescFile>();
+		ifstreamFuncDescFile fileFunc(strFilename);
+		if (!fileFunc.is_open()) {
+			std::cerr << "*** Error: Opening Function Definition File \"" << strFilename << "\" for reading...\n";
+			return std::shared_ptr<CFuncDescFile>();
+		}
+		std::ostringstream ssMessages;
+		bool bOK = true;
+		results.add(strPrefix + "/ReadFuncDescFile", timeIt([&]()->void {
+			bOK = pFuncDescFile->ReadFuncDescFile(pFuncDescFile, fileFunc, &ssMessages, &ssMessages);
+		}));
+		fileFunc.close();
+		if (!bOK) {
+			std::cerr << "*** Error: Reading Function Definition File \"" << strFilename << "\"\n" << ssMessages.str();
+			return std::shared_ptr<CFuncDescFile>();
+		}
+	}
+
+	return pFuncDescFile;
+}
+
+static void benchCompareFunctions(CBenchResults &results, const std::string &strPrefix,
+									const CFuncDescFile &file1, const CFuncDescFile &file2, int nRepetitions)
+{
+	for (auto const &aBucket : g_arrSizeBuckets) {
+		typedef std::pair<CFuncDescArray::size_type, CFuncDescArray::size_type> TFuncPair;
+		std::vector<TFuncPair> arrPairs;
+		auto &&fnInBucket = [&aBucket](const CFuncDesc &aFunc)->bool {
+			return ((aFunc.size() >= aBucket.m_nMinSize) && (aFunc.size() <= aBucket.m_nMaxSize));
+		};
+		for (CFuncDescArray::size_type ndxFile1 = 0; ((ndxFile1 < file1.GetFuncCount()) && (arrPairs.size() < MAX_BUCKET_PAIRS)); ++ndxFile1) {
+			if (!fnInBucket(file1.GetFunc(ndxFile1))) continue;
+			for (CFuncDescArray::size_type ndxFile2 = 0; ((ndxFile2 < file2.GetFuncCount()) && (arrPairs.size() < MAX_BUCKET_PAIRS)); ++ndxFile2) {
+				if (fnInBucket(file2.GetFunc(ndxFile2))) arrPairs.push_back({ ndxFile1, ndxFile2 });
+			}
+		}
+		if (arrPairs.empty()) continue;
+
+		for (int nMethod = 0; nMethod < FCM_COUNT; ++nMethod) {
+			for (int nRep = 0; nRep < nRepetitions; ++nRep) {
+				double nTotal = 0.0;
+				results.add(strPrefix + "/CompareFunctions/" + methodName(static_cast<FUNC_COMPARE_METHOD>(nMethod)) + "/" + aBucket.m_pszName, timeIt([&]()->void {
+					for (auto const &aPair : arrPairs) {
+						nTotal += CompareFunctions(FCT_FUNCTIONS, static_cast<FUNC_COMPARE_METHOD>(nMethod), file1, aPair.first, file2, aPair.second, false).m_nMatchPercent;
+					}
+				}), arrPairs.size());
+				g_nResultSink = nTotal;			// Keep the comparisons from being optimized away
+			}
+		}
+	}
+}
+
+static void benchMatrix(CBenchResults &results, const std::string &strPrefix,
+							const CFuncDescFile &file1, const CFuncDescFile &file2, bool bSelfCompare,
+							unsigned int nMaxThreads, int nRepetitions)
+{
+	// Thread counts of 1, 2, 4, ... up to and including nMaxThreads:
+	std::vector<unsigned int> arrThreadCounts;
+	for (unsigned int nThreads = 1; nThreads < nMaxThreads; nThreads *= 2) arrThreadCounts.push_back(nThreads);
+	arrThreadCounts.push_back(nMaxThreads);
+
+	// Rows in SortedFunctionMap order (largest first) as done by funcanal:
+	std::vector<CFuncDescArray::size_type> arrRowOrder;
+	for (auto const & itrFuncMap : file1.GetSortedFunctionMap()) arrRowOrder.push_back(itrFuncMap.second);
+
+	CCompResultMatrix matrixCompResult;
+	for (int nMethod = 0; nMethod < FCM_COUNT; ++nMethod) {
+		for (auto const &nThreads : arrThreadCounts) {
+			for (int nRep = 0; nRep < nRepetitions; ++nRep) {
+				matrixCompResult.resize(file1.GetFuncCount(), file2.GetFuncCount(), bSelfCompare);
+				results.add(strPrefix + "/Matrix/" + methodName(static_cast<FUNC_COMPARE_METHOD>(nMethod)) + "/threads:" + std::to_string(nThreads), timeIt([&]()->void {
+					runParallelThreads(arrRowOrder.size(), nThreads, [&](std::size_t ndxRow)->void {
+						const CFuncDescArray::size_type ndxFile1 = arrRowOrder[ndxRow];
+						for (CFuncDescArray::size_type ndxFile2 = (bSelfCompare ? ndxFile1 : 0); ndxFile2 < file2.GetFuncCount(); ++ndxFile2) {
+							matrixCompResult.set(ndxFile1, ndxFile2, CompareFunctions(FCT_FUNCTIONS, static_cast<FUNC_COMPARE_METHOD>(nMethod),
+																							file1, ndxFile1, file2, ndxFile2, false).m_nMatchPercent);
+						}
+					});
+				}), (bSelfCompare ? ((file1.GetFuncCount() * (file1.GetFuncCount() + 1)) / 2) : (file1.GetFuncCount() * file2.GetFuncCount())));
+			}
+		}
+	}
+}
+
+// ============================================================================
+
+// Benchmark Data Sets:
+//		Each is a set of files from the test data to stage into the work
+//		directory and the control files to disassemble there.  The functions
+//		files output by the disassembly are then used for the funcanal
+//		benchmarks (compared against each other if there are two of them,
+//		or self-compared if there's only one):
+struct CBenchDataSet {
+	const char *m_pszName;
+	std::string (*m_pfnDisassemble)(CBenchResults &results, const std::string &strPrefix,
+										const std::string &strControlFile, int nRepetitions);
+	std::vector<std::string> m_arrDataFiles;		// Relative to the test data directory
+	std::vector<std::string> m_arrControlFiles;		// Filenames within the staged directory
+};
+
+static const std::vector<CBenchDataSet> g_arrDataSets = {
+	{	"grbl", &benchDisassembly<CAVRDisassembler>,
+		{	"avr/grbl/grbl_v1.1f.20170801/grbl_v1.1f.20170801.hex",
+			"avr/grbl/sainsmart-3018pro/SainSmart3018Pro_m328p_flash_original.hex",
+			"avr/grbl/grbl-v-sainsmart3018/grbl_v1.1f.20170801.ctl",
+			"avr/grbl/grbl-v-sainsmart3018/SainSmart3018Pro_m328p_flash_original.ctl", },
+		{	"grbl_v1.1f.20170801.ctl",
+			"SainSmart3018Pro_m328p_flash_original.ctl", },
+	},
+#ifdef ELF_SUPPORT
+	{	"tcdaq", &benchDisassembly<CAVRDisassembler>,
+		{	"avr/tcdaq/tcdaq-elf/tcdaq.elf",
+			"avr/tcdaq/tcdaq-elf/tcdaq.ctl", },
+		{	"tcdaq.ctl", },
+	},
+#endif
+	{	"buffalo", &benchDisassembly<CM6811Disassembler>,
+		{	"m6811/buffalo/buf34/buf34.s19",
+			"m6811/buffalo/buf34_gup/buf34_gup.s19",
+			"m6811/buffalo/buf34-v-buf34_gup/buf34.ctl",
+			"m6811/buffalo/buf34-v-buf34_gup/buf34_gup.ctl", },
+		{	"buf34.ctl",
+			"buf34_gup.ctl", },
+	},
+};
+
+// ============================================================================
+
+int main(int argc, char *argv[])
+{
+	// Data File Converters:
+	CBinaryDataFileConverter dfcBinary;
+	CDataFileConverters::registerDataFileConverter(&dfcBinary);
+	CIntelDataFileConverter dfcIntel;
+	CDataFileConverters::registerDataFileConverter(&dfcIntel);
+	CSrecDataFileConverter dfcSrec;
+	CDataFileConverters::registerDataFileConverter(&dfcSrec);
+#ifdef ELF_SUPPORT
+	CELFDataFileConverter dfcELF;
+	CDataFileConverters::registerDataFileConverter(&dfcELF);
+#endif
+
+	std::string strDataDir = BENCH_DATA_DIR;
+	std::string strWorkDir = BENCH_WORK_DIR;
+	std::string strOutputFilename;
+	std::string strDataSetFilter;
+	int nRepetitions = 5;
+	unsigned int nMaxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	bool bNeedUsage = false;
+
+	for (int ndx = 1; ((ndx < argc) && !bNeedUsage); ++ndx) {
+		std::string strArg = argv[ndx];
+		std::string strValue;
+		if ((strArg == "-r") || (strArg == "-t") || (strArg == "-o") ||
+			(strArg == "-d") || (strArg == "-w") || (strArg == "-s")) {
+			if ((ndx+1) < argc) {
+				++ndx;
+				strValue = argv[ndx];
+			} else {
+				bNeedUsage = true;
+				continue;
+			}
+		}
+		if (strArg == "-r") {
+			nRepetitions = atoi(strValue.c_str());
+			if (nRepetitions < 1) bNeedUsage = true;
+		} else if (strArg == "-t") {
+			nMaxThreads = atoi(strValue.c_str());
+			if (nMaxThreads < 1) bNeedUsage = true;
+		} else if (strArg == "-o") {
+			strOutputFilename = strValue;
+		} else if (strArg == "-d") {
+			strDataDir = strValue;
+		} else if (strArg == "-w") {
+			strWorkDir = strValue;
+		} else if (strArg == "-s") {
+			strDataSetFilter = strValue;
+		} else {
+			bNeedUsage = true;
+		}
+	}
+
+	if (bNeedUsage) {
+		std::cerr << "Usage:\n"
+					"gendasm_bench [-r <count>] [-t <threads>] [-s <dataset>] [-d <data-dir>] [-w <work-dir>] [-o <json-fn>]\n"
+					"\n"
+					"    -r <count>     Number of repetitions of each benchmark (default 5)\n"
+					"    -t <threads>   Maximum number of threads for matrix generation, which\n"
+					"                   is timed at 1, 2, 4, ... up to this count (default is\n"
+					"                   the number of hardware threads)\n"
+					"    -s <dataset>   Run only the specified dataset\n"
+					"    -d <data-dir>  Test data directory (default " BENCH_DATA_DIR ")\n"
+					"    -w <work-dir>  Directory to stage the data and outputs into\n"
+					"                   (default " BENCH_WORK_DIR ")\n"
+					"    -o <json-fn>   Write the JSON results to this file rather than stdout\n"
+					"\n"
+					"Datasets:";
+		for (auto const &aDataSet : g_arrDataSets) std::cerr << " " << aDataSet.m_pszName;
+		std::cerr << "\n\n";
+		return -1;
+	}
+
+	CBenchResults results;
+	strDataDir = std::filesystem::absolute(strDataDir).string();
+
+	for (auto const &aDataSet : g_arrDataSets) {
+		if (!strDataSetFilter.empty() && (strDataSetFilter != aDataSet.m_pszName)) continue;
+		std::cerr << "Dataset: " << aDataSet.m_pszName << "\n";
+
+		// Stage the data files and run from there, as the control files
+		//	reference their files relative to the current directory:
+		std::error_code ec;
+		std::filesystem::path pathStage = std::filesystem::absolute(strWorkDir) / aDataSet.m_pszName;
+		std::filesystem::create_directories(pathStage, ec);
+		for (auto const &strDataFile : aDataSet.m_arrDataFiles) {
+			std::filesystem::path pathSource = std::filesystem::path(strDataDir) / strDataFile;
+			std::filesystem::copy_file(pathSource, pathStage / pathSource.filename(), std::filesystem::copy_options::overwrite_existing, ec);
+			if (ec) {
+				std::cerr << "*** Error: Staging \"" << pathSource.string() << "\" : " << ec.message() << "\n";
+				return -2;
+			}
+		}
+		std::filesystem::current_path(pathStage);
+
+		std::vector<std::string> arrFunctionsFiles;
+		for (auto const &strControlFile : aDataSet.m_arrControlFiles) {
+			std::string strImage = std::filesystem::path(strControlFile).stem().string();
+			std::string strFunctionsFile = aDataSet.m_pfnDisassemble(results, std::string("gendasm/") + aDataSet.m_pszName + "/" + strImage,
+																		strControlFile, nRepetitions);
+			if (!strFunctionsFile.empty()) arrFunctionsFiles.push_back(strFunctionsFile);
+		}
+
+		std::vector< std::shared_ptr<CFuncDescFile> > arrFuncFiles;
+		for (auto const &strFunctionsFile : arrFunctionsFiles) {
+			std::string strImage = std::filesystem::path(strFunctionsFile).stem().string();
+			std::shared_ptr<CFuncDescFile> pFuncFile = benchReadFuncDescFile(results, std::string("funcanal/") + aDataSet.m_pszName + "/" + strImage,
+																				strFunctionsFile, nRepetitions);
+			if (!pFuncFile) return -3;
+			arrFuncFiles.push_back(pFuncFile);
+		}
+
+		if (!arrFuncFiles.empty()) {
+			const bool bSelfCompare = (arrFuncFiles.size() == 1);
+			const CFuncDescFile &file1 = *arrFuncFiles.at(0);
+			const CFuncDescFile &file2 = *arrFuncFiles.at(bSelfCompare ? 0 : 1);
+			benchCompareFunctions(results, std::string("funcanal/") + aDataSet.m_pszName, file1, file2, nRepetitions);
+			benchMatrix(results, std::string("funcanal/") + aDataSet.m_pszName, file1, file2, bSelfCompare, nMaxThreads, nRepetitions);
+		}
+	}
+
+	if (!strOutputFilename.empty()) {
+		std::fstream fileOutput(strOutputFilename, std::ios_base::out | std::ios_base::trunc);
+		if (!fileOutput.is_open()) {
+			std::cerr << "*** Error: Opening file \"" << strOutputFilename << "\" for writing...\n";
+			return -4;
+		}
+		results.writeJSON(fileOutput, nRepetitions, nMaxThreads);
+	} else {
+		results.writeJSON(std::cout, nRepetitions, nMaxThreads);
+	}
+
+	return 0;
+}
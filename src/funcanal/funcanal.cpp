@@ -11,15 +11,34 @@
 #include <sstream>
 #include <iomanip>
 #include <iterator>
+#include <algorithm>
 #include <filesystem>
 #include <set>
+#include <unordered_map>
 #include <utility>
 #include <thread>
+#include <atomic>
+#include <limits>
 
 #include <stringhelp.h>
+#include <gdc.h>
+#include <dfc.h>
+#include <perfstats.h>
+#include <capturedoutput.h>
+
+#include <dfc/binary/binarydfc.h>
+#include <dfc/intel/inteldfc.h>
+#include <dfc/srec/srecdfc.h>
+#ifdef ELF_SUPPORT
+#include <dfc/elf/elfdfc.h>
+#endif
+
+#include <cpu/m6811/m6811gdc.h>
+#include <cpu/avr/avrgdc.h>
 
 #include "funcanal.h"
 #include "funcdesc.h"
+#include "funcmtx.h"
 
 #include <assert.h>
 
@@ -61,10 +80,13 @@ static unsigned int threadCount()
 	return (nThreads ? nThreads : idealThreadCount());
 }
 
-// ============================================================================
-
-typedef std::vector<double> CCompResultArray;
-typedef std::vector<CCompResultArray> CCompResultMatrix;
+// Runs the work items across the worker threads (or just the calling thread
+//	if bSingleThreaded), see runParallelThreads():
+template<typename TFunction>
+static void runParallel(std::size_t nCount, bool bSingleThreaded, const char *pszStatsName, const TFunction &fnWork)
+{
+	runParallelThreads(nCount, (bSingleThreaded ? 1 : threadCount()), fnWork, pszStatsName);
+}
 
 // ============================================================================
 
@@ -92,11 +114,12 @@ static bool promptFileOverwrite(const std::string &strFilename)
 	return true;
 }
 
-static bool openForWriting(bool bForceOverwrite, std::fstream &file, const TString &strFilename, const TString &strMessage)
+static bool openForWriting(bool bForceOverwrite, std::fstream &file, const TString &strFilename, const TString &strMessage,
+							std::ios_base::openmode nMode = std::ios_base::out)
 {
 	if (!strFilename.empty()) {
 		if (!bForceOverwrite && !promptFileOverwrite(strFilename)) return false;
-		file.open(strFilename, std::ios_base::out);
+		file.open(strFilename, nMode);
 		if (!file.is_open()) {
 			std::cerr << "\n*** Error: Opening " << strMessage << (!strMessage.empty() ? " " : "") << "Output File \"" << strFilename << "\" for writing...\n\n";
 			return false;
@@ -168,58 +191,108 @@ static CStringArray parseCSVLine(const std::string aLine)
 
 // ----------------------------------------------------------------------------
 
-static void dumpComparison(FUNC_COMPARE_TYPE nCompareType,
-							std::fstream &fileComp, std::fstream &fileOES,
+// Compared File Pairs:
+//		With one input file, it's compared against itself, and with two,
+//		they are compared with each other.  With more than two, every
+//		pair of them is compared, each keeping its own best matches:
+struct CComparePair {
+	CComparePair(CFuncDescFileArray::size_type ndxLeftFile, CFuncDescFileArray::size_type ndxRightFile)
+		:	m_ndxLeftFile(ndxLeftFile),
+			m_ndxRightFile(ndxRightFile)
+	{ }
+
+	CFuncDescFileArray::size_type m_ndxLeftFile;
+	CFuncDescFileArray::size_type m_ndxRightFile;
+	CCompBestMatches m_bestFuncMatches;
+	CCompBestMatches m_bestDataMatches;
+};
+typedef std::vector<CComparePair> CComparePairArray;
+
+// Comparison Output Jobs:
+//		Choosing which function pairs get output is cheap, but diffing
+//		them is not.  So the output loops queue each comparison along
+//		with the Compare file text that precedes it.  The jobs are then
+//		run concurrently and their results are written out in the order
+//		queued, giving output identical to running them serially:
+struct CComparisonJob {
+	CComparisonJob(FUNC_COMPARE_TYPE nCompareType, CFuncDescArray::size_type ndxFile1, CFuncDescArray::size_type ndxFile2, double nCompResult, const TString &strCompPrefix)
+		:	m_nCompareType(nCompareType),
+			m_ndxFile1(ndxFile1),
+			m_ndxFile2(ndxFile2),
+			m_nCompResult(nCompResult),
+			m_strCompPrefix(strCompPrefix)
+	{ }
+
+	FUNC_COMPARE_TYPE m_nCompareType;
+	CFuncDescArray::size_type m_ndxFile1;
+	CFuncDescArray::size_type m_ndxFile2;
+	double m_nCompResult;				// Comparison result of the pair
+	TString m_strCompPrefix;			// Compare file text preceding this comparison
+
+	// Results:
+	TString m_strComp;					// Compare file output for this comparison
+	TString m_strOES;					// OES file output for this comparison
+	CSymbolMap m_SymbolMap;				// Symbol mappings found by this comparison
+};
+typedef std::vector<CComparisonJob> CComparisonJobArray;
+
+static void dumpComparison(CComparisonJob &aJob,
+							bool bCompFile, bool bOESFile,
 							bool bCompOESFlag,
-							const CCompResultMatrix &matrixCompResult,
 							FUNC_COMPARE_METHOD nCompMethod,
-							std::shared_ptr<const CFuncDescFile> pFuncFile1, CFuncDescArray::size_type ndxFile1,
-							std::shared_ptr<const CFuncDescFile> pFuncFile2, CFuncDescArray::size_type ndxFile2,
-							OUTPUT_OPTIONS nOutputOptions,
-							CSymbolMap *pSymbolMap)
+							std::shared_ptr<const CFuncDescFile> pFuncFile1,
+							std::shared_ptr<const CFuncDescFile> pFuncFile2,
+							OUTPUT_OPTIONS nOutputOptions)
 {
-	CStringArray oes;
+	const FUNC_COMPARE_TYPE nCompareType = aJob.m_nCompareType;
+	const CFuncDescArray::size_type ndxFile1 = aJob.m_ndxFile1;
+	const CFuncDescArray::size_type ndxFile2 = aJob.m_ndxFile2;
+	std::ostringstream ssComp;
+	std::ostringstream ssOES;
 
 	assert(ndxFile1 < ((nCompareType == FCT_FUNCTIONS) ? pFuncFile1->GetFuncCount() : pFuncFile1->GetDataBlockCount()));
 	const CFuncDesc &function1 = ((nCompareType == FCT_FUNCTIONS) ? pFuncFile1->GetFunc(ndxFile1) : pFuncFile1->GetDataBlock(ndxFile1));
 	assert(ndxFile2 < ((nCompareType == FCT_FUNCTIONS) ? pFuncFile2->GetFuncCount() : pFuncFile2->GetDataBlockCount()));
 	const CFuncDesc &function2 = ((nCompareType == FCT_FUNCTIONS) ? pFuncFile2->GetFunc(ndxFile2) : pFuncFile2->GetDataBlock(ndxFile2));
 
-	if (fileComp.is_open()) {
-		fileComp << "--------------------------------------------------------------------------------\n";
-		fileComp << ((nCompareType == FCT_FUNCTIONS) ? "    Left Function  : " : "    Left Data Block  : ")
+	if (bCompFile) {
+		ssComp << "--------------------------------------------------------------------------------\n";
+		ssComp << ((nCompareType == FCT_FUNCTIONS) ? "    Left Function  : " : "    Left Data Block  : ")
 											<< function1.GetMainName()
 											<< " (" << (ndxFile1+1) << ")\n" <<
 					((nCompareType == FCT_FUNCTIONS) ? "    Right Function : " : "    Right Data Block : ")
 											<< function2.GetMainName()
 											<< " (" << (ndxFile2+1) << ")\n" <<
 					((nCompareType == FCT_FUNCTIONS) ? "    Matches by     : " : "    Matches by       : ")
-											<< matrixCompResult[ndxFile1][ndxFile2]*100 << "%\n";
-		fileComp << "--------------------------------------------------------------------------------\n";
+											<< aJob.m_nCompResult*100 << "%\n";
+		ssComp << "--------------------------------------------------------------------------------\n";
 	}
 
-	double nMatchPercent;
-	TString strDiff = DiffFunctions(nCompareType, nCompMethod, *pFuncFile1, ndxFile1, *pFuncFile2, ndxFile2,
-									nOutputOptions, nMatchPercent, pSymbolMap);
-	if (fileComp.is_open()) {
+	CFuncDiffResult aDiff = DiffFunctions(nCompareType, nCompMethod, *pFuncFile1, ndxFile1, *pFuncFile2, ndxFile2,
+											nOutputOptions, &aJob.m_SymbolMap);
+	const CStringArray &oes = aDiff.m_arrEditScript;
+	if (bCompFile) {
 		if (bCompOESFlag) {
-			if (GetLastEditScript(oes)) {
-				std::copy(oes.cbegin(), oes.cend(), std::ostream_iterator<TString>(fileComp, "\n"));
+			if (aDiff.m_bEditScriptValid) {
+				std::copy(oes.cbegin(), oes.cend(), std::ostream_iterator<TString>(ssComp, "\n"));
 			}
-			fileComp << "--------------------------------------------------------------------------------\n";
+			ssComp << "--------------------------------------------------------------------------------\n";
 		}
-		fileComp << strDiff;
-		fileComp << "--------------------------------------------------------------------------------\n";
+		ssComp << aDiff.m_strDiff;
+		ssComp << "--------------------------------------------------------------------------------\n";
 	}
 
-	if (fileOES.is_open() && (nCompareType == FCT_FUNCTIONS)) {
-		if (GetLastEditScript(oes)) {
-			fileOES << "\n";
-			fileOES << "@" << function1.GetMainName() << "(" << (ndxFile1+1)
+	if (bOESFile && (nCompareType == FCT_FUNCTIONS)) {
+		if (aDiff.m_bEditScriptValid) {
+			ssOES << "\n";
+			ssOES << "@" << function1.GetMainName() << "(" << (ndxFile1+1)
 					<< ")|" << function2.GetMainName() << "(" << (ndxFile2+1) << ")\n";
-			std::copy(oes.cbegin(), oes.cend(), std::ostream_iterator<TString>(fileOES, "\n"));
+			std::copy(oes.cbegin(), oes.cend(), std::ostream_iterator<TString>(ssOES, "\n"));
 		}
 	}
+
+	aJob.m_strComp = ssComp.str();
+	aJob.m_strOES = ssOES.str();
 }
 
 // ----------------------------------------------------------------------------
@@ -272,16 +345,126 @@ static void dumpSymbols(std::fstream &fileSym,
 
 // ----------------------------------------------------------------------------
 
+// Function Lineage:
+//		Traces the functions through the revisions, in the order the files
+//		were given, by linking each function to its best match in the next
+//		revision when that function's best match is also it.  A function
+//		not linked from the previous revision starts a new lineage, so each
+//		function is in exactly one lineage:
+static void dumpLineage(std::fstream &fileLineage,
+						const CFuncDescFileArray &arrFuncFiles,
+						const CComparePairArray &arrComparePairs)
+{
+	static constexpr CFuncDescArray::size_type NO_LINK = static_cast<CFuncDescArray::size_type>(-1);
+	struct TLink {
+		CFuncDescArray::size_type m_ndxNext = NO_LINK;		// Function in the next revision
+		double m_nResult = 0.0;
+	};
+	std::vector< std::vector<TLink> > arrLinks(arrFuncFiles.size());		// Link of each function of each revision
+	std::vector< std::vector<bool> > arrLinked(arrFuncFiles.size());		// Functions linked from the previous revision
+
+	for (CFuncDescFileArray::size_type ndxRev = 0; ndxRev < arrFuncFiles.size(); ++ndxRev) {
+		arrLinks[ndxRev].resize(arrFuncFiles.at(ndxRev)->GetFuncCount());
+		arrLinked[ndxRev].resize(arrFuncFiles.at(ndxRev)->GetFuncCount(), false);
+	}
+
+	for (CFuncDescFileArray::size_type ndxRev = 0; (ndxRev+1) < arrFuncFiles.size(); ++ndxRev) {
+		auto const itrPair = std::find_if(arrComparePairs.cbegin(), arrComparePairs.cend(), [ndxRev](const CComparePair &aPair)->bool {
+			return ((aPair.m_ndxLeftFile == ndxRev) && (aPair.m_ndxRightFile == (ndxRev+1)));
+		});
+		assert(itrPair != arrComparePairs.cend());
+		const CCompBestMatches &bestMatches = itrPair->m_bestFuncMatches;
+		for (CFuncDescArray::size_type ndxFunc = 0; ndxFunc < arrLinks[ndxRev].size(); ++ndxFunc) {
+			auto const arrBestMatches = bestMatches.bestOfRow(ndxFunc);
+			if (arrBestMatches.empty()) continue;
+			const CFuncDescArray::size_type ndxNext = arrBestMatches.front().m_nIndex;
+			auto const arrBestOfNext = bestMatches.bestOfCol(ndxNext);
+			if (arrBestOfNext.empty() || (arrBestOfNext.front().m_nIndex != ndxFunc)) continue;
+			arrLinks[ndxRev][ndxFunc] = { ndxNext, arrBestMatches.front().m_nResult };
+			arrLinked[ndxRev+1][ndxNext] = true;
+		}
+	}
+
+	// Each lineage is a line with a column for each revision, giving the
+	//	function in it and its match to the one in the previous revision:
+	const TString::size_type nColWidth = CFuncObject::GetFieldWidth(CFuncObject::FIELD_CODE::FC_LABEL) + 12;
+	fileLineage << "Function Lineage:\n";
+	for (CFuncDescFileArray::size_type ndxRev = 0; ndxRev < arrFuncFiles.size(); ++ndxRev) {
+		fileLineage << "    Revision " << (ndxRev+1) << " : " << arrFuncFiles.at(ndxRev)->GetFuncPathName() << "\n";
+	}
+	fileLineage << "\n";
+
+	TString strLine;
+	for (CFuncDescFileArray::size_type ndxRev = 0; ndxRev < arrFuncFiles.size(); ++ndxRev) {
+		strLine += padString("Revision " + std::to_string(ndxRev+1), nColWidth) + " ";
+	}
+	fileLineage << rtrim(strLine) << "\n";
+	fileLineage << std::string(strLine.size(), '-') << "\n";
+
+	for (CFuncDescFileArray::size_type ndxStartRev = 0; ndxStartRev < arrFuncFiles.size(); ++ndxStartRev) {
+		for (CFuncDescArray::size_type ndxStartFunc = 0; ndxStartFunc < arrLinks[ndxStartRev].size(); ++ndxStartFunc) {
+			if (arrLinked[ndxStartRev][ndxStartFunc]) continue;		// Continues an earlier lineage
+
+			std::ostringstream ssLine;
+			CFuncDescFileArray::size_type ndxRev = 0;
+			for ( ; ndxRev < ndxStartRev; ++ndxRev) ssLine << padString("-", nColWidth) << " ";
+			CFuncDescArray::size_type ndxFunc = ndxStartFunc;
+			double nResult = 0.0;
+			while (true) {
+				std::ostringstream ssCell;
+				ssCell << arrFuncFiles.at(ndxRev)->GetFunc(ndxFunc).GetMainName();
+				if (ndxRev != ndxStartRev) ssCell << " (" << nResult*100 << "%)";
+				ssLine << padString(ssCell.str(), nColWidth) << " ";
+
+				const TLink &aLink = arrLinks[ndxRev][ndxFunc];
+				if (aLink.m_ndxNext == NO_LINK) break;
+				ndxFunc = aLink.m_ndxNext;
+				nResult = aLink.m_nResult;
+				++ndxRev;
+			}
+			for (++ndxRev; ndxRev < arrFuncFiles.size(); ++ndxRev) ssLine << padString("-", nColWidth) << " ";
+
+			strLine = ssLine.str();
+			fileLineage << rtrim(strLine) << "\n";
+		}
+	}
+}
+
 int main(int argc, char* argv[])
 {
+	// Data File Converters and Disassemblers, for disassembling
+	//	control files directly with -g:
+	CBinaryDataFileConverter dfcBinary;
+	CDataFileConverters::registerDataFileConverter(&dfcBinary);
+	CIntelDataFileConverter dfcIntel;
+	CDataFileConverters::registerDataFileConverter(&dfcIntel);
+	CSrecDataFileConverter dfcSrec;
+	CDataFileConverters::registerDataFileConverter(&dfcSrec);
+#ifdef ELF_SUPPORT
+	CELFDataFileConverter dfcELF;
+	CDataFileConverters::registerDataFileConverter(&dfcELF);
+#endif
+
+	CDisassemblers disassemblers;
+	CM6811Disassembler m6811dis;
+	disassemblers.registerDisassembler(&m6811dis);
+	CAVRDisassembler avrdis;
+	disassemblers.registerDisassembler(&avrdis);
+
+	CDisassembler *pDisassembler = nullptr;		// Set with -g to read control files rather than function definition files
+
 	TString m_strMatrixInFilename;
 	TString m_strMatrixOutFilename;
+	TString m_strMatrixBinOutFilename;
+	TString m_strMatrixMergeFilename;
 	TString m_strDFROFilename;
 	TString m_strCompFilename;
 	TString m_strOESFilename;
 	TString m_strSymFilename;
+	TString m_strLineageFilename;
 	CStringArray m_arrInputFilenames;
 	bool m_bForceOverwrite = false;
+	bool m_bWriteBinaryFuncFiles = false;
 	bool m_bOutputOptionAddAddress = false;
 
 	bool bNeedUsage = false;
@@ -292,7 +475,15 @@ int main(int argc, char* argv[])
 	bool bDFROWithCodeFlag = false;
 	bool bCompOESFlag = false;
 	bool bDeterministic = false;
+	bool bStats = false;
+	TString strStatsFilename;					// JSON statistics output, if any (see --stats)
 	bool bSingleThreaded = false;
+	bool bPreFilter = false;
+	bool bBestOnly = false;						// Compare only as far as needed to find the best matches (see -bo)
+	CCompBestMatches::size_type nTopK = 0;		// Keep only the top-K results of each row and column rather than the whole matrix (0 if not)
+	bool bMatrixShard = false;					// Compute only some of the rows of the function matrix (see -ms)
+	CCompResultMatrix::size_type nMatrixFirstRow = 0;
+	CCompResultMatrix::size_type nMatrixEndRow = std::numeric_limits<CCompResultMatrix::size_type>::max();
 
 	// Parse Arguments:
 	for (int ndx = 1; ((ndx < argc) && !bNeedUsage); ++ndx) {
@@ -303,8 +494,18 @@ int main(int argc, char* argv[])
 			m_arrInputFilenames.push_back(strArg);
 		} else if (strArg == "-st") {
 			bSingleThreaded = true;
+		} else if (strArg == "-pf") {
+			bPreFilter = true;
+		} else if (strArg == "-bo") {
+			bBestOnly = true;
 		} else if (strArg == "--deterministic") {
 			bDeterministic = true;
+		} else if (strArg == "--stats") {
+			bStats = true;
+		} else if (strArg.starts_with("--stats=")) {
+			bStats = true;
+			strStatsFilename = strArg.substr(8);
+			if (strStatsFilename.empty()) bNeedUsage = true;
 		} else if (strArg.starts_with("-mi")) {			// Matrix Input File
 			if (!m_strMatrixInFilename.empty()) {
 				bNeedUsage = true;
@@ -318,6 +519,58 @@ int main(int argc, char* argv[])
 				bNeedUsage = true;
 				continue;
 			}
+		} else if (strArg.starts_with("-mb")) {			// Binary Matrix Output File
+			if (!m_strMatrixBinOutFilename.empty()) {
+				bNeedUsage = true;
+				continue;
+			} else if (strArg.size() > 3) {
+				m_strMatrixBinOutFilename = strArg.substr(3);
+			} else if ((ndx+1) < argc) {
+				++ndx;
+				m_strMatrixBinOutFilename = argv[ndx];
+			} else {
+				bNeedUsage = true;
+				continue;
+			}
+		} else if (strArg.starts_with("-mm")) {			// Merged Matrix Output File
+			if (!m_strMatrixMergeFilename.empty()) {
+				bNeedUsage = true;
+				continue;
+			} else if (strArg.size() > 3) {
+				m_strMatrixMergeFilename = strArg.substr(3);
+			} else if ((ndx+1) < argc) {
+				++ndx;
+				m_strMatrixMergeFilename = argv[ndx];
+			} else {
+				bNeedUsage = true;
+				continue;
+			}
+		} else if (strArg.starts_with("-ms")) {			// Matrix Shard Rows
+			TString strRows;
+			if (bMatrixShard) {
+				bNeedUsage = true;
+				continue;
+			} else if (strArg.size() > 3) {
+				strRows = strArg.substr(3);
+			} else if ((ndx+1) < argc) {
+				++ndx;
+				strRows = argv[ndx];
+			} else {
+				bNeedUsage = true;
+				continue;
+			}
+			const TString::size_type nColon = strRows.find(':');
+			if (nColon == TString::npos) {
+				bNeedUsage = true;
+				continue;
+			}
+			nMatrixFirstRow = strtoull(strRows.substr(0, nColon).c_str(), nullptr, 10);
+			nMatrixEndRow = strtoull(strRows.substr(nColon+1).c_str(), nullptr, 10);
+			if (nMatrixFirstRow >= nMatrixEndRow) {
+				bNeedUsage = true;
+				continue;
+			}
+			bMatrixShard = true;
 		} else if (strArg.starts_with("-mo")) {			// Matrix Output File
 			if (!m_strMatrixOutFilename.empty()) {
 				bNeedUsage = true;
@@ -331,7 +584,6 @@ int main(int argc, char* argv[])
 				bNeedUsage = true;
 				continue;
 			}
-			nMinReqInputFiles = 2;		// Must have 2 input files
 		} else if (strArg.starts_with("-do") ||			// Normal DFRO
 				   strArg.starts_with("-dc")) {			// DFRO with Assembly Code
 			if (!m_strDFROFilename.empty()) {
@@ -394,7 +646,6 @@ int main(int argc, char* argv[])
 				bNeedUsage = true;
 				continue;
 			}
-			nMinReqInputFiles = 2;		// Must have 2 input files
 		} else if (strArg.starts_with("-s")) {
 			if (!m_strSymFilename.empty()) {
 				bNeedUsage = true;
@@ -408,9 +659,40 @@ int main(int argc, char* argv[])
 				bNeedUsage = true;
 				continue;
 			}
-			nMinReqInputFiles = 2;		// Must have 2 input files
+		} else if (strArg.starts_with("-n")) {			// Function Lineage Output File
+			if (!m_strLineageFilename.empty()) {
+				bNeedUsage = true;
+				continue;
+			} else if (strArg.size() > 2) {
+				m_strLineageFilename = strArg.substr(2);
+			} else if ((ndx+1) < argc) {
+				++ndx;
+				m_strLineageFilename = argv[ndx];
+			} else {
+				bNeedUsage = true;
+				continue;
+			}
+		} else if (strArg.starts_with("-g")) {			// Disassembler for Control Files
+			if (pDisassembler) {
+				bNeedUsage = true;
+				continue;
+			} else if (strArg.size() > 2) {
+				pDisassembler = disassemblers.locateDisassembler(strArg.substr(2));
+			} else if ((ndx+1) < argc) {
+				++ndx;
+				pDisassembler = disassemblers.locateDisassembler(argv[ndx]);
+			} else {
+				bNeedUsage = true;
+				continue;
+			}
+			if (pDisassembler == nullptr) {
+				bNeedUsage = true;
+				continue;
+			}
 		} else if (strArg == "-f") {
 			m_bForceOverwrite = true;
+		} else if (strArg == "-fb") {
+			m_bWriteBinaryFuncFiles = true;
 		} else if (strArg == "-ooa") {
 			m_bOutputOptionAddAddress = true;
 		} else if (strArg.starts_with("-l")) {
@@ -423,6 +705,20 @@ int main(int argc, char* argv[])
 				bNeedUsage = true;
 				continue;
 			}
+		} else if (strArg.starts_with("-k")) {
+			if (strArg.size() > 2) {
+				nTopK = strtoul(&strArg.c_str()[2], nullptr, 10);
+			} else if ((ndx+1) < argc) {
+				++ndx;
+				nTopK = strtoul(argv[ndx], nullptr, 10);
+			} else {
+				bNeedUsage = true;
+				continue;
+			}
+			if (nTopK == 0) {
+				bNeedUsage = true;
+				continue;
+			}
 		} else if (strArg.starts_with("-a")) {
 			if (strArg.size() > 2) {
 				nCompMethod = static_cast<FUNC_COMPARE_METHOD>(strtoul(&strArg.c_str()[2], nullptr, 10));
@@ -447,11 +743,51 @@ int main(int argc, char* argv[])
 	if (!m_strMatrixInFilename.empty() &&
 		!m_strMatrixOutFilename.empty()) bNeedUsage = true;		// Can only have matrix in or matrix out (not both)
 
+	if (bBestOnly && (nTopK == 0)) nTopK = 1;		// Best-Only only keeps the best matches, same as -k
+
+	if ((nTopK != 0) &&
+		(!m_strMatrixOutFilename.empty() ||
+		 !m_strMatrixBinOutFilename.empty())) bNeedUsage = true;	// Top-K results don't have a whole matrix to output
+
+	if ((m_arrInputFilenames.size() > 2) &&
+		(!m_strMatrixInFilename.empty() ||
+		 !m_strMatrixOutFilename.empty() ||
+		 !m_strMatrixBinOutFilename.empty())) bNeedUsage = true;	// Matrix files are only for comparing a single pair of files
+
+	if (!m_strLineageFilename.empty() &&
+		(m_arrInputFilenames.size() < 2)) bNeedUsage = true;		// Lineage needs at least two revisions
+
+	if (bMatrixShard &&
+		(m_strMatrixBinOutFilename.empty() ||
+		 !m_strMatrixOutFilename.empty() ||
+		 !m_strCompFilename.empty() ||
+		 !m_strOESFilename.empty() ||
+		 !m_strSymFilename.empty() ||
+		 !m_strLineageFilename.empty() ||
+		 (m_arrInputFilenames.size() > 2))) bNeedUsage = true;		// A shard is only output as a partial binary matrix
+
+	if (!m_strMatrixMergeFilename.empty() &&
+		(bMatrixShard ||
+		 (pDisassembler != nullptr) ||
+		 m_bWriteBinaryFuncFiles ||
+		 !m_strMatrixInFilename.empty() ||
+		 !m_strMatrixOutFilename.empty() ||
+		 !m_strMatrixBinOutFilename.empty() ||
+		 !m_strDFROFilename.empty() ||
+		 !m_strCompFilename.empty() ||
+		 !m_strOESFilename.empty() ||
+		 !m_strSymFilename.empty() ||
+		 !m_strLineageFilename.empty())) bNeedUsage = true;		// Merging only reads partial matrix files
+
 	if (m_strMatrixOutFilename.empty() &&
+		m_strMatrixBinOutFilename.empty() &&
+		m_strMatrixMergeFilename.empty() &&
 		m_strDFROFilename.empty() &&
 		m_strCompFilename.empty() &&
 		m_strOESFilename.empty() &&
-		m_strSymFilename.empty()) {
+		m_strSymFilename.empty() &&
+		m_strLineageFilename.empty() &&
+		!m_bWriteBinaryFuncFiles) {
 		std::cerr << std::endl << std::endl << "Nothing to do..." << std::endl << std::endl;
 		bNeedUsage = true;
 	}
@@ -459,12 +795,13 @@ int main(int argc, char* argv[])
 	std::fstream fileFunc;
 	std::fstream fileMatrixIn;
 	std::fstream fileMatrixOut;
+	std::fstream fileMatrixBinOut;
 	std::fstream fileDFRO;
 	std::fstream fileComp;
 	std::fstream fileOES;
 	std::fstream fileSym;
+	std::fstream fileLineage;
 
-	CSymbolMap aSymbolMap;
 	CFuncDescFileArray m_arrFuncFiles;
 	CCompResultMatrix m_matrixFuncCompResult;
 	CCompResultMatrix m_matrixDataCompResult;
@@ -482,27 +819,60 @@ int main(int argc, char* argv[])
 
 	if (bNeedUsage) {
 		std::cerr <<"Usage:\n"
-					"funcanal [--deterministic] [-st] [-ooa] [-a <alg>] [-f] [-e <oes-fn>] [-s <sym-fn>] [-mi <mtx-fn> | -mo <mtx-fn>] [[-do <dro-fn> | -dc <dro-fn>] -dl <fdl>] [-cn <cmp-fn> | -ce <cmp-fn>] [-l <limit>] <func-fn1> [<func-fn2>]\n"
+					"funcanal [--deterministic] [--stats[=<json-fn>]] [-st] [-ooa] [-a <alg>] [-g <gdc>] [-f] [-fb] [-e <oes-fn>] [-s <sym-fn>] [-mi <mtx-fn> | -mo <mtx-fn>] [-mb <mtx-fn>] [[-do <dro-fn> | -dc <dro-fn>] -dl <fdl>] [-cn <cmp-fn> | -ce <cmp-fn>] [-l <limit> [-pf]] [-k <count>] [-bo] [-n <lin-fn>] [-ms <rows>] <func-fn1> [<func-fn2> [<func-fn3> ...]]\n"
+					"funcanal [-f] [--stats[=<json-fn>]] -mm <mtx-fn> <part-fn1> [<part-fn2> ...]\n"
 					"\n"
 					"Where:\n\n"
 					"    <oes-fn>   = Output Optimal Edit Script Filename to generate\n\n"
-					"    <mtx-fn>   = Input or Output Filename of a CSV file to read or to generate\n"
-					"                 that denotes percentage of function cross-similarity.\n\n"
+					"    <mtx-fn>   = Input or Output Filename of a CSV or binary matrix file to\n"
+					"                 read or to generate that denotes percentage of function\n"
+					"                 cross-similarity.\n\n"
 					"    <dro-fn>   = Output Filename of a file to generate that contains the\n"
 					"                 diff-ready version all of the functions from the input file(s)\n\n"
 					"    <cmp-fn>   = Output Filename of a file to generate that contains the full\n"
 					"                 cross-functional comparisons.\n\n"
-					"    <func-fn1> = Input Filename of the primary functions-definition-file.\n\n"
-					"    <func-fn2> = Input Filename of the secondary functions-definition-file.\n"
-					"                 (Optional only if not using -mo, -cX, -e, or -s)\n\n"
+					"    <part-fn1> = Input Filenames of partial binary matrix files to merge\n"
+					"                 (see -ms).\n\n"
+					"    <lin-fn>   = Output Filename of a file to generate that contains the\n"
+					"                 lineage of the functions across the input files.\n\n"
+					"    <func-fn1> = Input Filename of the primary functions-definition-file,\n"
+					"                 either text or binary (see -fb).\n"
+					"                 (Or gendasm control file, if using -g)\n\n"
+					"    <func-fn2> = Input Filename of the secondary functions-definition-file,\n"
+					"                 either text or binary (see -fb).\n"
+					"                 (Or gendasm control file, if using -g)\n"
+					"                 (Optional.  If not specified with -mo, -cX, -e, or -s,\n"
+					"                 then <func-fn1> is compared against itself, computing\n"
+					"                 only half of the symmetric matrix, and functions aren't\n"
+					"                 reported as matching themselves)\n\n"
+					"    <func-fn3> = Input Filenames of any additional functions-definition-files,\n"
+					"                 either text or binary (see -fb).\n"
+					"                 (Or gendasm control files, if using -g)\n"
+					"                 (Optional.  If specified, every pair of the input files\n"
+					"                 is compared, and the -cX, -e, and -s output files have\n"
+					"                 the comparison of each pair, one after the other.  The\n"
+					"                 -mi, -mo, and -mb switches can't be used, and only the\n"
+					"                 best matches are kept, as with -k)\n\n"
 					"    <alg>      = Comparison algorithm to use (see below).\n\n"
+					"    <gdc>      = Disassembler to use for control files (see below).\n\n"
 					"    <fdl>      = Function Diff Level (for diff-ready-output, see below).\n\n"
 					"    <limit>    = Lower-Match Limit Percentage.\n\n"
+					"    <count>    = Number of top matches to keep for each function.\n\n"
+					"    <rows>     = Range of rows of the function matrix, as <first>:<end>, where\n"
+					"                 rows are numbered from 0 and <end> is one past the last.\n\n"
 					"\n"
 					"At least one of the following switches must be used:\n"
 					"    -mo <mtx-fn> Perform cross comparison of files and output a matrix of\n"
-					"                 percent match (requires 2 input files). Cannot be used\n"
-					"                 with the -mi switch.\n\n"
+					"                 percent match.  Cannot be used with the -mi switch.\n\n"
+					"    -mb <mtx-fn> Perform cross comparison of files and output a binary matrix\n"
+					"                 of percent match, which is much faster to read back with\n"
+					"                 -mi than the CSV matrix of -mo.  It can be used together\n"
+					"                 with -mo, or with -mi (even on the same file) to update a\n"
+					"                 matrix after some of the functions have changed.\n\n"
+					"    -mm <mtx-fn> Merge the partial binary matrix files given, from -ms runs\n"
+					"                 that together have every row of one matrix, into a whole\n"
+					"                 binary matrix file that can be read with -mi.  No function\n"
+					"                 files are read, and no other output switches can be used.\n\n"
 					"    -do <dro-fn> Dump the functions definition file(s) in Diff-Ready notation\n\n"
 					"    -dc <dro-fn> Dump the functions definition file(s) in Diff-Ready notation\n"
 					"                 with assembly code output side-by-side\n\n"
@@ -515,14 +885,48 @@ int main(int argc, char* argv[])
 					"                 left-most file to get the right-most file\n\n"
 					"    -s <sym-fn>  Perform cross comparison of files and output a cross-map\n"
 					"                 probability based symbol table\n\n"
+					"    -n <lin-fn>  Perform cross comparison of files and output the lineage of\n"
+					"                 each function across them, taking the input files as\n"
+					"                 successive revisions in the order given.  A function is\n"
+					"                 followed into the next revision when it and a function\n"
+					"                 there are each other's best match, otherwise it starts\n"
+					"                 or ends a lineage.  Requires at least two input files.\n\n"
 					"\n"
 					"The following switches can be specified but are optional:\n"
 					"    --deterministic  Skip output like dates and version numbers so that the\n"
 					"                     output can be compared with other content for tests.\n\n"
+					"    --stats[=<json-fn>]\n"
+					"                 Output performance statistics, which are the time of\n"
+					"                 each phase, the counts of comparisons and allocations,\n"
+					"                 and the utilization of each worker thread, to stderr\n"
+					"                 when complete, and also as JSON to <json-fn> if given.\n\n"
 					"    -mi <mtx-fn> Reads the specified matrix file to get function cross\n"
 					"                 comparison information rather than recalculating it.\n"
+					"                 The file can be either a CSV matrix from -mo or a binary\n"
+					"                 matrix from -mb, which is detected automatically.  With\n"
+					"                 a binary matrix, if only some of the functions have\n"
+					"                 changed, results for the unchanged ones are reused and\n"
+					"                 only the rest are recomputed.\n"
 					"                 Cannot be used with the -mo switch.\n\n"
+					"    -g <gdc>     Input files are gendasm control files rather than functions-\n"
+					"                 definition-files.  Each is disassembled independently with\n"
+					"                 the specified disassembler, as gendasm would, and its\n"
+					"                 functions are analyzed directly, without writing and then\n"
+					"                 reading back a functions-definition-file.  The functions\n"
+					"                 are identified by the functions output file named in the\n"
+					"                 control file, but that file isn't written.  Where <gdc>\n"
+					"                 is one of the following:\n";
+		for (auto const & itrDisassemblers : disassemblers) {
+			std::cerr << "                       " << itrDisassemblers->GetGDCShortName() << " = " << itrDisassemblers->GetGDCLongName() << "\n";
+		}
+		std::cerr << "\n"
 					"    -f           Force output file overwrite without prompting\n\n"
+					"    -fb          Write a binary functions-definition-file for each text\n"
+					"                 functions-definition-file read (or control file, with -g),\n"
+					"                 named the same but with a .fnb extension.  Binary files\n"
+					"                 are detected automatically when used as input and load\n"
+					"                 much faster, since they hold everything already parsed\n"
+					"                 and tokenized for comparison.\n\n"
 					"    -l <limit>   Minimum-Match Limit.  This option is only useful with the -cX,\n"
 					"                 -e, and -s options and limits output to functions having a\n"
 					"                 match percentage greater than or equal to this value.  If not\n"
@@ -530,19 +934,72 @@ int main(int argc, char* argv[])
 					"                 0%. This value should be specified as a percentage or\n"
 					"                 fraction of a percent.  For example: -l 50 matches anything\n"
 					"                 50% or higher.  -l 23.7 matches anything 23.7% or higher.\n\n"
+					"    -pf          Pre-Filter comparisons with the -l limit.  Function pairs\n"
+					"                 whose cheaply computed upper-bound of match percentage is\n"
+					"                 below the -l limit are skipped and recorded as 0% rather\n"
+					"                 than running the full comparison.  This doesn't change\n"
+					"                 which functions are reported as matching, but pairs below\n"
+					"                 the limit will show as 0% in any -mo matrix output.\n\n"
+					"    -k <count>   Keep only the top <count> match percentages of each function\n"
+					"                 that meet the -l limit (and any tied with the last of\n"
+					"                 them), rather than the whole cross-comparison matrix.\n"
+					"                 Memory then grows with the number of functions rather\n"
+					"                 than their square, allowing very large files to be\n"
+					"                 compared.  Since only the best matches are reported, this\n"
+					"                 doesn't change the output, even with a <count> of 1.\n"
+					"                 Cannot be used with the -mo or -mb switches.\n\n"
+					"    -bo          Best-Only comparisons.  Each function's candidates are\n"
+					"                 compared in order of their upper-bound match percentage\n"
+					"                 (as with -pf), and each comparison stops as soon as it\n"
+					"                 can't reach the best matches found so far.  Like -k,\n"
+					"                 this doesn't change the output, and keeps the top 1 (or\n"
+					"                 -k <count>) matches.  Cannot be used with the -mo or -mb\n"
+					"                 switches.\n\n"
+					"    -ms <rows>   Compute only the given rows of the function matrix (the\n"
+					"                 functions of <func-fn1>, in the order of that file) and\n"
+					"                 output them with -mb as a partial binary matrix file,\n"
+					"                 which holds the hashes of all of the functions compared.\n"
+					"                 Rows past the last function are ignored.  The partial\n"
+					"                 files of all of the rows are merged with -mm, allowing the\n"
+					"                 comparisons to be split across separate runs.  Requires\n"
+					"                 -mb, and cannot be used with the -mo, -cX, -e, -s, or -n\n"
+					"                 switches, or with more than two function files.\n\n"
 					"    -a <alg>     Select a specific comparison algorithm to use.  Where <alg> is\n"
 					"                 one of the following:\n"
 					"                       0 = Dynamic Programming X-Drop Algorithm\n"
 					"                       1 = Dynamic Programming Greedy Algorithm\n"
+					"                       2 = Dynamic Programming X-Drop Algorithm, using a\n"
+					"                           vectorized integer kernel that gives identical\n"
+					"                           results to 0, but is faster\n"
 					"                 If not specified, the X-Drop algorithm will be used.\n\n"
 					"    -dl <fdl>    Function Diff Level when generating DRO.\n"
 					"                 <fdl> Levels 1-" << NUM_FUNC_DIFF_LEVELS << "\n\n"
 					"    -ooa         Output-Option Add Address to diff create line output.\n\n"
-					"    -st          Run Single Threaded when computing comparison matrix.\n\n"
+					"    -st          Run Single Threaded when computing comparison matrices and\n"
+					"                 function diffs.\n\n"
 					"\n";
 		return -1;
 	}
 
+	if (bStats) CPerfStats::enable();
+	CPerfStats::CReport statsReport("funcanal", strStatsFilename);
+
+	// Merge partial matrix files, which are all that's read:
+	if (!m_strMatrixMergeFilename.empty()) {
+		std::fstream fileMatrixMerge;
+		if (!openForWriting(m_bForceOverwrite, fileMatrixMerge, m_strMatrixMergeFilename, "Merged Matrix", std::ios_base::out | std::ios_base::binary)) return -2;
+		std::cout << "Merging Partial Matrix Files...\n";
+		CPerfStats::CPhase phase("MergeMatrix");
+		TString strError;
+		if (!CCompResultMatrix::mergeBinary(m_arrInputFilenames, fileMatrixMerge, strError)) {
+			std::cerr << "*** Error: Merging Partial Matrix Files : " << strError << "\n";
+			return -4;
+		}
+		fileMatrixMerge.close();
+		printf("\nFunction Analysis Complete...\n\n");
+		return 0;
+	}
+
 	switch (nCompMethod) {
 		case FCM_DYNPROG_XDROP:
 			std::cout << "Using Comparison Algorithm: DynProg X-Drop\n\n";
@@ -550,29 +1007,104 @@ int main(int argc, char* argv[])
 		case FCM_DYNPROG_GREEDY:
 			std::cout << "Using Comparison Algorithm: DynProg Greedy\n\n";
 			break;
+		case FCM_DYNPROG_XDROP_VECTOR:
+			std::cout << "Using Comparison Algorithm: DynProg X-Drop (Vectorized)\n\n";
+			break;
 		default:
 			break;
 	}
 
 	// Open output files:
+	//	The binary matrix is written to a temporary file that replaces the
+	//	output file when complete, so that it can also be the file being
+	//	read with -mi:
+	const TString strMatrixBinTempFilename = (!m_strMatrixBinOutFilename.empty() ? (m_strMatrixBinOutFilename + ".tmp") : TString());
+	if (!m_strMatrixBinOutFilename.empty() && !m_bForceOverwrite && !promptFileOverwrite(m_strMatrixBinOutFilename)) return -2;
 	if (!openForWriting(m_bForceOverwrite, fileMatrixOut, m_strMatrixOutFilename, "Matrix") ||
+		!openForWriting(true, fileMatrixBinOut, strMatrixBinTempFilename, "Binary Matrix", std::ios_base::out | std::ios_base::binary) ||
 		!openForWriting(m_bForceOverwrite, fileDFRO, m_strDFROFilename, "Diff-Ready") ||
 		!openForWriting(m_bForceOverwrite, fileComp, m_strCompFilename, "Compare") ||
 		!openForWriting(m_bForceOverwrite, fileOES, m_strOESFilename, "Optimal Edit Script") ||
-		!openForWriting(m_bForceOverwrite, fileSym, m_strSymFilename, "Symbol Table")) return -2;
-
-	// Read function files:
-	for (auto const & strFilename : m_arrInputFilenames) {
-		std::shared_ptr<CFuncDescFile> pFuncDescFile = std::make_shared<CFuncDescFile>();
-		ifstreamFuncDescFile fileFunc(strFilename);
-		if (!fileFunc.is_open()) {
-			std::cerr << "*** Error: Opening Function Definition File \"" << strFilename << "\" for reading...\n";
-			return -3;
+		!openForWriting(m_bForceOverwrite, fileSym, m_strSymFilename, "Symbol Table") ||
+		!openForWriting(m_bForceOverwrite, fileLineage, m_strLineageFilename, "Function Lineage")) return -2;
+
+	// Read function files (or disassemble control files).  Each file is
+	//	independent, so they are all read at once, splitting the threads
+	//	between them, with each one's output captured and written in the
+	//	loop after, followed by everything written from that file.  That
+	//	keeps the output, and the order of m_arrFuncFiles, the same as
+	//	reading them one after the other:
+	struct TInputFile {
+		std::shared_ptr<CFuncDescFile> m_pFuncDescFile = std::make_shared<CFuncDescFile>();
+		bool m_bBinaryInput = false;
+		bool m_bReadError = false;		// Couldn't be opened or disassembled, which stops everything
+		CCapturedOutput m_output;
+	};
+	std::vector< std::unique_ptr<TInputFile> > arrInputFiles;
+	for (CStringArray::size_type ndx = 0; ndx < m_arrInputFilenames.size(); ++ndx) {
+		arrInputFiles.push_back(std::make_unique<TInputFile>());
+	}
+	const unsigned int nThreads = (bSingleThreaded ? 1 : threadCount());
+	const unsigned int nFileThreads = std::max<std::size_t>(std::min<std::size_t>(nThreads, m_arrInputFilenames.size()), 1);
+	runParallelThreads(m_arrInputFilenames.size(), nFileThreads, [&](std::size_t ndx)->void {
+		const TString &strFilename = m_arrInputFilenames.at(ndx);
+		TInputFile &anInput = *arrInputFiles.at(ndx);
+		std::shared_ptr<CFuncDescFile> &pFuncDescFile = anInput.m_pFuncDescFile;
+		std::ostream &msgFile = anInput.m_output.msgFile();
+		std::ostream &errFile = anInput.m_output.errFile();
+
+		pFuncDescFile->setReadThreads(std::max(nThreads / nFileThreads, 1u));
+		if (pDisassembler) {
+			std::unique_ptr<CDisassembler> pFileDisassembler = pDisassembler->CreateDisassembler();
+			pFileDisassembler->setDeterministic(bDeterministic);
+			ifstreamControlFile CtrlFile(strFilename);
+			if (!CtrlFile.is_open()) {
+				errFile << "*** Error: Opening control file \"" << strFilename << "\" for reading...\n";
+				anInput.m_bReadError = true;
+				return;
+			}
+			bool bOkFlag = pFileDisassembler->ReadControlFile(CtrlFile, true, &msgFile, &errFile);
+			CtrlFile.close();
+			if (!bOkFlag || !pFuncDescFile->ReadDisassembly(pFuncDescFile, *pFileDisassembler, &msgFile, &errFile)) {
+				errFile << "*** Error: Disassembling control file \"" << strFilename << "\"...\n";
+				anInput.m_bReadError = true;
+				return;
+			}
+		} else if (CFuncDescFile::isBinaryFile(strFilename)) {
+			pFuncDescFile->ReadBinaryFile(pFuncDescFile, strFilename, &msgFile, &errFile);
+			anInput.m_bBinaryInput = true;
+		} else {
+			ifstreamFuncDescFile fileFunc(strFilename);
+			if (!fileFunc.is_open()) {
+				errFile << "*** Error: Opening Function Definition File \"" << strFilename << "\" for reading...\n";
+				anInput.m_bReadError = true;
+				return;
+			}
+			pFuncDescFile->ReadFuncDescFile(pFuncDescFile, fileFunc, &msgFile, &errFile);
+			fileFunc.close();
+		}
+	}, "Read Input Files");
+
+	for (auto const & pInput : arrInputFiles) {
+		pInput->m_output.replay(std::cout, std::cerr);
+		if (pInput->m_bReadError) return -3;
+		std::shared_ptr<CFuncDescFile> pFuncDescFile = pInput->m_pFuncDescFile;
+		const bool bBinaryInput = pInput->m_bBinaryInput;
+
+		if (m_bWriteBinaryFuncFiles && !bBinaryInput) {
+			std::fstream fileFuncBin;
+			TString strBinFilename = std::filesystem::path(pFuncDescFile->GetFuncPathName()).replace_extension(".fnb").string();
+			if (!openForWriting(m_bForceOverwrite, fileFuncBin, strBinFilename, "Binary Function Definition", std::ios_base::out | std::ios_base::binary)) return -2;
+			std::cout << "Writing Binary Function Definition File " << std::filesystem::relative(strBinFilename) << "...\n\n";
+			if (!pFuncDescFile->WriteBinaryFile(fileFuncBin)) {
+				std::cerr << "\n*** Error: Writing Binary Function Definition Output File \"" << strBinFilename << "\"\n\n";
+				return -2;
+			}
+			fileFuncBin.close();
 		}
-		pFuncDescFile->ReadFuncDescFile(pFuncDescFile, fileFunc, &std::cout, &std::cerr);
-		fileFunc.close();
 
 		if (fileDFRO.is_open()) {
+			CPerfStats::CPhase phase("DiffReadyOutput");
 			fileDFRO << std::string(pFuncDescFile->GetFuncFileName().size()+7, '=') + "\n";
 			fileDFRO << "File \"" << pFuncDescFile->GetFuncFileName() << "\"\n";
 			fileDFRO << std::string(pFuncDescFile->GetFuncFileName().size()+7, '=') + "\n";
@@ -615,541 +1147,866 @@ int main(int argc, char* argv[])
 //return;
 
 	if (fileMatrixOut.is_open() ||
+		fileMatrixBinOut.is_open() ||
 		fileComp.is_open() ||
 		fileOES.is_open() ||
-		fileSym.is_open()) {
-
-		if (m_strMatrixInFilename.empty()) {
-			std::cout << "Cross-Comparing Functions...\n";
-		} else {
-			std::cout << "Using specified Cross-Comparison Matrix File: \"" << m_strMatrixInFilename << "\"...\n";
-			fileMatrixIn.open(m_strMatrixInFilename, std::ios_base::in);
-			if (!fileMatrixIn.is_open()) {
-				std::cerr << "*** Error: Opening Matrix Input File \"" << m_strMatrixInFilename << "\" for reading...\n";
-				return -4;
+		fileSym.is_open() ||
+		fileLineage.is_open()) {
+
+		// With only one input file, it's compared against itself, and with
+		//	more than two, every pair of them is compared:
+		const bool bSelfCompare = (m_arrFuncFiles.size() == 1);
+		const bool bMultiCompare = (m_arrFuncFiles.size() > 2);
+		CComparePairArray arrComparePairs;
+		if (bMultiCompare) {
+			arrComparePairs.reserve(m_arrFuncFiles.size() * (m_arrFuncFiles.size()-1) / 2);
+			for (CFuncDescFileArray::size_type ndxLeftFile = 0; ndxLeftFile < m_arrFuncFiles.size(); ++ndxLeftFile) {
+				for (CFuncDescFileArray::size_type ndxRightFile = ndxLeftFile+1; ndxRightFile < m_arrFuncFiles.size(); ++ndxRightFile) {
+					arrComparePairs.emplace_back(ndxLeftFile, ndxRightFile);
+				}
 			}
+		} else {
+			assert(m_arrFuncFiles.size() >= 1);
+			arrComparePairs.emplace_back(0, (bSelfCompare ? 0 : 1));
 		}
 
-		assert(m_arrFuncFiles.size() >= 2);
-		std::shared_ptr<const CFuncDescFile> pFuncFile1 = m_arrFuncFiles.at(0);
-		std::shared_ptr<const CFuncDescFile> pFuncFile2 = m_arrFuncFiles.at(1);
-
-
-		// Allocate Memory:
-		for (CFuncDescArray::size_type ndx = 0; ndx < pFuncFile1->GetFuncCount(); ++ndx) {
-			m_matrixFuncCompResult.push_back(CCompResultArray(pFuncFile2->GetFuncCount()));
-		}
-		for (CFuncDescArray::size_type ndx = 0; ndx < pFuncFile1->GetDataBlockCount(); ++ndx) {
-			m_matrixDataCompResult.push_back(CCompResultArray(pFuncFile2->GetDataBlockCount()));
-		}
+		// Compares a pair of functions.  With the pre-filter, pairs that
+		//	can't possibly reach the match limit are skipped:
+		const bool bPruneByLimit = (bPreFilter && (nMinCompLimit > 0.0));
+		std::atomic<std::size_t> nPrunedCount = 0;
+		std::atomic<std::size_t> nComparedCount = 0;
+		auto const &&fnCompareFunctions = [&](FUNC_COMPARE_TYPE nCompareType,
+												const CFuncDescFile &file1, CFuncDescArray::size_type ndxFile1,
+												const CFuncDescFile &file2, CFuncDescArray::size_type ndxFile2)->double {
+			if (bPruneByLimit) {
+				++nComparedCount;
+				if (CompareFunctionsUpperBound(nCompareType, file1, ndxFile1, file2, ndxFile2) < nMinCompLimit) {
+					++nPrunedCount;
+					return 0.0;
+				}
+			}
+			return CompareFunctions(nCompareType, nCompMethod, file1, ndxFile1, file2, ndxFile2, false).m_nMatchPercent;
+		};
+
+		// Compares a row's functions for its best matches only (see -bo).
+		//	Its candidates are taken in order of their upper bound, highest
+		//	first, so that the best matches, and with them the threshold of
+		//	what can still be kept, rise quickly.  Candidates whose bound is
+		//	already below the threshold are skipped, and the rest stop once
+		//	they can't reach it.  Anything fnKnownResult(ndxFile2, nResult)
+		//	returns true for isn't compared, but has its nResult added:
+		std::atomic<std::size_t> nBestOnlyCount = 0;
+		std::atomic<std::size_t> nBestOnlySkipped = 0;
+		std::atomic<std::size_t> nBestOnlyStopped = 0;
+		auto const &&fnBestOnlyRow = [&](FUNC_COMPARE_TYPE nCompareType,
+											const CFuncDescFile &file1, CFuncDescArray::size_type ndxFile1,
+											const CFuncDescFile &file2, CCompBestMatches &bestMatches,
+											auto &&fnKnownResult)->void {
+			const CFuncDescArray::size_type nCount2 = ((nCompareType == FCT_FUNCTIONS) ? file2.GetFuncCount() : file2.GetDataBlockCount());
+			std::vector< std::pair<double, CFuncDescArray::size_type> > arrCandidates;		// Upper bound and index
+			arrCandidates.reserve(nCount2);
+			for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < nCount2; ++ndxFile2) {
+				double nResult = 0.0;
+				if (fnKnownResult(ndxFile2, nResult)) {
+					bestMatches.add(ndxFile1, ndxFile2, nResult);
+				} else {
+					arrCandidates.emplace_back(CompareFunctionsUpperBound(nCompareType, file1, ndxFile1, file2, ndxFile2), ndxFile2);
+				}
+			}
+			std::stable_sort(arrCandidates.begin(), arrCandidates.end(), [](const auto &aLeft, const auto &aRight)->bool {
+				return (aLeft.first > aRight.first);
+			});
+
+			nBestOnlyCount += arrCandidates.size();
+			for (auto const & aCandidate : arrCandidates) {
+				const double nThreshold = bestMatches.threshold(ndxFile1, aCandidate.second);
+				if ((aCandidate.first <= 0.0) || (aCandidate.first < nThreshold)) {
+					++nBestOnlySkipped;
+					continue;
+				}
+				const CFuncCompareResult aResult = CompareFunctionsBounded(nCompareType, nCompMethod, file1, ndxFile1, file2, aCandidate.second, nThreshold);
+				if (aResult.m_bBelowThreshold) {
+					++nBestOnlyStopped;
+					continue;
+				}
+				bestMatches.add(ndxFile1, aCandidate.second, aResult.m_nMatchPercent);
+			}
+		};
+
+		if (bMultiCompare) {
+			CPerfStats::CPhase phase("ComparisonMatrix");
+			std::cout << "Cross-Comparing Functions of " << m_arrFuncFiles.size() << " Files...\n";
+
+			// All of the pairs are computed together in one run of the worker
+			//	threads, with each row of each pair as a job.  Like the rows of
+			//	a single pair below, they are handed out largest first, across
+			//	all of the pairs and for both functions and data blocks.  As
+			//	there's no matrix to output, only the best matches are kept,
+			//	as with -k:
+			struct TRowJob {
+				CComparePair *m_pComparePair;
+				FUNC_COMPARE_TYPE m_nCompareType;
+				CFuncDescArray::size_type m_ndxFile1;
+				CFuncDesc::size_type m_nSize;			// Size of the row's function, for ordering
+			};
+			std::vector<TRowJob> arrRowJobs;
+			for (auto & aComparePair : arrComparePairs) {
+				const CFuncDescFile &file1 = *m_arrFuncFiles.at(aComparePair.m_ndxLeftFile);
+				const CFuncDescFile &file2 = *m_arrFuncFiles.at(aComparePair.m_ndxRightFile);
+				aComparePair.m_bestFuncMatches.resize(file1.GetFuncCount(), file2.GetFuncCount(), false, ((nTopK != 0) ? nTopK : 1), nMinCompLimit);
+				aComparePair.m_bestDataMatches.resize(file1.GetDataBlockCount(), file2.GetDataBlockCount(), false, ((nTopK != 0) ? nTopK : 1), nMinCompLimit);
+				for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < file1.GetFuncCount(); ++ndxFile1) {
+					arrRowJobs.push_back({ &aComparePair, FCT_FUNCTIONS, ndxFile1, file1.GetFunc(ndxFile1).size() });
+				}
+				for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < file1.GetDataBlockCount(); ++ndxFile1) {
+					arrRowJobs.push_back({ &aComparePair, FCT_DATABLOCKS, ndxFile1, file1.GetDataBlock(ndxFile1).size() });
+				}
+			}
+			std::stable_sort(arrRowJobs.begin(), arrRowJobs.end(), [](const TRowJob &aLeft, const TRowJob &aRight)->bool {
+				return (aLeft.m_nSize > aRight.m_nSize);
+			});
+
+			std::cerr << "Computing Function and Data Block Comparisons : Please Wait";
+			runParallel(arrRowJobs.size(), bSingleThreaded, "Comparison Matrix Rows", [&](std::size_t ndxJob)->void {
+				const TRowJob &aJob = arrRowJobs[ndxJob];
+				const CFuncDescFile &file1 = *m_arrFuncFiles.at(aJob.m_pComparePair->m_ndxLeftFile);
+				const CFuncDescFile &file2 = *m_arrFuncFiles.at(aJob.m_pComparePair->m_ndxRightFile);
+				const bool bFunctions = (aJob.m_nCompareType == FCT_FUNCTIONS);
+				CCompBestMatches &bestMatches = (bFunctions ? aJob.m_pComparePair->m_bestFuncMatches : aJob.m_pComparePair->m_bestDataMatches);
+				std::cerr << ".";
+				if (bBestOnly) {
+					fnBestOnlyRow(aJob.m_nCompareType, file1, aJob.m_ndxFile1, file2, bestMatches, [](CFuncDescArray::size_type, double &)->bool { return false; });
+					return;
+				}
+				for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < (bFunctions ? file2.GetFuncCount() : file2.GetDataBlockCount()); ++ndxFile2) {
+					bestMatches.add(aJob.m_ndxFile1, ndxFile2, fnCompareFunctions(aJob.m_nCompareType, file1, aJob.m_ndxFile1, file2, ndxFile2));
+				}
+			});
+		} else {
+			if (m_strMatrixInFilename.empty()) {
+				std::cout << (bSelfCompare ? "Self-Comparing Functions...\n" : "Cross-Comparing Functions...\n");
+			} else {
+				std::cout << "Using specified Cross-Comparison Matrix File: \"" << m_strMatrixInFilename << "\"...\n";
+				fileMatrixIn.open(m_strMatrixInFilename, std::ios_base::in);
+				if (!fileMatrixIn.is_open()) {
+					std::cerr << "*** Error: Opening Matrix Input File \"" << m_strMatrixInFilename << "\" for reading...\n";
+					return -4;
+				}
+			}
 
-		// Read Matrix file if using it for cross-compare info:
-		if (fileMatrixIn.is_open()) {
-			TString strLine;
-			std::getline(fileMatrixIn, strLine);
-			bool bMatrixMatchesFunctions = true;		// True if the matrix input file matches the function files
+			CComparePair &aComparePair = arrComparePairs.front();
+			std::shared_ptr<const CFuncDescFile> pFuncFile1 = m_arrFuncFiles.at(aComparePair.m_ndxLeftFile);
+			std::shared_ptr<const CFuncDescFile> pFuncFile2 = m_arrFuncFiles.at(aComparePair.m_ndxRightFile);
+			nMatrixEndRow = std::min(nMatrixEndRow, pFuncFile1->GetFuncCount());
+			nMatrixFirstRow = std::min(nMatrixFirstRow, nMatrixEndRow);
 
-			CStringArray arrMatrixSize = parseCSVLine(strLine);
-			CFuncDescArray::size_type nTempFunc1Size = 0;
-			CFuncDescArray::size_type nTempFunc2Size = 0;
 
-			if (arrMatrixSize.size() == 2) {
-				nTempFunc1Size = atoi(trim(arrMatrixSize[0]).c_str());
-				nTempFunc2Size = atoi(trim(arrMatrixSize[1]).c_str());
+			// Allocate Memory:
+			//	With -k, results go directly to the top-K best matches and the
+			//	whole matrix is only needed for reading one with -mi.  Otherwise,
+			//	the best matches are found from the matrix once it's complete:
+			const bool bTopK = (nTopK != 0);
+			if (!bTopK || !m_strMatrixInFilename.empty()) {
+				m_matrixFuncCompResult.resize(pFuncFile1->GetFuncCount(), pFuncFile2->GetFuncCount(), bSelfCompare);
 			}
-
-			if ((nTempFunc1Size != pFuncFile1->GetFuncCount()) ||
-				(nTempFunc2Size != pFuncFile2->GetFuncCount())) {
-				bMatrixMatchesFunctions = false;
-			} else {
-				CStringArray arrMatrixLine;
-				bool bReadGood = true;
-				std::getline(fileMatrixIn, strLine);	// Read and compare function names on break-points line
-				int nLine = 2;		// We already read the first two lines
-				arrMatrixLine = parseCSVLine(strLine);
-				if (arrMatrixLine.size() != (nTempFunc2Size+1)) {
-					bReadGood = false;
+			if (!bTopK) {
+				m_matrixDataCompResult.resize(pFuncFile1->GetDataBlockCount(), pFuncFile2->GetDataBlockCount(), bSelfCompare);
+			}
+			aComparePair.m_bestFuncMatches.resize(pFuncFile1->GetFuncCount(), pFuncFile2->GetFuncCount(), bSelfCompare, (bTopK ? nTopK : 1), nMinCompLimit);
+			aComparePair.m_bestDataMatches.resize(pFuncFile1->GetDataBlockCount(), pFuncFile2->GetDataBlockCount(), bSelfCompare, (bTopK ? nTopK : 1), nMinCompLimit);
+
+			// Function hashes identifying the rows and columns in binary matrix files:
+			const CMatrixHashArray arrRowHashes = CCompResultMatrix::hashFunctions(*pFuncFile1);
+			const CMatrixHashArray arrColHashes = CCompResultMatrix::hashFunctions(*pFuncFile2);
+
+			// Binary Input Matrix that only partially matches the functions, whose
+			//	results are reused for the functions that haven't changed, indexed
+			//	by the function hashes:
+			CCompResultMatrix matrixCached;
+			std::unordered_map<TMatrixHash, CFuncDescArray::size_type> mapCachedRows;
+			std::unordered_map<TMatrixHash, CFuncDescArray::size_type> mapCachedCols;
+			std::atomic<std::size_t> nReusedCount = 0;
+
+			// Computes one result of a comparison matrix.  When self-comparing,
+			//	only the upper triangle is computed, as the lower one is its mirror
+			//	and the diagonal is each function compared to itself, which is a
+			//	complete match for any non-empty function:
+			double nMatrixPreFilterLimit = (bPruneByLimit ? nMinCompLimit : 0.0);		// Pre-Filter limit of the resulting function matrix, including any reused results
+			auto const &&fnCompareResult = [&](FUNC_COMPARE_TYPE nCompareType,
+												CFuncDescArray::size_type ndxFile1, CFuncDescArray::size_type ndxFile2)->double {
+				if (bSelfCompare && (ndxFile2 == ndxFile1)) {
+					const CFuncDesc &function = ((nCompareType == FCT_FUNCTIONS) ? pFuncFile1->GetFunc(ndxFile1) : pFuncFile1->GetDataBlock(ndxFile1));
+					return (!function.empty() ? 1.0 : 0.0);
+				}
+				if ((nCompareType == FCT_FUNCTIONS) && !mapCachedRows.empty()) {
+					auto const itrRow = mapCachedRows.find(arrRowHashes.at(ndxFile1));
+					auto const itrCol = mapCachedCols.find(arrColHashes.at(ndxFile2));
+					if ((itrRow != mapCachedRows.cend()) && (itrCol != mapCachedCols.cend())) {
+						++nReusedCount;
+						return matrixCached.at(itrRow->second, itrCol->second);
+					}
+				}
+				return fnCompareFunctions(nCompareType, *pFuncFile1, ndxFile1, *pFuncFile2, ndxFile2);
+			};
+			auto const &&fnComputeResult = [&](FUNC_COMPARE_TYPE nCompareType, CCompResultMatrix &matrixCompResult, CCompBestMatches &bestMatches,
+												CFuncDescArray::size_type ndxFile1, CFuncDescArray::size_type ndxFile2)->void {
+				if (bSelfCompare && (ndxFile2 < ndxFile1)) return;
+				const double nResult = fnCompareResult(nCompareType, ndxFile1, ndxFile2);
+				if (bTopK) {
+					bestMatches.add(ndxFile1, ndxFile2, nResult);
 				} else {
-					// Check the function names to make sure they match:
-					for (CFuncDescArray::size_type ndxFile2 = 0; ((ndxFile2 < nTempFunc2Size) && bMatrixMatchesFunctions); ++ndxFile2) {
-						if (arrMatrixLine[ndxFile2+1] != pFuncFile2->GetFunc(ndxFile2).GetMainName()) {
-							std::cerr <<"*** Expected function \"" << pFuncFile2->GetFunc(ndxFile2).GetMainName() <<
-										"\" on line " << nLine << ", column " << static_cast<int>(ndxFile2+1) << " of matrix file, but found \"" << arrMatrixLine[ndxFile2+1] << "\"\n";
-							bMatrixMatchesFunctions = false;
+					matrixCompResult.set(ndxFile1, ndxFile2, nResult);
+				}
+			};
+			auto const &&fnComputeRow = [&](FUNC_COMPARE_TYPE nCompareType, CCompResultMatrix &matrixCompResult, CCompBestMatches &bestMatches,
+												CFuncDescArray::size_type ndxFile1)->void {
+				if (bBestOnly) {
+					// The self-compare diagonal and lower triangle are skipped
+					//	(and ignored by add()), and any reused results added:
+					fnBestOnlyRow(nCompareType, *pFuncFile1, ndxFile1, *pFuncFile2, bestMatches, [&](CFuncDescArray::size_type ndxFile2, double &nResult)->bool {
+						if (bSelfCompare && (ndxFile2 <= ndxFile1)) return true;
+						if ((nCompareType == FCT_FUNCTIONS) && !mapCachedRows.empty()) {
+							auto const itrRow = mapCachedRows.find(arrRowHashes.at(ndxFile1));
+							auto const itrCol = mapCachedCols.find(arrColHashes.at(ndxFile2));
+							if ((itrRow != mapCachedRows.cend()) && (itrCol != mapCachedCols.cend())) {
+								++nReusedCount;
+								nResult = matrixCached.at(itrRow->second, itrCol->second);
+								return true;
+							}
 						}
+						return false;
+					});
+				} else {
+					const CFuncDescArray::size_type nCount2 = ((nCompareType == FCT_FUNCTIONS) ? pFuncFile2->GetFuncCount() : pFuncFile2->GetDataBlockCount());
+					for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < nCount2; ++ndxFile2) {
+						fnComputeResult(nCompareType, matrixCompResult, bestMatches, ndxFile1, ndxFile2);
 					}
 				}
-				for (CFuncDescArray::size_type ndxFile1 = 0; ((ndxFile1 < nTempFunc1Size) && bReadGood && bMatrixMatchesFunctions); ++ndxFile1) {
-					if (!fileMatrixIn.good() || fileMatrixIn.eof()) {
-						bReadGood = false;
-						continue;
+			};
+
+			// Read Matrix file if using it for cross-compare info:
+			if (fileMatrixIn.is_open() && CCompResultMatrix::isBinaryFile(m_strMatrixInFilename)) {
+				// Binary matrix files are mapped directly as the results, or if
+				//	only some of the functions match, the matching results are
+				//	reused and only the rest are computed:
+				CPerfStats::CPhase phase("ReadMatrixFile");
+				fileMatrixIn.close();
+				CCompMatrixInfo infoMatrix;
+				TString strError;
+				bool bUseMatrix = false;
+				if (!matrixCached.readBinary(m_strMatrixInFilename, infoMatrix, strError)) {
+					std::cerr << "*** Warning: Failed to read Input Matrix File.\n"
+									"        " << strError << ".\n"
+									"        Reverting to perform a full cross-comparison.\n";
+				} else if (infoMatrix.m_nCompareMethod != nCompMethod) {
+					std::cerr << "*** Warning: Specified Input Matrix File was computed with\n"
+									"        a different comparison algorithm.  A full\n"
+									"        cross-comparison will be performed!\n\n";
+				} else if (infoMatrix.m_nPreFilterLimit > nMinCompLimit) {
+					std::cerr << "*** Warning: Specified Input Matrix File was pre-filtered\n"
+									"        with a higher match limit of " << (infoMatrix.m_nPreFilterLimit * 100.0) << "%.  A full\n"
+									"        cross-comparison will be performed!\n\n";
+				} else if ((matrixCached.isSymmetric() == bSelfCompare) &&
+							(infoMatrix.m_arrRowHashes == arrRowHashes) &&
+							(infoMatrix.m_arrColHashes == arrColHashes)) {
+					m_matrixFuncCompResult = std::move(matrixCached);
+					bUseMatrix = true;
+				} else {
+					std::cerr << "*** Specified Input Matrix File doesn't fully match the\n"
+									"        specified function description files.  Results of\n"
+									"        unchanged functions will be reused and the rest\n"
+									"        recomputed.\n\n";
+					for (CFuncDescArray::size_type ndx = 0; ndx < infoMatrix.m_arrRowHashes.size(); ++ndx) {
+						mapCachedRows.insert({ infoMatrix.m_arrRowHashes.at(ndx), ndx });	// Duplicates are identical functions, so the first is as good as any
+					}
+					for (CFuncDescArray::size_type ndx = 0; ndx < infoMatrix.m_arrColHashes.size(); ++ndx) {
+						mapCachedCols.insert({ infoMatrix.m_arrColHashes.at(ndx), ndx });
 					}
+					nMatrixPreFilterLimit = std::max(nMatrixPreFilterLimit, infoMatrix.m_nPreFilterLimit);
+				}
+				if (bUseMatrix) {
+					nMatrixPreFilterLimit = infoMatrix.m_nPreFilterLimit;
+				} else {
+					m_strMatrixInFilename.clear();
+				}
+			} else if (fileMatrixIn.is_open()) {
+				CPerfStats::CPhase phase("ReadMatrixFile");
+				TString strLine;
+				std::getline(fileMatrixIn, strLine);
+				bool bMatrixMatchesFunctions = true;		// True if the matrix input file matches the function files
+
+				CStringArray arrMatrixSize = parseCSVLine(strLine);
+				CFuncDescArray::size_type nTempFunc1Size = 0;
+				CFuncDescArray::size_type nTempFunc2Size = 0;
+
+				if (arrMatrixSize.size() == 2) {
+					nTempFunc1Size = atoi(trim(arrMatrixSize[0]).c_str());
+					nTempFunc2Size = atoi(trim(arrMatrixSize[1]).c_str());
+				}
 
-					std::getline(fileMatrixIn, strLine);
-					++nLine;
+				if ((nTempFunc1Size != pFuncFile1->GetFuncCount()) ||
+					(nTempFunc2Size != pFuncFile2->GetFuncCount())) {
+					bMatrixMatchesFunctions = false;
+				} else {
+					CStringArray arrMatrixLine;
+					bool bReadGood = true;
+					std::getline(fileMatrixIn, strLine);	// Read and compare function names on break-points line
+					int nLine = 2;		// We already read the first two lines
 					arrMatrixLine = parseCSVLine(strLine);
-
-					if (arrMatrixLine.size() != (nTempFunc2Size+1)) {	// Will be +1 due to 'Y' break-points
+					if (arrMatrixLine.size() != (nTempFunc2Size+1)) {
 						bReadGood = false;
-						continue;
-					} else if (arrMatrixLine[0] != pFuncFile1->GetFunc(ndxFile1).GetMainName()) {
-						std::cerr <<"*** Expected function \"" << pFuncFile1->GetFunc(ndxFile1).GetMainName() <<
-									"\" on line " << nLine << " of matrix file, but found \"" << arrMatrixLine[0] << "\"\n";
-						bMatrixMatchesFunctions = false;
-						continue;
+					} else {
+						// Check the function names to make sure they match:
+						for (CFuncDescArray::size_type ndxFile2 = 0; ((ndxFile2 < nTempFunc2Size) && bMatrixMatchesFunctions); ++ndxFile2) {
+							if (arrMatrixLine[ndxFile2+1] != pFuncFile2->GetFunc(ndxFile2).GetMainName()) {
+								std::cerr <<"*** Expected function \"" << pFuncFile2->GetFunc(ndxFile2).GetMainName() <<
+											"\" on line " << nLine << ", column " << static_cast<int>(ndxFile2+1) << " of matrix file, but found \"" << arrMatrixLine[ndxFile2+1] << "\"\n";
+								bMatrixMatchesFunctions = false;
+							}
+						}
 					}
-					for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < nTempFunc2Size; ++ndxFile2) {
-						m_matrixFuncCompResult[ndxFile1][ndxFile2] = atof(trim(arrMatrixLine[ndxFile2+1]).c_str());	// +1 to skip Y breakpoint
+					for (CFuncDescArray::size_type ndxFile1 = 0; ((ndxFile1 < nTempFunc1Size) && bReadGood && bMatrixMatchesFunctions); ++ndxFile1) {
+						if (!fileMatrixIn.good() || fileMatrixIn.eof()) {
+							bReadGood = false;
+							continue;
+						}
+
+						std::getline(fileMatrixIn, strLine);
+						++nLine;
+						arrMatrixLine = parseCSVLine(strLine);
+
+						if (arrMatrixLine.size() != (nTempFunc2Size+1)) {	// Will be +1 due to 'Y' break-points
+							bReadGood = false;
+							continue;
+						} else if (arrMatrixLine[0] != pFuncFile1->GetFunc(ndxFile1).GetMainName()) {
+							std::cerr <<"*** Expected function \"" << pFuncFile1->GetFunc(ndxFile1).GetMainName() <<
+										"\" on line " << nLine << " of matrix file, but found \"" << arrMatrixLine[0] << "\"\n";
+							bMatrixMatchesFunctions = false;
+							continue;
+						}
+						for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < nTempFunc2Size; ++ndxFile2) {
+							m_matrixFuncCompResult.set(ndxFile1, ndxFile2, atof(trim(arrMatrixLine[ndxFile2+1]).c_str()));	// +1 to skip Y breakpoint
+						}
+					}
+					if (!bReadGood && bMatrixMatchesFunctions) {	// Only print bad file warning if things are matching, otherwise print the mismatch error below
+						std::cerr << "*** Warning: Failed to read Input Matrix File.\n"
+										"        Bad line at " << nLine << ".\n"
+										"        Reverting to perform a full cross-comparison.\n";
+						m_strMatrixInFilename.clear();
 					}
 				}
-				if (!bReadGood && bMatrixMatchesFunctions) {	// Only print bad file warning if things are matching, otherwise print the mismatch error below
-					std::cerr << "*** Warning: Failed to read Input Matrix File.\n"
-									"        Bad line at " << nLine << ".\n"
-									"        Reverting to perform a full cross-comparison.\n";
-					m_strMatrixInFilename.clear();
-				}
-			}
 
-			fileMatrixIn.close();
+				fileMatrixIn.close();
 
-			if (!bMatrixMatchesFunctions) {
-				std::cerr << "*** Warning: Specified Input Matrix File doesn't match\n"
-								"        the specified function description files.  A full\n"
-								"        cross-comparison will be performed!\n\n";
-				m_strMatrixInFilename.clear();
-			}
-		}
-
-		// If no MatrixIn file was specified or we failed to read it,
-		//	do complete cross comparison:
-		if (m_strMatrixInFilename.empty()) {
-			std::cerr << "Computing Function Comparison : Please Wait";
-			if (fileMatrixOut.is_open()) {
-				// Write 'X' breakpoints:
-				fileMatrixOut << pFuncFile1->GetFuncCount() << "," << pFuncFile2->GetFuncCount() << "\n";
-				for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetFuncCount(); ++ndxFile2) {
-					fileMatrixOut << "," << pFuncFile2->GetFunc(ndxFile2).GetMainName();
+				if (!bMatrixMatchesFunctions) {
+					std::cerr << "*** Warning: Specified Input Matrix File doesn't match\n"
+									"        the specified function description files.  A full\n"
+									"        cross-comparison will be performed!\n\n";
+					m_strMatrixInFilename.clear();
 				}
-				fileMatrixOut << "\n";
 			}
 
-			// Compute the Function Comparison Results:
-			if (bSingleThreaded) {
-				// Single-Threaded Version:
-				for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < pFuncFile1->GetFuncCount(); ++ndxFile1) {
-					std::cerr << ".";
-					if (fileMatrixOut.is_open()) {
-						fileMatrixOut << pFuncFile1->GetFunc(ndxFile1).GetMainName();		// Y breakpoint
-					}
+			// If no MatrixIn file was specified or we failed to read it,
+			//	do complete cross comparison:
+			if (m_strMatrixInFilename.empty()) {
+				CPerfStats::CPhase phase("FunctionMatrix");
+				std::cerr << "Computing Function Comparison : Please Wait";
+				if (fileMatrixOut.is_open()) {
+					// Write 'X' breakpoints:
+					fileMatrixOut << pFuncFile1->GetFuncCount() << "," << pFuncFile2->GetFuncCount() << "\n";
 					for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetFuncCount(); ++ndxFile2) {
-						m_matrixFuncCompResult[ndxFile1][ndxFile2] = CompareFunctions(FCT_FUNCTIONS, nCompMethod, *pFuncFile1, ndxFile1, *pFuncFile2, ndxFile2, false);
+						fileMatrixOut << "," << pFuncFile2->GetFunc(ndxFile2).GetMainName();
+					}
+					fileMatrixOut << "\n";
+				}
+
+				// Compute the Function Comparison Results (all rows, unless
+				//	it's a shard of the matrix):
+				if (bSingleThreaded) {
+					// Single-Threaded Version:
+					for (CFuncDescArray::size_type ndxFile1 = nMatrixFirstRow; ndxFile1 < nMatrixEndRow; ++ndxFile1) {
+						std::cerr << ".";
+						if (bBestOnly) {		// Never has a matrix to output
+							fnComputeRow(FCT_FUNCTIONS, m_matrixFuncCompResult, aComparePair.m_bestFuncMatches, ndxFile1);
+							continue;
+						}
 						if (fileMatrixOut.is_open()) {
-							char arrTemp[30];
-							std::sprintf(arrTemp, ",%.12g", m_matrixFuncCompResult[ndxFile1][ndxFile2]);
-							fileMatrixOut << arrTemp;
+							fileMatrixOut << pFuncFile1->GetFunc(ndxFile1).GetMainName();		// Y breakpoint
+						}
+						for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetFuncCount(); ++ndxFile2) {
+							fnComputeResult(FCT_FUNCTIONS, m_matrixFuncCompResult, aComparePair.m_bestFuncMatches, ndxFile1, ndxFile2);
+							if (fileMatrixOut.is_open()) {
+								char arrTemp[30];
+								std::sprintf(arrTemp, ",%.12g", m_matrixFuncCompResult.at(ndxFile1, ndxFile2));
+								fileMatrixOut << arrTemp;
+							}
+						}
+						if (fileMatrixOut.is_open()) {
+							fileMatrixOut << "\n";
 						}
 					}
-					if (fileMatrixOut.is_open()) {
-						fileMatrixOut << "\n";
+				} else {
+					// Multi-Threaded Version:
+					//	Rows are handed out in SortedFunctionMap order, which is largest
+					//	functions first, so that the expensive rows get started early and
+					//	the small ones balance out the end:
+					std::vector<CFuncDescArray::size_type> arrRowOrder;
+					for (auto const & itrFuncMap : pFuncFile1->GetSortedFunctionMap()) {
+						if ((itrFuncMap.second >= nMatrixFirstRow) && (itrFuncMap.second < nMatrixEndRow)) arrRowOrder.push_back(itrFuncMap.second);
 					}
-				}
-			} else {
-				// Multi-Threaded Version:
-				CFuncDescArray::size_type nThreadGroupSize = pFuncFile1->GetFuncCount() / threadCount();	// How many things each thread will be processing
-				CFuncDescArray::size_type nRemainingSize = pFuncFile1->GetFuncCount() - (nThreadGroupSize * threadCount());		// Remaining functions not covered by threads
-				std::vector<std::unique_ptr<std::thread>> arrThreads;
-				// "stripe" the function list giving an equal number of large and small functions
-				//		to each thread.  The SortedFunctionMap of the function files have them
-				//		in order, so we assign the first function to the first thread, the second
-				//		to the second thread, and so on.  The main thread will bring up the rear,
-				//		handling the last "stripe" and any remaining functions not evenly divisible
-				//		by the number of threads:
-				auto const &&fnCompare = [&](CFuncDescArray::size_type nStartOffset, CFuncDescArray::size_type nAdvance, CFuncDescArray::size_type nCount)->void {
-					CFunctionSizeMultimap::const_iterator itrFuncMap = pFuncFile1->GetSortedFunctionMap().cbegin();
-					std::advance(itrFuncMap, nStartOffset);
-					while (nCount > 0) {
+					runParallel(arrRowOrder.size(), false, "Function Matrix Rows", [&](std::size_t ndxRow)->void {
+						const CFuncDescArray::size_type ndxFile1 = arrRowOrder[ndxRow];
 						std::cerr << ".";		// On C++20, these are synchronized for multi-thread writes, only the data order isn't guaranteed, but just printing "." should be fine
-						for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetFuncCount(); ++ndxFile2) {
-							m_matrixFuncCompResult[itrFuncMap->second][ndxFile2] = CompareFunctions(FCT_FUNCTIONS, nCompMethod, *pFuncFile1, itrFuncMap->second, *pFuncFile2, ndxFile2, false);
+						fnComputeRow(FCT_FUNCTIONS, m_matrixFuncCompResult, aComparePair.m_bestFuncMatches, ndxFile1);
+					});
+
+					// Then output it to the file:
+					if (fileMatrixOut.is_open()) {
+						char arrTemp[30];
+						for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < pFuncFile1->GetFuncCount(); ++ndxFile1) {
+							fileMatrixOut << pFuncFile1->GetFunc(ndxFile1).GetMainName();		// Y breakpoint
+							for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetFuncCount(); ++ndxFile2) {
+								std::sprintf(arrTemp, ",%.12g", m_matrixFuncCompResult.at(ndxFile1, ndxFile2));
+								fileMatrixOut << arrTemp;
+							}
+							fileMatrixOut << "\n";
 						}
-						std::advance(itrFuncMap, nAdvance);
-						--nCount;
 					}
-				};
-
-				// Spawn the threads:
-				unsigned int nThreadCount = threadCount() - 1;
-				for (unsigned int nThread = 0; nThread < nThreadCount; ++nThread) {
-					arrThreads.push_back(std::make_unique<std::thread>(fnCompare, nThread, nThreadCount+1, nThreadGroupSize));
 				}
-				// Compute remaining on main-thread:
-				fnCompare(nThreadCount, nThreadCount+1, nThreadGroupSize);
-				if (nRemainingSize) fnCompare((nThreadCount+1)*nThreadGroupSize, 1, nRemainingSize);
-				// Wait for other threads to finish:
-				for (auto &pThread : arrThreads) {
-					pThread->join();
+
+				if (!mapCachedRows.empty()) {
+					std::cerr << "\n\nReused " << nReusedCount << " function comparisons from the Input Matrix File";
+					matrixCached.resize(0, 0, false);		// Release the mapping, which may be replaced below
 				}
 
-				// Then output it to the file:
-				if (fileMatrixOut.is_open()) {
-					char arrTemp[30];
-					for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < pFuncFile1->GetFuncCount(); ++ndxFile1) {
-						fileMatrixOut << pFuncFile1->GetFunc(ndxFile1).GetMainName();		// Y breakpoint
-						for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetFuncCount(); ++ndxFile2) {
-							std::sprintf(arrTemp, ",%.12g", m_matrixFuncCompResult[ndxFile1][ndxFile2]);
-							fileMatrixOut << arrTemp;
-						}
-						fileMatrixOut << "\n";
-					}
+				std::cerr << "\n\n";
+			}
+
+			if (fileMatrixBinOut.is_open()) {
+				CPerfStats::CPhase phase("WriteBinaryMatrix");
+				CCompMatrixInfo infoMatrix;
+				infoMatrix.m_nCompareMethod = nCompMethod;
+				infoMatrix.m_nPreFilterLimit = nMatrixPreFilterLimit;
+				infoMatrix.m_arrRowHashes = arrRowHashes;
+				infoMatrix.m_arrColHashes = arrColHashes;
+				if (!m_matrixFuncCompResult.writeBinaryRows(fileMatrixBinOut, infoMatrix, nMatrixFirstRow, nMatrixEndRow)) {
+					std::cerr << "*** Error: Writing Binary Matrix Output File \"" << m_strMatrixBinOutFilename << "\"\n";
 				}
 			}
 
-			std::cerr << "\n\n";
-		}
+			// Find the best function matches from the whole matrix, when it
+			//	exists, then with -k, it's no longer needed:
+			if (!bTopK || !m_strMatrixInFilename.empty()) {
+				aComparePair.m_bestFuncMatches.addMatrix(m_matrixFuncCompResult);
+				if (bTopK) m_matrixFuncCompResult.resize(0, 0, false);
+			}
 
-		// Compute the Data Block Comparison Results:
-		//		Currently, Data Block results are not written to
-		//		the matrix file (should it?).  So, we must always
-		//		calculate it:
-		std::cerr << "Computing Data Block Comparison : Please Wait";
-		for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < pFuncFile1->GetDataBlockCount(); ++ndxFile1) {
-			std::cerr << ".";
-			for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetDataBlockCount(); ++ndxFile2) {
-				m_matrixDataCompResult[ndxFile1][ndxFile2] = CompareFunctions(FCT_DATABLOCKS, nCompMethod, *pFuncFile1, ndxFile1, *pFuncFile2, ndxFile2, false);
+			// Compute the Data Block Comparison Results:
+			//		Currently, Data Block results are not written to
+			//		the matrix file (should it?).  So, we must always
+			//		calculate it, except for a shard of the matrix, which
+			//		has nothing else to output:
+			if (!bMatrixShard) {
+				CPerfStats::CPhase phase("DataBlockMatrix");
+				std::cerr << "Computing Data Block Comparison : Please Wait";
+				// Data Blocks don't have a sorted map, so order them here (largest first):
+				std::vector<CFuncDescArray::size_type> arrRowOrder(pFuncFile1->GetDataBlockCount());
+				for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < arrRowOrder.size(); ++ndxFile1) arrRowOrder[ndxFile1] = ndxFile1;
+				std::stable_sort(arrRowOrder.begin(), arrRowOrder.end(), [&pFuncFile1](CFuncDescArray::size_type nLeft, CFuncDescArray::size_type nRight)->bool {
+					return (pFuncFile1->GetDataBlock(nLeft).size() > pFuncFile1->GetDataBlock(nRight).size());
+				});
+				runParallel(arrRowOrder.size(), bSingleThreaded, "Data Block Matrix Rows", [&](std::size_t ndxRow)->void {
+					const CFuncDescArray::size_type ndxFile1 = arrRowOrder[ndxRow];
+					std::cerr << ".";
+					fnComputeRow(FCT_DATABLOCKS, m_matrixDataCompResult, aComparePair.m_bestDataMatches, ndxFile1);
+				});
 			}
+			if (!bTopK) aComparePair.m_bestDataMatches.addMatrix(m_matrixDataCompResult);
+		}
+		if (bPruneByLimit) {
+			std::cerr << "\n\nPre-Filter skipped " << nPrunedCount << " of " << nComparedCount << " comparisons below the match limit";
+		}
+		if (bBestOnly) {
+			std::cerr << "\n\nBest-Only skipped " << nBestOnlySkipped << " and stopped " << nBestOnlyStopped << " early of " << nBestOnlyCount << " comparisons";
 		}
 
+		// A shard of the matrix is only for merging with the rest of it (see
+		//	-mm), so there's nothing more to output from it:
+		if (bMatrixShard) arrComparePairs.clear();
 
-		if (fileComp.is_open()) {
-			fileComp << "Left Filename  : ";
-			fileComp << pFuncFile1->GetFuncPathName() + "\n";
-			fileComp << "Right Filename : ";
-			fileComp << pFuncFile2->GetFuncPathName() + "\n";
-			fileComp << "\n";
-		}
+		for (auto const & aComparePair : arrComparePairs) {
+			std::shared_ptr<const CFuncDescFile> pFuncFile1 = m_arrFuncFiles.at(aComparePair.m_ndxLeftFile);
+			std::shared_ptr<const CFuncDescFile> pFuncFile2 = m_arrFuncFiles.at(aComparePair.m_ndxRightFile);
+			const CCompBestMatches &bestFuncMatches = aComparePair.m_bestFuncMatches;
+			const CCompBestMatches &bestDataMatches = aComparePair.m_bestDataMatches;
+			CSymbolMap aSymbolMap;
 
-		if (fileOES.is_open()) {
-			fileOES << "; Left Filename  : ";
-			fileOES << pFuncFile1->GetFuncPathName() + "\n";
-			fileOES << "; Right Filename : ";
-			fileOES << pFuncFile2->GetFuncPathName() + "\n";
-		}
+			if (bMultiCompare) {
+				std::cout << "\n\nComparing \"" << pFuncFile1->GetFuncPathName() << "\" with \"" << pFuncFile2->GetFuncPathName() << "\":\n";
+			}
 
-		if (fileSym.is_open()) {
-			fileSym << "; Left Filename  : ";
-			fileSym << pFuncFile1->GetFuncPathName() + "\n";
-			fileSym << "; Right Filename : ";
-			fileSym << pFuncFile2->GetFuncPathName() + "\n";
-		}
+			if (fileComp.is_open()) {
+				fileComp << "Left Filename  : ";
+				fileComp << pFuncFile1->GetFuncPathName() + "\n";
+				fileComp << "Right Filename : ";
+				fileComp << pFuncFile2->GetFuncPathName() + "\n";
+				fileComp << "\n";
+			}
 
-		// --------------------------------------------------------------------
+			if (fileOES.is_open()) {
+				fileOES << "; Left Filename  : ";
+				fileOES << pFuncFile1->GetFuncPathName() + "\n";
+				fileOES << "; Right Filename : ";
+				fileOES << pFuncFile2->GetFuncPathName() + "\n";
+			}
 
-		typedef std::pair<TLabel, TLabel> TFunctionPair;
-		std::set<TFunctionPair> setCompsWritten;		// Pairing of Left/Right functions already outputted
-		std::ostringstream ssCompResult;
+			if (fileSym.is_open()) {
+				fileSym << "; Left Filename  : ";
+				fileSym << pFuncFile1->GetFuncPathName() + "\n";
+				fileSym << "; Right Filename : ";
+				fileSym << pFuncFile2->GetFuncPathName() + "\n";
+			}
 
-		// Output Function comparison of Left->Right
-		std::cout << "\nBest Function Matches (Left->Right):\n";
-		if (fileComp.is_open()) {
-			fileComp << "================================================================================\n";
-			fileComp << "                      Best Function Matches (Left->Right):\n";
-			fileComp << "================================================================================\n\n";
-		}
-		for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < pFuncFile1->GetFuncCount(); ++ndxFile1) {
-			nMaxCompResult = 0.0;
-			for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetFuncCount(); ++ndxFile2) nMaxCompResult = std::max(nMaxCompResult, m_matrixFuncCompResult[ndxFile1][ndxFile2]);
-			bFlag = false;
-			ssCompResult.str(std::string());
-			if ((nMaxCompResult > 0.0) && (nMaxCompResult >= nMinCompLimit)) {
-				ssCompResult << "    " << padString(pFuncFile1->GetFunc(ndxFile1).GetMainName(), CFuncObject::GetFieldWidth(CFuncObject::FIELD_CODE::FC_LABEL)) << " : ";
-				for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetFuncCount(); ++ndxFile2) {
-					if (m_matrixFuncCompResult[ndxFile1][ndxFile2] < nMaxCompResult) continue;
-
-					TFunctionPair thisFunctionPair(pFuncFile1->GetFunc(ndxFile1).GetMainName(),
-														 pFuncFile2->GetFunc(ndxFile2).GetMainName());
-					if (setCompsWritten.contains(thisFunctionPair)) continue;
-
-					if (bFlag) {
-						if (fileComp.is_open()) {
-							fileComp << "\n\n";
-						}
-						ssCompResult << ", ";
-					} else {
-						if (fileComp.is_open()) {
-							fileComp << "================================================================================\n";
+			// --------------------------------------------------------------------
+
+			typedef std::pair<TLabel, TLabel> TFunctionPair;
+			std::set<TFunctionPair> setCompsWritten;		// Pairing of Left/Right functions already outputted
+			std::ostringstream ssCompResult;
+			std::ostringstream ssComp;						// Pending Compare file output (see CComparisonJob)
+			CComparisonJobArray arrComparisonJobs;
+
+			auto &&queueComparison = [&](FUNC_COMPARE_TYPE nCompareType, CFuncDescArray::size_type ndxFile1, CFuncDescArray::size_type ndxFile2, double nCompResult)->void {
+				arrComparisonJobs.emplace_back(nCompareType, ndxFile1, ndxFile2, nCompResult, ssComp.str());
+				ssComp.str(std::string());
+			};
+
+			// Output Function comparison of Left->Right
+			std::cout << "\nBest Function Matches (Left->Right):\n";
+			if (fileComp.is_open()) {
+				ssComp << "================================================================================\n";
+				ssComp << "                      Best Function Matches (Left->Right):\n";
+				ssComp << "================================================================================\n\n";
+			}
+			for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < pFuncFile1->GetFuncCount(); ++ndxFile1) {
+				auto const arrBestMatches = bestFuncMatches.bestOfRow(ndxFile1);
+				bFlag = false;
+				ssCompResult.str(std::string());
+				if (!arrBestMatches.empty()) {
+					nMaxCompResult = arrBestMatches.front().m_nResult;
+					ssCompResult << "    " << padString(pFuncFile1->GetFunc(ndxFile1).GetMainName(), CFuncObject::GetFieldWidth(CFuncObject::FIELD_CODE::FC_LABEL)) << " : ";
+					for (auto const & aMatch : arrBestMatches) {
+						const CFuncDescArray::size_type ndxFile2 = aMatch.m_nIndex;
+
+						TFunctionPair thisFunctionPair(pFuncFile1->GetFunc(ndxFile1).GetMainName(),
+															 pFuncFile2->GetFunc(ndxFile2).GetMainName());
+						if (setCompsWritten.contains(thisFunctionPair)) continue;
+
+						if (bFlag) {
+							if (fileComp.is_open()) {
+								ssComp << "\n\n";
+							}
+							ssCompResult << ", ";
+						} else {
+							if (fileComp.is_open()) {
+								ssComp << "================================================================================\n";
+							}
 						}
-					}
-					bFlag = true;
+						bFlag = true;
 
-					ssCompResult << pFuncFile2->GetFunc(ndxFile2).GetMainName();
+						ssCompResult << pFuncFile2->GetFunc(ndxFile2).GetMainName();
 
-					dumpComparison(FCT_FUNCTIONS, fileComp, fileOES, bCompOESFlag, m_matrixFuncCompResult,
-									nCompMethod, pFuncFile1, ndxFile1, pFuncFile2, ndxFile2,
-									(m_bOutputOptionAddAddress ? OO_ADD_ADDRESS : OO_NONE),
-									&aSymbolMap);
+						queueComparison(FCT_FUNCTIONS, ndxFile1, ndxFile2, nMaxCompResult);
 
-					setCompsWritten.insert(thisFunctionPair);
+						setCompsWritten.insert(thisFunctionPair);
+					}
 				}
-			}
-			if (bFlag) {
-				if (fileComp.is_open()) {
-					fileComp << "================================================================================\n\n\n";
+				if (bFlag) {
+					if (fileComp.is_open()) {
+						ssComp << "================================================================================\n\n\n";
+					}
+					ssCompResult << " : (" << nMaxCompResult*100 << "%)\n";
+					std::cout << ssCompResult.str();
 				}
-				ssCompResult << " : (" << nMaxCompResult*100 << "%)\n";
-				std::cout << ssCompResult.str();
 			}
-		}
 
-		// Output Function comparison of Right->Left : This is needed because some functions
-		//		on left may match multiple functions on the right, but not "optimally".
-		//		This will add the right-side's best matches on the left so that all
-		//		best matches are shown:
-		std::cout << "\nBest Function Matches (Right->Left):\n";
-		if (fileComp.is_open()) {
-			fileComp << "================================================================================\n";
-			fileComp << "                      Best Function Matches (Right->Left):\n";
-			fileComp << "================================================================================\n\n";
-		}
-		for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetFuncCount(); ++ndxFile2) {
-			nMaxCompResult = 0.0;
-			for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < pFuncFile1->GetFuncCount(); ++ndxFile1) nMaxCompResult = std::max(nMaxCompResult, m_matrixFuncCompResult[ndxFile1][ndxFile2]);
-			bFlag = false;
-			ssCompResult.str(std::string());
-			if ((nMaxCompResult > 0.0) && (nMaxCompResult >= nMinCompLimit)) {
-				ssCompResult << "    " << padString(pFuncFile2->GetFunc(ndxFile2).GetMainName(), CFuncObject::GetFieldWidth(CFuncObject::FIELD_CODE::FC_LABEL)) << " : ";
-				for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < pFuncFile1->GetFuncCount(); ++ndxFile1) {
-					if (m_matrixFuncCompResult[ndxFile1][ndxFile2] < nMaxCompResult) continue;
-
-					TFunctionPair thisFunctionPair(pFuncFile1->GetFunc(ndxFile1).GetMainName(),
-														 pFuncFile2->GetFunc(ndxFile2).GetMainName());
-					if (setCompsWritten.contains(thisFunctionPair)) continue;
-
-					if (bFlag) {
-						if (fileComp.is_open()) {
-							fileComp << "\n\n";
-						}
-						ssCompResult << ", ";
-					} else {
-						if (fileComp.is_open()) {
-							fileComp << "================================================================================\n";
+			// Output Function comparison of Right->Left : This is needed because some functions
+			//		on left may match multiple functions on the right, but not "optimally".
+			//		This will add the right-side's best matches on the left so that all
+			//		best matches are shown:
+			std::cout << "\nBest Function Matches (Right->Left):\n";
+			if (fileComp.is_open()) {
+				ssComp << "================================================================================\n";
+				ssComp << "                      Best Function Matches (Right->Left):\n";
+				ssComp << "================================================================================\n\n";
+			}
+			for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetFuncCount(); ++ndxFile2) {
+				auto const arrBestMatches = bestFuncMatches.bestOfCol(ndxFile2);
+				bFlag = false;
+				ssCompResult.str(std::string());
+				if (!arrBestMatches.empty()) {
+					nMaxCompResult = arrBestMatches.front().m_nResult;
+					ssCompResult << "    " << padString(pFuncFile2->GetFunc(ndxFile2).GetMainName(), CFuncObject::GetFieldWidth(CFuncObject::FIELD_CODE::FC_LABEL)) << " : ";
+					for (auto const & aMatch : arrBestMatches) {
+						const CFuncDescArray::size_type ndxFile1 = aMatch.m_nIndex;
+
+						TFunctionPair thisFunctionPair(pFuncFile1->GetFunc(ndxFile1).GetMainName(),
+															 pFuncFile2->GetFunc(ndxFile2).GetMainName());
+						if (setCompsWritten.contains(thisFunctionPair)) continue;
+
+						if (bFlag) {
+							if (fileComp.is_open()) {
+								ssComp << "\n\n";
+							}
+							ssCompResult << ", ";
+						} else {
+							if (fileComp.is_open()) {
+								ssComp << "================================================================================\n";
+							}
 						}
-					}
-					bFlag = true;
+						bFlag = true;
 
-					ssCompResult << pFuncFile1->GetFunc(ndxFile1).GetMainName();
+						ssCompResult << pFuncFile1->GetFunc(ndxFile1).GetMainName();
 
-					dumpComparison(FCT_FUNCTIONS, fileComp, fileOES, bCompOESFlag, m_matrixFuncCompResult,
-									nCompMethod, pFuncFile1, ndxFile1, pFuncFile2, ndxFile2,
-									(m_bOutputOptionAddAddress ? OO_ADD_ADDRESS : OO_NONE),
-									&aSymbolMap);
+						queueComparison(FCT_FUNCTIONS, ndxFile1, ndxFile2, nMaxCompResult);
 
-					setCompsWritten.insert(thisFunctionPair);
+						setCompsWritten.insert(thisFunctionPair);
+					}
 				}
-			}
-			if (bFlag) {
-				if (fileComp.is_open()) {
-					fileComp << "================================================================================\n\n\n";
+				if (bFlag) {
+					if (fileComp.is_open()) {
+						ssComp << "================================================================================\n\n\n";
+					}
+					ssCompResult << " : (" << nMaxCompResult*100 << "%)\n";
+					std::cout << ssCompResult.str();
 				}
-				ssCompResult << " : (" << nMaxCompResult*100 << "%)\n";
-				std::cout << ssCompResult.str();
 			}
-		}
 
-		// --------------------------------------------------------------------
+			// --------------------------------------------------------------------
 
-		std::cout << "\nFunctions in \"" << pFuncFile1->GetFuncPathName() << "\" with No Matches:\n";
+			std::cout << "\nFunctions in \"" << pFuncFile1->GetFuncPathName() << "\" with No Matches:\n";
 
-		bFlag = true;
-		for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < pFuncFile1->GetFuncCount(); ++ndxFile1) {
-			nMaxCompResult = 0.0;
-			for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetFuncCount(); ++ndxFile2) nMaxCompResult = std::max(nMaxCompResult, m_matrixFuncCompResult[ndxFile1][ndxFile2]);
-			if ((nMaxCompResult <= 0.0) || (nMaxCompResult < nMinCompLimit)) {
-				std::cout << "    " << pFuncFile1->GetFunc(ndxFile1).GetMainName() << "\n";
-				bFlag = false;
+			bFlag = true;
+			for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < pFuncFile1->GetFuncCount(); ++ndxFile1) {
+				if (bestFuncMatches.rowMatches(ndxFile1).empty()) {
+					std::cout << "    " << pFuncFile1->GetFunc(ndxFile1).GetMainName() << "\n";
+					bFlag = false;
+				}
 			}
-		}
-		if (bFlag) std::cout << "    <None>\n";
+			if (bFlag) std::cout << "    <None>\n";
 
-		std::cout << "\nFunctions in \"" << pFuncFile2->GetFuncPathName() << "\" with No Matches:\n";
+			std::cout << "\nFunctions in \"" << pFuncFile2->GetFuncPathName() << "\" with No Matches:\n";
 
-		bFlag = true;
-		for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetFuncCount(); ++ndxFile2) {
-			nMaxCompResult = 0.0;
-			for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < pFuncFile1->GetFuncCount(); ++ndxFile1) nMaxCompResult = std::max(nMaxCompResult, m_matrixFuncCompResult[ndxFile1][ndxFile2]);
-			if ((nMaxCompResult <= 0.0) || (nMaxCompResult < nMinCompLimit)) {
-				std::cout << "    " << pFuncFile2->GetFunc(ndxFile2).GetMainName() << "\n";
-				bFlag = false;
+			bFlag = true;
+			for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetFuncCount(); ++ndxFile2) {
+				if (bestFuncMatches.colMatches(ndxFile2).empty()) {
+					std::cout << "    " << pFuncFile2->GetFunc(ndxFile2).GetMainName() << "\n";
+					bFlag = false;
+				}
 			}
-		}
-		if (bFlag) std::cout << "    <None>\n";
+			if (bFlag) std::cout << "    <None>\n";
 
-		// --------------------------------------------------------------------
+			// --------------------------------------------------------------------
 
-		setCompsWritten.clear();
+			setCompsWritten.clear();
 
-		// Output Data Block comparison of Left->Right
-		std::cout << "\nBest Data Block Matches (Left->Right):\n";
-		if (fileComp.is_open()) {
-			fileComp << "================================================================================\n";
-			fileComp << "                     Best Data Block Matches (Left->Right):\n";
-			fileComp << "================================================================================\n\n";
-		}
-		for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < pFuncFile1->GetDataBlockCount(); ++ndxFile1) {
-			nMaxCompResult = 0.0;
-			for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetDataBlockCount(); ++ndxFile2) nMaxCompResult = std::max(nMaxCompResult, m_matrixDataCompResult[ndxFile1][ndxFile2]);
-			bFlag = false;
-			ssCompResult.str(std::string());
-			if ((nMaxCompResult > 0.0) && (nMaxCompResult >= nMinCompLimit)) {
-				ssCompResult << "    " << padString(pFuncFile1->GetDataBlock(ndxFile1).GetMainName(), CFuncObject::GetFieldWidth(CFuncObject::FIELD_CODE::FC_LABEL)) << " : ";
-				for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetDataBlockCount(); ++ndxFile2) {
-					if (m_matrixDataCompResult[ndxFile1][ndxFile2] < nMaxCompResult) continue;
-
-					TFunctionPair thisFunctionPair(pFuncFile1->GetDataBlock(ndxFile1).GetMainName(),
-														 pFuncFile2->GetDataBlock(ndxFile2).GetMainName());
-					if (setCompsWritten.contains(thisFunctionPair)) continue;
-
-					if (bFlag) {
-						if (fileComp.is_open()) {
-							fileComp << "\n\n";
-						}
-						ssCompResult << ", ";
-					} else {
-						if (fileComp.is_open()) {
-							fileComp << "================================================================================\n";
+			// Output Data Block comparison of Left->Right
+			std::cout << "\nBest Data Block Matches (Left->Right):\n";
+			if (fileComp.is_open()) {
+				ssComp << "================================================================================\n";
+				ssComp << "                     Best Data Block Matches (Left->Right):\n";
+				ssComp << "================================================================================\n\n";
+			}
+			for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < pFuncFile1->GetDataBlockCount(); ++ndxFile1) {
+				auto const arrBestMatches = bestDataMatches.bestOfRow(ndxFile1);
+				bFlag = false;
+				ssCompResult.str(std::string());
+				if (!arrBestMatches.empty()) {
+					nMaxCompResult = arrBestMatches.front().m_nResult;
+					ssCompResult << "    " << padString(pFuncFile1->GetDataBlock(ndxFile1).GetMainName(), CFuncObject::GetFieldWidth(CFuncObject::FIELD_CODE::FC_LABEL)) << " : ";
+					for (auto const & aMatch : arrBestMatches) {
+						const CFuncDescArray::size_type ndxFile2 = aMatch.m_nIndex;
+
+						TFunctionPair thisFunctionPair(pFuncFile1->GetDataBlock(ndxFile1).GetMainName(),
+															 pFuncFile2->GetDataBlock(ndxFile2).GetMainName());
+						if (setCompsWritten.contains(thisFunctionPair)) continue;
+
+						if (bFlag) {
+							if (fileComp.is_open()) {
+								ssComp << "\n\n";
+							}
+							ssCompResult << ", ";
+						} else {
+							if (fileComp.is_open()) {
+								ssComp << "================================================================================\n";
+							}
 						}
-					}
-					bFlag = true;
+						bFlag = true;
 
-					ssCompResult << pFuncFile2->GetDataBlock(ndxFile2).GetMainName();
+						ssCompResult << pFuncFile2->GetDataBlock(ndxFile2).GetMainName();
 
-					dumpComparison(FCT_DATABLOCKS, fileComp, fileOES, bCompOESFlag, m_matrixDataCompResult,
-									nCompMethod, pFuncFile1, ndxFile1, pFuncFile2, ndxFile2,
-									(m_bOutputOptionAddAddress ? OO_ADD_ADDRESS : OO_NONE),
-									&aSymbolMap);
+						queueComparison(FCT_DATABLOCKS, ndxFile1, ndxFile2, nMaxCompResult);
 
-					setCompsWritten.insert(thisFunctionPair);
+						setCompsWritten.insert(thisFunctionPair);
+					}
 				}
-			}
-			if (bFlag) {
-				if (fileComp.is_open()) {
-					fileComp << "================================================================================\n\n\n";
+				if (bFlag) {
+					if (fileComp.is_open()) {
+						ssComp << "================================================================================\n\n\n";
+					}
+					ssCompResult << " : (" << nMaxCompResult*100 << "%)\n";
+					std::cout << ssCompResult.str();
 				}
-				ssCompResult << " : (" << nMaxCompResult*100 << "%)\n";
-				std::cout << ssCompResult.str();
 			}
-		}
 
-		// Output Data Block comparison of Right->Left : This is needed because some functions
-		//		on left may match multiple functions on the right, but not "optimally".
-		//		This will add the right-side's best matches on the left so that all
-		//		best matches are shown:
-		std::cout << "\nBest Data Block Matches (Right->Left):\n";
-		if (fileComp.is_open()) {
-			fileComp << "================================================================================\n";
-			fileComp << "                     Best Data Block Matches (Right->Left):\n";
-			fileComp << "================================================================================\n\n";
-		}
-		for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetDataBlockCount(); ++ndxFile2) {
-			nMaxCompResult = 0.0;
-			for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < pFuncFile1->GetDataBlockCount(); ++ndxFile1) nMaxCompResult = std::max(nMaxCompResult, m_matrixDataCompResult[ndxFile1][ndxFile2]);
-			bFlag = false;
-			ssCompResult.str(std::string());
-			if ((nMaxCompResult > 0.0) && (nMaxCompResult >= nMinCompLimit)) {
-				ssCompResult << "    " << padString(pFuncFile2->GetDataBlock(ndxFile2).GetMainName(), CFuncObject::GetFieldWidth(CFuncObject::FIELD_CODE::FC_LABEL)) << " : ";
-				for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < pFuncFile1->GetDataBlockCount(); ++ndxFile1) {
-					if (m_matrixDataCompResult[ndxFile1][ndxFile2] < nMaxCompResult) continue;
-
-					TFunctionPair thisFunctionPair(pFuncFile1->GetDataBlock(ndxFile1).GetMainName(),
-														 pFuncFile2->GetDataBlock(ndxFile2).GetMainName());
-					if (setCompsWritten.contains(thisFunctionPair)) continue;
-
-					if (bFlag) {
-						if (fileComp.is_open()) {
-							fileComp << "\n\n";
-						}
-						ssCompResult << ", ";
-					} else {
-						if (fileComp.is_open()) {
-							fileComp << "================================================================================\n";
+			// Output Data Block comparison of Right->Left : This is needed because some functions
+			//		on left may match multiple functions on the right, but not "optimally".
+			//		This will add the right-side's best matches on the left so that all
+			//		best matches are shown:
+			std::cout << "\nBest Data Block Matches (Right->Left):\n";
+			if (fileComp.is_open()) {
+				ssComp << "================================================================================\n";
+				ssComp << "                     Best Data Block Matches (Right->Left):\n";
+				ssComp << "================================================================================\n\n";
+			}
+			for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetDataBlockCount(); ++ndxFile2) {
+				auto const arrBestMatches = bestDataMatches.bestOfCol(ndxFile2);
+				bFlag = false;
+				ssCompResult.str(std::string());
+				if (!arrBestMatches.empty()) {
+					nMaxCompResult = arrBestMatches.front().m_nResult;
+					ssCompResult << "    " << padString(pFuncFile2->GetDataBlock(ndxFile2).GetMainName(), CFuncObject::GetFieldWidth(CFuncObject::FIELD_CODE::FC_LABEL)) << " : ";
+					for (auto const & aMatch : arrBestMatches) {
+						const CFuncDescArray::size_type ndxFile1 = aMatch.m_nIndex;
+
+						TFunctionPair thisFunctionPair(pFuncFile1->GetDataBlock(ndxFile1).GetMainName(),
+															 pFuncFile2->GetDataBlock(ndxFile2).GetMainName());
+						if (setCompsWritten.contains(thisFunctionPair)) continue;
+
+						if (bFlag) {
+							if (fileComp.is_open()) {
+								ssComp << "\n\n";
+							}
+							ssCompResult << ", ";
+						} else {
+							if (fileComp.is_open()) {
+								ssComp << "================================================================================\n";
+							}
 						}
-					}
-					bFlag = true;
+						bFlag = true;
 
-					ssCompResult << pFuncFile1->GetDataBlock(ndxFile1).GetMainName();
+						ssCompResult << pFuncFile1->GetDataBlock(ndxFile1).GetMainName();
 
-					dumpComparison(FCT_DATABLOCKS, fileComp, fileOES, bCompOESFlag, m_matrixDataCompResult,
-									nCompMethod, pFuncFile1, ndxFile1, pFuncFile2, ndxFile2,
-									(m_bOutputOptionAddAddress ? OO_ADD_ADDRESS : OO_NONE),
-									&aSymbolMap);
+						queueComparison(FCT_DATABLOCKS, ndxFile1, ndxFile2, nMaxCompResult);
 
-					setCompsWritten.insert(thisFunctionPair);
+						setCompsWritten.insert(thisFunctionPair);
+					}
 				}
-			}
-			if (bFlag) {
-				if (fileComp.is_open()) {
-					fileComp << "================================================================================\n\n\n";
+				if (bFlag) {
+					if (fileComp.is_open()) {
+						ssComp << "================================================================================\n\n\n";
+					}
+					ssCompResult << " : (" << nMaxCompResult*100 << "%)\n";
+					std::cout << ssCompResult.str();
 				}
-				ssCompResult << " : (" << nMaxCompResult*100 << "%)\n";
-				std::cout << ssCompResult.str();
 			}
-		}
 
-		// --------------------------------------------------------------------
+			// --------------------------------------------------------------------
 
-		std::cout << "\nData Blocks in \"" << pFuncFile1->GetFuncPathName() << "\" with No Matches:\n";
+			std::cout << "\nData Blocks in \"" << pFuncFile1->GetFuncPathName() << "\" with No Matches:\n";
 
-		bFlag = true;
-		for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < pFuncFile1->GetDataBlockCount(); ++ndxFile1) {
-			nMaxCompResult = 0.0;
-			for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetDataBlockCount(); ++ndxFile2) nMaxCompResult = std::max(nMaxCompResult, m_matrixDataCompResult[ndxFile1][ndxFile2]);
-			if ((nMaxCompResult <= 0.0) || (nMaxCompResult < nMinCompLimit)) {
-				std::cout << "    " << pFuncFile1->GetDataBlock(ndxFile1).GetMainName() << "\n";
-				bFlag = false;
+			bFlag = true;
+			for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < pFuncFile1->GetDataBlockCount(); ++ndxFile1) {
+				if (bestDataMatches.rowMatches(ndxFile1).empty()) {
+					std::cout << "    " << pFuncFile1->GetDataBlock(ndxFile1).GetMainName() << "\n";
+					bFlag = false;
+				}
 			}
-		}
-		if (bFlag) std::cout << "    <None>\n";
+			if (bFlag) std::cout << "    <None>\n";
 
-		std::cout << "\nData Blocks in \"" << pFuncFile2->GetFuncPathName() << "\" with No Matches:\n";
+			std::cout << "\nData Blocks in \"" << pFuncFile2->GetFuncPathName() << "\" with No Matches:\n";
 
-		bFlag = true;
-		for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetDataBlockCount(); ++ndxFile2) {
-			nMaxCompResult = 0.0;
-			for (CFuncDescArray::size_type ndxFile1 = 0; ndxFile1 < pFuncFile1->GetDataBlockCount(); ++ndxFile1) nMaxCompResult = std::max(nMaxCompResult, m_matrixDataCompResult[ndxFile1][ndxFile2]);
-			if ((nMaxCompResult <= 0.0) || (nMaxCompResult < nMinCompLimit)) {
-				std::cout << "    " << pFuncFile2->GetDataBlock(ndxFile2).GetMainName() << "\n";
-				bFlag = false;
+			bFlag = true;
+			for (CFuncDescArray::size_type ndxFile2 = 0; ndxFile2 < pFuncFile2->GetDataBlockCount(); ++ndxFile2) {
+				if (bestDataMatches.colMatches(ndxFile2).empty()) {
+					std::cout << "    " << pFuncFile2->GetDataBlock(ndxFile2).GetMainName() << "\n";
+					bFlag = false;
+				}
 			}
-		}
-		if (bFlag) std::cout << "    <None>\n";
+			if (bFlag) std::cout << "    <None>\n";
+
+			// --------------------------------------------------------------------
+
+			// Run the queued comparisons and output them in their original order:
+			{
+				CPerfStats::CPhase phase("ComparisonOutput");
+				runParallel(arrComparisonJobs.size(), bSingleThreaded, "Comparison Output", [&](std::size_t ndxJob)->void {
+					dumpComparison(arrComparisonJobs[ndxJob], fileComp.is_open(), fileOES.is_open(), bCompOESFlag,
+									nCompMethod, pFuncFile1, pFuncFile2,
+									(m_bOutputOptionAddAddress ? OO_ADD_ADDRESS : OO_NONE));
+				});
+
+				for (auto const & aJob : arrComparisonJobs) {
+					if (fileComp.is_open()) {
+						fileComp << aJob.m_strCompPrefix << aJob.m_strComp;
+					}
+					if (fileOES.is_open()) {
+						fileOES << aJob.m_strOES;
+					}
+					aSymbolMap.Merge(aJob.m_SymbolMap);
+				}
+				if (fileComp.is_open()) {
+					fileComp << ssComp.str();
+				}
+				arrComparisonJobs.clear();
+			}
+
+			// --------------------------------------------------------------------
 
-		// --------------------------------------------------------------------
+			std::cout << "\nCross-Comparing Symbol Tables...\n";
+			CPerfStats::CPhase phase("SymbolOutput");
 
-		std::cout << "\nCross-Comparing Symbol Tables...\n";
+			dumpSymbols(fileSym, aSymbolMap, CSymbolMap::GetLeftSideCodeSymbolList, CSymbolMap::GetLeftSideCodeHitList,
+						"\nLeft-Side Code Symbol Matches:\n"
+						"------------------------------\n");
 
-		dumpSymbols(fileSym, aSymbolMap, CSymbolMap::GetLeftSideCodeSymbolList, CSymbolMap::GetLeftSideCodeHitList,
-					"\nLeft-Side Code Symbol Matches:\n"
-					"------------------------------\n");
+			dumpSymbols(fileSym, aSymbolMap, CSymbolMap::GetLeftSideDataSymbolList, CSymbolMap::GetLeftSideDataHitList,
+						"\nLeft-Side Data Symbol Matches:\n"
+						"------------------------------\n");
 
-		dumpSymbols(fileSym, aSymbolMap, CSymbolMap::GetLeftSideDataSymbolList, CSymbolMap::GetLeftSideDataHitList,
-					"\nLeft-Side Data Symbol Matches:\n"
-					"------------------------------\n");
+			dumpSymbols(fileSym, aSymbolMap, CSymbolMap::GetRightSideCodeSymbolList, CSymbolMap::GetRightSideCodeHitList,
+						"\nRight-Side Code Symbol Matches:\n"
+						"-------------------------------\n");
 
-		dumpSymbols(fileSym, aSymbolMap, CSymbolMap::GetRightSideCodeSymbolList, CSymbolMap::GetRightSideCodeHitList,
-					"\nRight-Side Code Symbol Matches:\n"
-					"-------------------------------\n");
+			dumpSymbols(fileSym, aSymbolMap, CSymbolMap::GetRightSideDataSymbolList, CSymbolMap::GetRightSideDataHitList,
+						"\nRight-Side Data Symbol Matches:\n"
+						"-------------------------------\n");
+		}
 
-		dumpSymbols(fileSym, aSymbolMap, CSymbolMap::GetRightSideDataSymbolList, CSymbolMap::GetRightSideDataHitList,
-					"\nRight-Side Data Symbol Matches:\n"
-					"-------------------------------\n");
+		if (fileLineage.is_open()) {
+			std::cout << "\nTracing Function Lineage...\n";
+			CPerfStats::CPhase phase("LineageOutput");
+			dumpLineage(fileLineage, m_arrFuncFiles, arrComparePairs);
+		}
 	}
 
 	printf("\nFunction Analysis Complete...\n\n");
 
 	if (fileMatrixOut.is_open()) fileMatrixOut.close();
+	if (fileMatrixBinOut.is_open()) {
+		fileMatrixBinOut.close();
+		m_matrixFuncCompResult.resize(0, 0, false);		// Release any mapping of the file being replaced
+		std::error_code ec;
+		std::filesystem::rename(strMatrixBinTempFilename, m_strMatrixBinOutFilename, ec);
+		if (ec) {
+			std::cerr << "*** Error: Replacing Binary Matrix Output File \"" << m_strMatrixBinOutFilename << "\" : " << ec.message() << "\n";
+			return -5;
+		}
+	}
 	if (fileDFRO.is_open()) fileDFRO.close();
 	if (fileComp.is_open()) fileComp.close();
 	if (fileOES.is_open()) fileOES.close();
 	if (fileSym.is_open()) fileSym.close();
+	if (fileLineage.is_open()) fileLineage.close();
 
 	return 0;
 }
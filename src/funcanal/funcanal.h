@@ -7,6 +7,6 @@
 #ifndef FUZZY_FUNC_ANAL_H
 #define FUZZY_FUNC_ANAL_H
 
-
+#include <threadhelp.h>
 
 #endif	// FUZZY_FUNC_ANAL_H
@@ -29,12 +29,14 @@
 #include "funcdesc.h"
 #include <errmsgs.h>
 #include <stringhelp.h>
+#include <perfstats.h>
 
 #include <math.h>
 #include <limits.h>
 #include <float.h>
 #include <algorithm>
 #include <iterator>
+#include <limits>
 #include <sstream>
 #include <utility>
 
@@ -42,59 +44,430 @@
 
 #define DEBUG_OES_SCRIPT 0			// Set to '1' (or non-zero) to debug OES generation code
 
-static CStringArray g_EditScript;
-static bool g_bEditScriptValid = false;
+// ============================================================================
 
+//////////////////////////////////////////////////////////////////////
+// CAlignmentWorkspace Class
+//////////////////////////////////////////////////////////////////////
+//		Scratch storage for the CompareFunctions alignment kernels.
+//		One workspace exists per thread and is reused for every
+//		comparison on that thread.  Its buffers only ever grow, so
+//		after the first few comparisons no further allocations occur.
+//
+//		XDROP only ever references the current and previous
+//		antidiagonals, so it keeps just those two (indexed by 'i'),
+//		tracking the written span of each so that recycling a diagonal
+//		only resets what was used.
+//
+//		XDROP_VECTOR keeps the last three whole-cell antidiagonals
+//		(indexed by 'I+1', so that 'I-1' is always in range) plus the
+//		symbols of both functions split into one array per symbol
+//		slot, with the second function's reversed, so that walking an
+//		antidiagonal reads every array contiguously.  It has two sets
+//		of these, one with int16_t lanes, for functions short enough
+//		that every score fits, and one with int32_t lanes for the rest.
+//		The symbols are CDiffSymbolPool indices, so for the int16_t lanes
+//		they're narrowed to uint16_t, as long as the pool is small enough
+//		that they all fit.
+//
+//		GREEDY only ever writes the band of 'k' values from L-1 to U+1
+//		on any 'd' row, so each row stores just its band, and any 'k'
+//		outside of it reads as -∞ (-2).  The edit script traceback needs
+//		the rows in reverse order, so they are all kept, as long as they
+//		total no more than GREEDY_MAX_ROW_CELLS.  Otherwise, the rows are
+//		recomputed as the traceback needs them, keeping its memory
+//		linear in the size of the functions (see CompareFunctions).
+class CAlignmentWorkspace
+{
+public:
+	// ---- XDROP:
+	void initXDrop(int nDiagSize)
+	{
+		for (int nDiag = 0; nDiag < 2; ++nDiag) {
+			m_arrXDropDiag[nDiag].assign(nDiagSize, -DBL_MAX);
+			m_nXDropLo[nDiag] = 0;
+			m_nXDropHi[nDiag] = -1;
+		}
+	}
+
+	// Returns antidiagonal 'k' (which must be even), resetting the
+	//	older diagonal it recycles, and marks [nLo, nHi] as written:
+	double *beginXDropDiag(int k, int nLo, int nHi)
+	{
+		int nDiag = (k/2) & 1;
+		std::vector<double> &arrDiag = m_arrXDropDiag[nDiag];
+		for (int i = m_nXDropLo[nDiag]; i <= m_nXDropHi[nDiag]; ++i) arrDiag[i] = -DBL_MAX;
+		m_nXDropLo[nDiag] = nLo;
+		m_nXDropHi[nDiag] = nHi;
+		return arrDiag.data();
+	}
+
+	double *xdropDiag(int k) { return m_arrXDropDiag[(k/2) & 1].data(); }
+	int xdropDiagLo(int k) const { return m_nXDropLo[(k/2) & 1]; }
+	int xdropDiagHi(int k) const { return m_nXDropHi[(k/2) & 1]; }
+
+	// ---- XDROP_VECTOR:
+	template<typename TScore, typename TSymbol>
+	struct TXDropVectorLanes {
+		std::vector<TScore> m_arrDiag[3];
+		std::vector<TSymbol> m_arrA[NUM_DIFF_SYMBOL_SLOTS];
+		std::vector<TSymbol> m_arrB[NUM_DIFF_SYMBOL_SLOTS];		// Reversed
+
+		void init(std::size_t M, std::size_t N)
+		{
+			for (int nDiag = 0; nDiag < 3; ++nDiag) {
+				if (m_arrDiag[nDiag].size() < (M+2)) m_arrDiag[nDiag].resize(M+2);
+			}
+			for (int nSlot = 0; nSlot < NUM_DIFF_SYMBOL_SLOTS; ++nSlot) {
+				m_arrA[nSlot].resize(M);
+				m_arrB[nSlot].resize(N);
+			}
+		}
+
+		TScore *diag(int d) { return m_arrDiag[d % 3].data(); }
+	};
+
+	typedef TXDropVectorLanes<int32_t, TDiffSymbol> CXDropVectorLanes32;
+	typedef TXDropVectorLanes<int16_t, uint16_t> CXDropVectorLanes16;
+
+	CXDropVectorLanes32 &initXDropVector32(const CDiffSymbolArray &zFunc1, const CDiffSymbolArray &zFunc2)
+	{
+		const std::size_t M = zFunc1.size() / NUM_DIFF_SYMBOL_SLOTS;
+		const std::size_t N = zFunc2.size() / NUM_DIFF_SYMBOL_SLOTS;
+		m_aXDropVector32.init(M, N);
+		for (int nSlot = 0; nSlot < NUM_DIFF_SYMBOL_SLOTS; ++nSlot) {
+			for (std::size_t ndx = 0; ndx < M; ++ndx) m_aXDropVector32.m_arrA[nSlot][ndx] = zFunc1[(ndx*NUM_DIFF_SYMBOL_SLOTS) + nSlot];
+			for (std::size_t ndx = 0; ndx < N; ++ndx) m_aXDropVector32.m_arrB[nSlot][N-1-ndx] = zFunc2[(ndx*NUM_DIFF_SYMBOL_SLOTS) + nSlot];
+		}
+		return m_aXDropVector32;
+	}
+
+	// Returns nullptr if any symbol doesn't fit in a uint16_t:
+	CXDropVectorLanes16 *initXDropVector16(const CDiffSymbolArray &zFunc1, const CDiffSymbolArray &zFunc2)
+	{
+		const std::size_t M = zFunc1.size() / NUM_DIFF_SYMBOL_SLOTS;
+		const std::size_t N = zFunc2.size() / NUM_DIFF_SYMBOL_SLOTS;
+		if (std::max(*std::max_element(zFunc1.cbegin(), zFunc1.cend()), *std::max_element(zFunc2.cbegin(), zFunc2.cend())) > UINT16_MAX) return nullptr;
+		m_aXDropVector16.init(M, N);
+		for (int nSlot = 0; nSlot < NUM_DIFF_SYMBOL_SLOTS; ++nSlot) {
+			for (std::size_t ndx = 0; ndx < M; ++ndx) m_aXDropVector16.m_arrA[nSlot][ndx] = static_cast<uint16_t>(zFunc1[(ndx*NUM_DIFF_SYMBOL_SLOTS) + nSlot]);
+			for (std::size_t ndx = 0; ndx < N; ++ndx) m_aXDropVector16.m_arrB[nSlot][N-1-ndx] = static_cast<uint16_t>(zFunc2[(ndx*NUM_DIFF_SYMBOL_SLOTS) + nSlot]);
+		}
+		return &m_aXDropVector16;
+	}
+
+	// ---- GREEDY:
+	static constexpr std::size_t GREEDY_MAX_ROW_CELLS = 0x100000;	// Most 'R' entries kept for a traceback (4MB)
+
+	struct TGreedyRow {
+		int m_kLo = 0;				// First 'k' in the band
+		int m_kHi = -1;				// Last 'k' in the band
+		int m_nVisitMin = 0;		// Minimum k-index visited (for speed)
+		int m_nVisitMax = -1;		// Maximum k-index visited (for speed)
+		int m_L = 0;				// L of the next row, whose band is L-1 to U+1
+		int m_U = -1;				// U of the next row
+		std::vector<int> m_arrR;
+
+		void init(int kLo, int kHi)
+		{
+			assert(kLo <= kHi);
+			m_kLo = kLo;
+			m_kHi = kHi;
+			m_arrR.assign(kHi - kLo + 1, -2);
+		}
+
+		std::size_t size() const { return m_arrR.size(); }
+
+		int R(int k) const
+		{
+			if ((k < m_kLo) || (k > m_kHi)) return -2;
+			return m_arrR[k - m_kLo];
+		}
+
+		int &ref(int k)
+		{
+			assert((k >= m_kLo) && (k <= m_kHi));
+			return m_arrR[k - m_kLo];
+		}
+	};
+
+	void initGreedy(int dmax)
+	{
+		m_arrGreedyT.assign(dmax, 0);
+	}
+
+	// Row storage slot 'n', whose buffer is reused from any earlier rows:
+	TGreedyRow &greedyRow(std::size_t nSlot)
+	{
+		if (nSlot >= m_arrGreedyRows.size()) m_arrGreedyRows.resize(nSlot+1);
+		return m_arrGreedyRows[nSlot];
+	}
+
+	double *greedyT() { return m_arrGreedyT.data(); }
 
-double CompareFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC_COMPARE_METHOD nMethod,
+	static CAlignmentWorkspace &threadInstance()
+	{
+		thread_local CAlignmentWorkspace theWorkspace;
+		return theWorkspace;
+	}
+
+private:
+	std::vector<double> m_arrXDropDiag[2];
+	int m_nXDropLo[2] = { 0, 0 };
+	int m_nXDropHi[2] = { -1, -1 };
+
+	CXDropVectorLanes32 m_aXDropVector32;
+	CXDropVectorLanes16 m_aXDropVector16;
+
+	std::vector<TGreedyRow> m_arrGreedyRows;
+	std::vector<double> m_arrGreedyT;
+};
+
+// ============================================================================
+
+//	The XDROP_VECTOR kernel for a run of antidiagonal cells (see
+//	CompareFunctions).  The generic version is plain scalar code, used
+//	for the int32_t lanes and for whatever's left over after the SIMD
+//	version of the int16_t lanes, which is chosen at compile-time from
+//	whatever the target has (AVX2 at 16 lanes, SSE2 or AArch64 NEON at
+//	8 lanes).  Scores never get anywhere near the limits of their lanes,
+//	so none of the arithmetic needs to saturate:
+
+static constexpr int32_t XDROP_VECTOR_MAT = 2;
+static constexpr int32_t XDROP_VECTOR_MIS = -2;
+static constexpr int32_t XDROP_VECTOR_IND = -3;
+
+// Scores are between IND*(M+N) and MAT*min(M,N), so the int16_t lanes
+//	are used for anything up to this many cells for M+N:
+static constexpr int XDROP_VECTOR_MAX_INT16_SIZE = (INT16_MAX / -XDROP_VECTOR_IND) - 1;
+
+#if defined(__AVX2__)
+#define XDROP_VECTOR_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define XDROP_VECTOR_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define XDROP_VECTOR_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Computes H[I+1] for I in [nFirst, nLast], returning the greater of
+//	nDiagMax and their maximum:
+template<typename TScore, typename TSymbol>
+static TScore xdropVectorCells(TScore *H, const TScore *H1, const TScore *H2,
+								const TSymbol * const a[NUM_DIFF_SYMBOL_SLOTS], const TSymbol * const pB[NUM_DIFF_SYMBOL_SLOTS],
+								int nFirst, int nLast, TScore nDiagMax)
+{
+	static_assert(NUM_DIFF_SYMBOL_SLOTS == 3, "Vectorized X-Drop kernel is written for three symbol slots");
+	for (int I = nFirst; I <= nLast; ++I) {
+		// a(I) is a[I-1] and b(J) is pB[I] (both are 1-based):
+		const bool bMatch = ((a[0][I-1] == pB[0][I]) | (a[1][I-1] == pB[1][I]) | (a[2][I-1] == pB[2][I]));
+		const TScore nDiag = H2[I] + (bMatch ? XDROP_VECTOR_MAT : XDROP_VECTOR_MIS);		// H(I-1, J-1)
+		const TScore nIndel = std::max(H1[I+1], H1[I]) + XDROP_VECTOR_IND;				// H(I, J-1) and H(I-1, J)
+		const TScore nScore = std::max(nDiag, nIndel);
+		H[I+1] = nScore;
+		nDiagMax = std::max(nDiagMax, nScore);
+	}
+	return nDiagMax;
+}
+
+#if defined(XDROP_VECTOR_AVX2) || defined(XDROP_VECTOR_SSE2) || defined(XDROP_VECTOR_NEON)
+
+static int16_t xdropVectorCells(int16_t *H, const int16_t *H1, const int16_t *H2,
+								const uint16_t * const a[NUM_DIFF_SYMBOL_SLOTS], const uint16_t * const pB[NUM_DIFF_SYMBOL_SLOTS],
+								int nFirst, int nLast, int16_t nDiagMax)
+{
+	int I = nFirst;
+
+#if defined(XDROP_VECTOR_AVX2)
+	constexpr int nLanes = 16;
+	auto &&fnLoad = [](const void *p)->__m256i { return _mm256_loadu_si256(static_cast<const __m256i *>(p)); };
+	const __m256i vMat = _mm256_set1_epi16(XDROP_VECTOR_MAT);
+	const __m256i vMis = _mm256_set1_epi16(XDROP_VECTOR_MIS);
+	const __m256i vInd = _mm256_set1_epi16(XDROP_VECTOR_IND);
+	__m256i vDiagMax = _mm256_set1_epi16(nDiagMax);
+	for ( ; (I + nLanes - 1) <= nLast; I += nLanes) {
+		__m256i vMatch = _mm256_cmpeq_epi16(fnLoad(a[0] + I-1), fnLoad(pB[0] + I));
+		vMatch = _mm256_or_si256(vMatch, _mm256_cmpeq_epi16(fnLoad(a[1] + I-1), fnLoad(pB[1] + I)));
+		vMatch = _mm256_or_si256(vMatch, _mm256_cmpeq_epi16(fnLoad(a[2] + I-1), fnLoad(pB[2] + I)));
+		const __m256i vDiag = _mm256_add_epi16(fnLoad(H2 + I), _mm256_blendv_epi8(vMis, vMat, vMatch));
+		const __m256i vIndel = _mm256_add_epi16(_mm256_max_epi16(fnLoad(H1 + I+1), fnLoad(H1 + I)), vInd);
+		const __m256i vScore = _mm256_max_epi16(vDiag, vIndel);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(H + I+1), vScore);
+		vDiagMax = _mm256_max_epi16(vDiagMax, vScore);
+	}
+	__m128i vMax = _mm_max_epi16(_mm256_castsi256_si128(vDiagMax), _mm256_extracti128_si256(vDiagMax, 1));
+	vMax = _mm_max_epi16(vMax, _mm_srli_si128(vMax, 8));
+	vMax = _mm_max_epi16(vMax, _mm_srli_si128(vMax, 4));
+	vMax = _mm_max_epi16(vMax, _mm_srli_si128(vMax, 2));
+	nDiagMax = static_cast<int16_t>(_mm_extract_epi16(vMax, 0));
+#elif defined(XDROP_VECTOR_SSE2)
+	constexpr int nLanes = 8;
+	auto &&fnLoad = [](const void *p)->__m128i { return _mm_loadu_si128(static_cast<const __m128i *>(p)); };
+	const __m128i vMat = _mm_set1_epi16(XDROP_VECTOR_MAT);
+	const __m128i vMis = _mm_set1_epi16(XDROP_VECTOR_MIS);
+	const __m128i vInd = _mm_set1_epi16(XDROP_VECTOR_IND);
+	__m128i vDiagMax = _mm_set1_epi16(nDiagMax);
+	for ( ; (I + nLanes - 1) <= nLast; I += nLanes) {
+		__m128i vMatch = _mm_cmpeq_epi16(fnLoad(a[0] + I-1), fnLoad(pB[0] + I));
+		vMatch = _mm_or_si128(vMatch, _mm_cmpeq_epi16(fnLoad(a[1] + I-1), fnLoad(pB[1] + I)));
+		vMatch = _mm_or_si128(vMatch, _mm_cmpeq_epi16(fnLoad(a[2] + I-1), fnLoad(pB[2] + I)));
+		const __m128i vDiag = _mm_add_epi16(fnLoad(H2 + I), _mm_or_si128(_mm_and_si128(vMatch, vMat), _mm_andnot_si128(vMatch, vMis)));
+		const __m128i vIndel = _mm_add_epi16(_mm_max_epi16(fnLoad(H1 + I+1), fnLoad(H1 + I)), vInd);
+		const __m128i vScore = _mm_max_epi16(vDiag, vIndel);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(H + I+1), vScore);
+		vDiagMax = _mm_max_epi16(vDiagMax, vScore);
+	}
+	vDiagMax = _mm_max_epi16(vDiagMax, _mm_srli_si128(vDiagMax, 8));
+	vDiagMax = _mm_max_epi16(vDiagMax, _mm_srli_si128(vDiagMax, 4));
+	vDiagMax = _mm_max_epi16(vDiagMax, _mm_srli_si128(vDiagMax, 2));
+	nDiagMax = static_cast<int16_t>(_mm_extract_epi16(vDiagMax, 0));
+#elif defined(XDROP_VECTOR_NEON)
+	constexpr int nLanes = 8;
+	const int16x8_t vMat = vdupq_n_s16(XDROP_VECTOR_MAT);
+	const int16x8_t vMis = vdupq_n_s16(XDROP_VECTOR_MIS);
+	const int16x8_t vInd = vdupq_n_s16(XDROP_VECTOR_IND);
+	int16x8_t vDiagMax = vdupq_n_s16(nDiagMax);
+	for ( ; (I + nLanes - 1) <= nLast; I += nLanes) {
+		uint16x8_t vMatch = vceqq_u16(vld1q_u16(a[0] + I-1), vld1q_u16(pB[0] + I));
+		vMatch = vorrq_u16(vMatch, vceqq_u16(vld1q_u16(a[1] + I-1), vld1q_u16(pB[1] + I)));
+		vMatch = vorrq_u16(vMatch, vceqq_u16(vld1q_u16(a[2] + I-1), vld1q_u16(pB[2] + I)));
+		const int16x8_t vDiag = vaddq_s16(vld1q_s16(H2 + I), vbslq_s16(vMatch, vMat, vMis));
+		const int16x8_t vIndel = vaddq_s16(vmaxq_s16(vld1q_s16(H1 + I+1), vld1q_s16(H1 + I)), vInd);
+		const int16x8_t vScore = vmaxq_s16(vDiag, vIndel);
+		vst1q_s16(H + I+1, vScore);
+		vDiagMax = vmaxq_s16(vDiagMax, vScore);
+	}
+	nDiagMax = vmaxvq_s16(vDiagMax);
+#endif
+
+	return xdropVectorCells<int16_t, uint16_t>(H, H1, H2, a, pB, I, nLast, nDiagMax);
+}
+
+#endif
+
+// Runs the XDROP_VECTOR kernel over the whole M x N grid, returning
+//	false if fnStop(d, Tp, nDiagMax, nPrevDiagMax) stopped it early
+//	after antidiagonal 'd', otherwise setting Tp to its final score:
+template<typename TScore, typename TSymbol, typename TStopFn>
+static bool xdropVectorScore(CAlignmentWorkspace::TXDropVectorLanes<TScore, TSymbol> &aLanes,
+								int M, int N, TStopFn &&fnStop, int32_t &Tp)
+{
+	const TSymbol * const a[NUM_DIFF_SYMBOL_SLOTS] = { aLanes.m_arrA[0].data(), aLanes.m_arrA[1].data(), aLanes.m_arrA[2].data() };
+	const TSymbol * const b[NUM_DIFF_SYMBOL_SLOTS] = { aLanes.m_arrB[0].data(), aLanes.m_arrB[1].data(), aLanes.m_arrB[2].data() };
+
+	// Antidiagonal d is stored at [I+1] for I in [max(0, d-N), min(M, d)].
+	//	Only the edge cells below have a predecessor outside of the grid,
+	//	so everything read within the loop is always a computed cell:
+	TScore *H = aLanes.diag(0);
+	H[1] = 0;
+	Tp = 0;
+	int32_t nPrevDiagMax = 0;		// Max H of antidiagonal d-1
+
+	for (int d = 1; d <= (M+N); ++d) {
+		const int nLo = std::max(0, d-N);
+		const int nHi = std::min(M, d);
+		const TScore * const H1 = aLanes.diag(d-1);
+		const TScore * const H2 = aLanes.diag(d-2+3);
+		H = aLanes.diag(d);
+
+		// I = 0 and J = 0 have only one predecessor each and no
+		//	symbols to compare, so they're done outside of the loop:
+		int nFirst = nLo;
+		int nLast = nHi;
+		TScore nDiagMax = std::numeric_limits<TScore>::min();
+		if (nFirst == 0) {
+			H[1] = H1[1] + XDROP_VECTOR_IND;			// H(0, d) from H(0, d-1)
+			nDiagMax = std::max(nDiagMax, H[1]);
+			++nFirst;
+		}
+		if (nLast == d) {
+			H[d+1] = H1[d] + XDROP_VECTOR_IND;		// H(d, 0) from H(d-1, 0)
+			nDiagMax = std::max(nDiagMax, H[d+1]);
+			--nLast;
+		}
+
+		// b(J) for J = d-I is reversed at N-J = N-d+I:
+		const TSymbol * const pB[NUM_DIFF_SYMBOL_SLOTS] = { b[0] + (N-d), b[1] + (N-d), b[2] + (N-d) };
+		nDiagMax = xdropVectorCells(H, H1, H2, a, pB, nFirst, nLast, nDiagMax);
+		Tp = std::max<int32_t>(Tp, nDiagMax);
+
+		if (fnStop(d, Tp, nDiagMax, nPrevDiagMax)) return false;
+		nPrevDiagMax = nDiagMax;
+	}
+
+	return true;
+}
+
+// ============================================================================
+
+
+static CFuncCompareResult compareFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC_COMPARE_METHOD nMethod,
 											const CFuncDescFile &file1, std::size_t nFile1FuncNdx,
 											const CFuncDescFile &file2, std::size_t nFile2FuncNdx,
-											bool bBuildEditScript)
+											bool bBuildEditScript, double nThreshold)
 {
-	double nRetVal = 0;
-	CStringArray zFunc1[NUM_FUNC_DIFF_LEVELS];
-	CStringArray::size_type nFunc1Size = 0;
-	CStringArray zFunc2[NUM_FUNC_DIFF_LEVELS];
-	CStringArray::size_type nFunc2Size = 0;
+	CFuncCompareResult aRetVal;
+	CDiffSymbolArray::size_type nFunc1Size = 0;
+	CDiffSymbolArray::size_type nFunc2Size = 0;
+	CDiffSymbolArray arrTempSymbols1;		// Scratch arrays used only if a function wasn't pre-tokenized
+	CDiffSymbolArray arrTempSymbols2;
 	char arrTemp[30];
 
-	g_bEditScriptValid = false;
-	g_EditScript.clear();
-
 	assert(nFile1FuncNdx < ((nCompareType == FCT_FUNCTIONS) ? file1.GetFuncCount() : file1.GetDataBlockCount()));
 	const CFuncDesc &function1 = ((nCompareType == FCT_FUNCTIONS) ? file1.GetFunc(nFile1FuncNdx) : file1.GetDataBlock(nFile1FuncNdx));
 	assert(nFile2FuncNdx < ((nCompareType == FCT_FUNCTIONS) ? file2.GetFuncCount() : file2.GetDataBlockCount()));
 	const CFuncDesc &function2 = ((nCompareType == FCT_FUNCTIONS) ? file2.GetFunc(nFile2FuncNdx) : file2.GetDataBlock(nFile2FuncNdx));
 
-	for (int nLevel = 0; nLevel < NUM_FUNC_DIFF_LEVELS; ++nLevel) {
-		function1.ExportToDiff(static_cast<FUNC_DIFF_LEVEL>(nLevel), zFunc1[nLevel]);
-		function2.ExportToDiff(static_cast<FUNC_DIFF_LEVEL>(nLevel), zFunc2[nLevel]);
-		if (nLevel == 0) {
-			nFunc1Size = zFunc1[nLevel].size();
-			nFunc2Size = zFunc2[nLevel].size();
-		} else {
-			assert(nFunc1Size == zFunc1[nLevel].size());
-			assert(nFunc2Size == zFunc2[nLevel].size());
-		}
-	}
-	if ((nFunc1Size == 0) || (nFunc2Size == 0)) return nRetVal;
+	// Functions read via ReadFuncDescFile() are tokenized once at load time.
+	//	Anything else gets tokenized here on the fly:
+	if (!function1.HasDiffSymbols()) function1.ExportToDiffSymbols(CDiffSymbolPool::instance(), arrTempSymbols1);
+	if (!function2.HasDiffSymbols()) function2.ExportToDiffSymbols(CDiffSymbolPool::instance(), arrTempSymbols2);
+	const CDiffSymbolArray &zFunc1 = function1.HasDiffSymbols() ? function1.GetDiffSymbols() : arrTempSymbols1;
+	const CDiffSymbolArray &zFunc2 = function2.HasDiffSymbols() ? function2.GetDiffSymbols() : arrTempSymbols2;
+
+	nFunc1Size = zFunc1.size() / NUM_DIFF_SYMBOL_SLOTS;
+	nFunc2Size = zFunc2.size() / NUM_DIFF_SYMBOL_SLOTS;
+	CPerfStats::countCompare(uint64_t(nFunc1Size) * nFunc2Size);
+	if ((nFunc1Size == 0) || (nFunc2Size == 0)) return aRetVal;
 	assert(nFunc1Size == function1.size());
 	assert(nFunc2Size == function2.size());
 
-	// TODO : Improve A/B Comparison:
-	// A/B Comparison function:
-	auto &&fnCompareMatch = [&function1, &function2, &zFunc1, &zFunc2](int i, int j)->bool {
-		// Check if exact bytes are the same:
-		if (function1.at(i)->isExactMatch(*function2.at(j))) return true;
+	// With a threshold (see CompareFunctionsBounded), the methods stop as
+	//	soon as the best score they could still reach can't make it, once
+	//	it's had the same primary label penalty and normalization as their
+	//	final score, in which case that's returned as the match instead:
+	const bool bBounded = (nThreshold > 0.0);
+	const bool bLabelPenalty = bBounded &&
+			(compareNoCase(file1.GetPrimaryLabel(CFuncDescFile::MEMORY_TYPE::MT_ROM, function1.GetMainAddress()),
+							file2.GetPrimaryLabel(CFuncDescFile::MEMORY_TYPE::MT_ROM, function2.GetMainAddress())) != 0);
+	auto &&fnBelowThreshold = [&](double nScoreBound, double mat)->bool {
+		if (bLabelPenalty) nScoreBound = std::max(0.0, nScoreBound - mat);
+		const double nMatchBound = nScoreBound/(std::max(nFunc1Size, nFunc2Size)*mat);
+		if (nMatchBound >= nThreshold) return false;
+		aRetVal.m_nMatchPercent = nMatchBound;
+		aRetVal.m_bBelowThreshold = true;
+		return true;
+	};
 
-		// Do fuzzy match at all levels:
-		for (int nLevel = 0; nLevel < NUM_FUNC_DIFF_LEVELS; ++nLevel) {
-			if (compareNoCase(zFunc1[nLevel].at(i), zFunc2[nLevel].at(j)) == 0) return true;
+	// A/B Comparison function:
+	//		Objects match if their exact bytes match or if they match at
+	//		any diff level.  Since the symbols are interned case-insensitively,
+	//		this is equivalent to comparing the ExportToDiff() strings with
+	//		compareNoCase() -- but without constructing any strings:
+	const TDiffSymbol *pSymbols1 = zFunc1.data();
+	const TDiffSymbol *pSymbols2 = zFunc2.data();
+	auto &&fnCompareMatch = [pSymbols1, pSymbols2](int i, int j)->bool {
+		const TDiffSymbol *pObj1 = pSymbols1 + (i * NUM_DIFF_SYMBOL_SLOTS);
+		const TDiffSymbol *pObj2 = pSymbols2 + (j * NUM_DIFF_SYMBOL_SLOTS);
+		for (int nSlot = 0; nSlot < NUM_DIFF_SYMBOL_SLOTS; ++nSlot) {
+			if (pObj1[nSlot] == pObj2[nSlot]) return true;
 		}
 		return false;
 	};
 
-	if ((bBuildEditScript) && (nMethod == FCM_DYNPROG_XDROP)) {
+	if ((bBuildEditScript) && ((nMethod == FCM_DYNPROG_XDROP) || (nMethod == FCM_DYNPROG_XDROP_VECTOR))) {
 		// Note: XDROP Method currently doesn't support building
 		//		of edit scripts, so if caller wants to build an
 		//		edit script and has selected this method, replace
@@ -172,41 +545,40 @@ double CompareFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC_COMPARE_METHOD nMet
 			//
 
 			double Tp, T;
-			double **S;
+			double *S;				// Current antidiagonal (k)
+			double *Sprev;			// Previous antidiagonal (k-2)
 			int i, j, k, L, U;
+			int iStart, iEnd;
 			double nTemp;
+			double nDiagMax;		// Max S(i, j) of the current antidiagonal
 			int M = nFunc1Size;
 			int N = nFunc2Size;
 			const double mat = 2;
 			const double mis = -2;
 			const double ind = -3;
 			const double X = -1;
-
-			// Allocate Memory:
-			S = new double*[((M+1)*2)];
-			if (S == nullptr) {
-				THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_OUT_OF_MEMORY);
-				return nRetVal;
-			}
-			for (i=0; i<((M+1)*2); i++) {
-				S[i] = new double[((N+1)*2)];
-				if (S[i] == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_OUT_OF_MEMORY);
-			}
+			CAlignmentWorkspace &aWorkspace = CAlignmentWorkspace::threadInstance();
 
 			// Initialize:
-			for (i=0; i<((M+1)*2); i++) {
-				for (j=0; j<((N+1)*2); j++) {
-					S[i][j] = -DBL_MAX;
-				}
-			}
+			//	Each S(i, j) lies on antidiagonal k=i+j and all references are
+			//	either to the antidiagonal being computed or the one just before
+			//	it, so only those two are kept, indexed by 'i':
+			aWorkspace.initXDrop((M+1)*2);
 
 			// Algorithm:
-			Tp = T = S[0][0] = 0;
+			Tp = T = 0;
+			S = aWorkspace.beginXDropDiag(0, 0, 0);
+			S[0] = 0;
 			k = L = U = 0;
 
 			do {
 				k = k + 2;
-				for (i = L+((L & 0x1) ? 1 : 0); i <= (U - ((U & 0x1) ? 1 : 0) + 2); i++) {
+				iStart = L+((L & 0x1) ? 1 : 0);
+				iEnd = (U - ((U & 0x1) ? 1 : 0) + 2);
+				Sprev = aWorkspace.xdropDiag(k-2);
+				S = aWorkspace.beginXDropDiag(k, iStart, iEnd);
+				nDiagMax = -DBL_MAX;
+				for (i = iStart; i <= iEnd; i++) {
 					j = k - i;
 					assert(i >= 0);
 					assert(i < ((M+1)*2));
@@ -217,46 +589,50 @@ double CompareFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC_COMPARE_METHOD nMet
 						if ((L <= (i-1)) &&
 							((i-1) <= U)) {
 							if (fnCompareMatch((i/2)-1, (j/2)-1)) {
-								nTemp = std::max(nTemp, S[i-1][j-1] + mat/2);
+								nTemp = std::max(nTemp, Sprev[i-1] + mat/2);		// S(i-1/2, j-1/2)
 							} else {
-								nTemp = std::max(nTemp, S[i-1][j-1] + mis/2);
+								nTemp = std::max(nTemp, Sprev[i-1] + mis/2);
 							}
 						}
 						if (i <= U) {
-							nTemp = std::max(nTemp, S[i][j-2] + ind);
+							nTemp = std::max(nTemp, Sprev[i] + ind);			// S(i, j-1)
 						}
 						if (L <= (i-2)) {
-							nTemp = std::max(nTemp, S[i-2][j] + ind);
+							nTemp = std::max(nTemp, Sprev[i-2] + ind);		// S(i-1, j)
 						}
-						S[i][j] = nTemp;
+						S[i] = nTemp;
 					} else {
 						if (fnCompareMatch(((i+1)/2)-1, ((j+1)/2)-1)) {
-							S[i][j] = S[i-1][j-1] + mat/2;
+							S[i] = Sprev[i-1] + mat/2;
 						} else {
-							S[i][j] = S[i-1][j-1] + mis/2;
+							S[i] = Sprev[i-1] + mis/2;
 						}
 					}
-					Tp = std::max(Tp, S[i][j]);
-					if ((X>=0) && (S[i][j] < (T-X))) S[i][j] = -DBL_MAX;
+					Tp = std::max(Tp, S[i]);
+					nDiagMax = std::max(nDiagMax, S[i]);
+					if ((X>=0) && (S[i] < (T-X))) S[i] = -DBL_MAX;
 				}
 
-				for (L = 0; L < ((M+1)*2); L++) {
-					if ((k - L) < 0) continue;
-					if ((k - L) >= ((N+1)*2)) continue;
-					if (S[L][k-L] > -DBL_MAX) break;
+				// Only the written span of the diagonal can be > -∞:
+				for (L = iStart; L <= iEnd; L++) {
+					if (S[L] > -DBL_MAX) break;
 				}
-				if (L == ((M+1)*2)) L=INT_MAX;
+				if (L > iEnd) L=INT_MAX;
 
-				for (U=((M+1)*2)-1; U>=0; U--) {
-					if ((k - U) < 0) continue;
-					if ((k - U) >= ((N+1)*2)) continue;
-					if (S[U][k-U] > -DBL_MAX) break;
+				for (U = iEnd; U >= iStart; U--) {
+					if (S[U] > -DBL_MAX) break;
 				}
-				if (U == -1) U=INT_MIN;
+				if (U < iStart) U=INT_MIN;
 
 				L = std::max(L, k + 1 - (N*2));
 				U = std::min(U, (M*2) - 1);
 				T = Tp;
+
+				// Every later S(i, j) follows from one on this antidiagonal,
+				//	gaining at most mat for each whole diagonal step that's left
+				//	from it, of which there are no more than half of the whole
+				//	steps left to the end of both functions:
+				if (bBounded && fnBelowThreshold(std::max(Tp, nDiagMax + mat*std::min<double>({ static_cast<double>(M), static_cast<double>(N), (M + N - (k/2))/2.0 })), mat)) return aRetVal;
 			} while (L <= U+2);
 
 			// If the two PrimaryLabels at the function's address don't match, decrement match by 1*mat.
@@ -266,11 +642,7 @@ double CompareFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC_COMPARE_METHOD nMet
 								file2.GetPrimaryLabel(CFuncDescFile::MEMORY_TYPE::MT_ROM, function2.GetMainAddress())) != 0) Tp = std::max(0.0, Tp - mat);
 
 			// Normalize it:
-			nRetVal = Tp/(std::max(M,N)*mat);
-
-			// Deallocate Memory:
-			for (i=0; i<((M+1)*2); i++) delete[] (S[i]);
-			delete[] S;
+			aRetVal.m_nMatchPercent = Tp/(std::max(M,N)*mat);
 		}
 		break;
 
@@ -340,7 +712,11 @@ double CompareFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC_COMPARE_METHOD nMet
 			//	edit script to go from an array of M objects to an array of N
 			//	objects is to perform M deletions and N insertions.  However,
 			//	these differences can be tracked either forward or backward, so
-			//	the memory will be allocated for the full search field.
+			//	the 'd' and 'k' ranges cover the full search field.  However,
+			//	only the band of 'k' values actually visited on each 'd' row is
+			//	stored (see CAlignmentWorkspace), and when the edit script is
+			//	being built for functions too big to keep every row, the rows
+			//	are recomputed during its traceback (see below).
 			//
 			//	We are also going to define -∞ as being -2 since no index can be
 			//	lower than 0.  The reason for the -2 instead of -1 is to allow
@@ -374,78 +750,114 @@ double CompareFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC_COMPARE_METHOD nMet
 			double Tpp;				// T'' = Overall max for current d value
 			double *T;
 			double nTemp;
-			int **Rm;
-			int *Rvisitmin;			// Minimum k-index of R visited for a particular d (for speed)
-			int *Rvisitmax;			// Maximum k-index of R visited for a particular k (for speed)
-			int i, j, k, L, U;
-			int d, dp;
+			int i, k, L, U;
+			int d;
 			int dbest, kbest;
 			const int M = nFunc1Size;
 			const int N = nFunc2Size;
 			const int dmax = ((M+N)*2)+1;
 			const int kmax = (M+N+1);
-			const int rksize = (kmax*2)+1;
 			const double mat = 2;
 			const double mis = -2;
 			const double X = -1;
 			const int floored_d_offset = (int)((X+(mat/2))/(mat-mis));
+			CAlignmentWorkspace &aWorkspace = CAlignmentWorkspace::threadInstance();
+			typedef CAlignmentWorkspace::TGreedyRow TGreedyRow;
 			#define Sp(x, y) ((double)((x)*(mat/2) - ((y)*(mat-mis))))
-			#define R(x, y) (Rm[(x)][(y)+kmax])		// Allow for negative indices of +/- kmax
 
-			// Allocate Memory:
-			T = new double[dmax];
-			if (T == nullptr) {
-				THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_OUT_OF_MEMORY);
-				return nRetVal;
-			}
-
-			Rvisitmin = new int[dmax];
-			if (Rvisitmin == nullptr) {
-				delete[] T;
-				THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_OUT_OF_MEMORY);
-				return nRetVal;
-			}
-
-			Rvisitmax = new int[dmax];
-			if (Rvisitmax == nullptr) {
-				delete[] T;
-				delete[] Rvisitmin;
-				THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_OUT_OF_MEMORY);
-				return nRetVal;
-			}
+			// Computes 'd' row 'row' from the row before it, 'rowPrev',
+			//	calling fnVisit(k, i, j) for each 'k' reached.  Each row
+			//	depends on nothing else but T[], so any row can be
+			//	recomputed later from the one before it:
+			auto &&fnGreedyRow = [M, N, kmax, dmax, floored_d_offset, mat, mis, X, &T, &fnCompareMatch](int d, const TGreedyRow &rowPrev, TGreedyRow &row, auto &&fnVisit)->void {
+				int i, j, k;
+				const int L = rowPrev.m_L;
+				const int U = rowPrev.m_U;
+				const int dp = d - floored_d_offset - 1;
+				const double nClipLimit = (((dp >= 0) ? T[dp] : 0) - X);
+				int nVisitMin = kmax+1;
+				int nVisitMax = -kmax-1;
+				row.init(L-1, U+1);
+
+				// Access the rows through locals, since the compiler can't
+				//	otherwise tell that writing 'R' entries doesn't change
+				//	the rows' bands:
+				const int kPrevLo = rowPrev.m_kLo;
+				const int kPrevHi = rowPrev.m_kHi;
+				const int *pPrevR = rowPrev.m_arrR.data();
+				auto &&fnPrevR = [kPrevLo, kPrevHi, pPrevR](int k)->int {
+					return (((k < kPrevLo) || (k > kPrevHi)) ? -2 : pPrevR[k - kPrevLo]);
+				};
+				int *pR = row.m_arrR.data();
+
+				for (k=(L-1); k<=(U+1); k++) {
+					assert(d > 0);
+					assert(d < dmax);
+					assert(abs(k) <= kmax);
+					i = -2;
+					if (L < k)			i = std::max(i, fnPrevR(k-1)+1);
+					if ((L <= k) &&
+						(k <= U))		i = std::max(i, fnPrevR(k)+1);
+					if (k < U)			i = std::max(i, fnPrevR(k+1));
+					j = i - k;
+					if ((i >= 0) && (j >= 0) && ((X<0) || (Sp(i+j, d) >= nClipLimit))) {
+						while ((i<M) && (j<N) && fnCompareMatch(i, j)) {
+							i++; j++;
+						}
 
-			Rm = new int*[dmax];
-			if (Rm == nullptr) {
-				delete[] T;
-				delete[] Rvisitmin;
-				delete[] Rvisitmax;
-				THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_OUT_OF_MEMORY);
-				return nRetVal;
-			}
-			for (i=0; i<dmax; i++) {
-				Rm[i] = new int[rksize];
-				if (Rm[i] == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_OUT_OF_MEMORY);
-			}
+						pR[k-(L-1)] = i;
+						if (nVisitMin > k) nVisitMin = k;
+						if (nVisitMax < k) nVisitMax = k;
+						fnVisit(k, i, j);
+					} else {
+						pR[k-(L-1)] = -2;
+						if (nVisitMin == k) nVisitMin++;
+						if (nVisitMax >= k) nVisitMax = k-1;
+					}
+				}
+				row.m_nVisitMin = nVisitMin;
+				row.m_nVisitMax = nVisitMax;
+
+				// Band for the next row:
+				row.m_L = nVisitMin;
+				row.m_U = nVisitMax;
+				for (k=nVisitMax+1; k>=nVisitMin-1; k--) if (row.R(k) == (N+k)) break;
+				if (k<nVisitMin-1) k = INT_MIN;
+				row.m_L = std::max(row.m_L, k);
+				for (k=nVisitMin-1; k<=nVisitMax+1; k++) if (row.R(k) == M) break;
+				if (k>nVisitMax+1) k = INT_MAX;
+				row.m_U = std::min(row.m_U, k);
+			};
+			auto &&fnNoVisit = [](int, int, int)->void { };
+
+			// Edit script rows are all kept for the traceback, as long
+			//	as they fit in the workspace's limit.  Otherwise, or if no
+			//	edit script is needed, only the last two rows are kept:
+			bool bAllRows = bBuildEditScript;
+			std::size_t nRowCells = 1;
+			auto &&fnRowSlot = [&](int d)->TGreedyRow & { return aWorkspace.greedyRow(bAllRows ? d : (d & 1)); };
 
 			// Initialize:
-			for (i=0; i<dmax; i++) {
-				T[i] = 0;
-				Rvisitmin[i] = kmax+1;
-				Rvisitmax[i] = -kmax-1;
-				for (j=0; j<rksize; j++) {
-					Rm[i][j] = -2;
-				}
-			}
+			//	Only T[0] and the first 'd' row need setting up.  The
+			//	rest of the rows are banded and are allocated (as -∞) when
+			//	each row is started:
+			aWorkspace.initGreedy(dmax);
+			T = aWorkspace.greedyT();
 
 			// Algorithm:
 			i=0;
 			while ((i<std::min(M, N)) && fnCompareMatch(i, i)) i++;
-			R(0, 0) = i;
+			TGreedyRow rowFirst;
+			rowFirst.init(0, 0);
+			rowFirst.ref(0) = i;
+			rowFirst.m_nVisitMin = 0;
+			rowFirst.m_nVisitMax = 0;
+			rowFirst.m_L = 0;
+			rowFirst.m_U = 0;
+			fnRowSlot(0) = rowFirst;
 			dbest = kbest = 0;
 			Tp = T[0] = Sp(i+i, 0);
-			d = L = U = 0;
-			Rvisitmin[0] = 0;
-			Rvisitmax[0] = 0;
+			d = 0;
 
 #if DEBUG_OES_SCRIPT
 printf("\n");
@@ -454,64 +866,49 @@ printf("\n");
 			if ((i != M) || (i != N)) {
 				do {
 					d++;
-					dp = d - floored_d_offset - 1;
 					Tpp = -DBL_MAX;
-					for (k=(L-1); k<=(U+1); k++) {
-						assert(d > 0);
-						assert(d < dmax);
-						assert(abs(k) <= kmax);
-						i = -2;
-						if (L < k)			i = std::max(i, R(d-1, k-1)+1);
-						if ((L <= k) &&
-							(k <= U))		i = std::max(i, R(d-1, k)+1);
-						if (k < U)			i = std::max(i, R(d-1, k+1));
-						j = i - k;
-						if ((i >= 0) && (j >= 0) && ((X<0) || (Sp(i+j, d) >= (((dp >= 0) ? T[dp] : 0) - X)))) {
-							while ((i<M) && (j<N) && fnCompareMatch(i, j)) {
-								i++; j++;
-							}
-
-							R(d, k) = i;
-							if (Rvisitmin[d] > k) Rvisitmin[d] = k;
-							if (Rvisitmax[d] < k) Rvisitmax[d] = k;
-							nTemp = Sp(i+j, d);
-							Tp = std::max(Tp, nTemp);
+					assert(d < dmax);
+					TGreedyRow &row = fnRowSlot(d);
+					fnGreedyRow(d, fnRowSlot(d-1), row, [&](int k, int i, int j)->void {
+						nTemp = Sp(i+j, d);
+						Tp = std::max(Tp, nTemp);
 
 #if DEBUG_OES_SCRIPT
 printf("d=%2d : k=%2d, i=%2d, j=%2d, M=%2d, N=%2d, T=%2d, Tp=%2d, Tpp=%2d", d, k, i, j, M, N, (int)nTemp, (int)Tp, (int)Tpp);
 #endif
 
-							if (nTemp > Tpp) {
-								Tpp = nTemp;
-								dbest = d;
-								kbest = k;
+						if (nTemp > Tpp) {
+							Tpp = nTemp;
+							dbest = d;
+							kbest = k;
 
 #if DEBUG_OES_SCRIPT
 printf(" * Best (%2d)", (int)Tpp);
 #endif
 
-							}
+						}
 
 #if DEBUG_OES_SCRIPT
 printf("\n");
 #endif
-
-						} else {
-							R(d, k) = -2;
-							if (Rvisitmin[d] == k) Rvisitmin[d]++;
-							if (Rvisitmax[d] >= k) Rvisitmax[d] = k-1;
+					});
+					if (bAllRows) {
+						nRowCells += row.size();
+						if (nRowCells > CAlignmentWorkspace::GREEDY_MAX_ROW_CELLS) {
+							// Too big to keep, switch to keeping only the last two:
+							bAllRows = false;
+							std::swap(aWorkspace.greedyRow(d-1), fnRowSlot(d-1));
+							std::swap(aWorkspace.greedyRow(d), fnRowSlot(d));
 						}
 					}
 					T[d] = Tp;
 
-					L = Rvisitmin[d];
-					U = Rvisitmax[d];
-					for (k=Rvisitmax[d]+1; k>=Rvisitmin[d]-1; k--) if (R(d, k) == (N+k)) break;
-					if (k<Rvisitmin[d]-1) k = INT_MIN;
-					L = std::max(L, k);
-					for (k=Rvisitmin[d]-1; k<=Rvisitmax[d]+1; k++) if (R(d, k) == M) break;
-					if (k>Rvisitmax[d]+1) k = INT_MAX;
-					U = std::min(U, k);
+					// Nothing on a later 'd' row can score more than reaching
+					//	the end of both functions on the next one:
+					if (bBounded && fnBelowThreshold(std::max(Tp, Sp(M+N, d+1)), mat)) return aRetVal;
+
+					L = fnRowSlot(d).m_L;
+					U = fnRowSlot(d).m_U;
 				} while (L <= U+2);
 			}
 
@@ -522,7 +919,7 @@ printf("\n");
 								file2.GetPrimaryLabel(CFuncDescFile::MEMORY_TYPE::MT_ROM, function2.GetMainAddress())) != 0) Tp = std::max(0.0, Tp - mat);
 
 			// Normalize it:
-			nRetVal = Tp/(std::max(M,N)*mat);
+			aRetVal.m_nMatchPercent = Tp/(std::max(M,N)*mat);
 
 			// Build Edit Script:
 			if (bBuildEditScript) {
@@ -530,54 +927,61 @@ printf("\n");
 					// Note: dbest will always be the number of OES operations
 					//	required unless the very last one is a no-op case, in
 					//	which it will be one over (see bDeleteEntry below)
-					g_EditScript.resize(dbest);
-					k = kbest;
+					aRetVal.m_arrEditScript.resize(dbest);
 
 #if DEBUG_OES_SCRIPT
 printf("\n%s with %s:\n", function1.GetMainName().c_str(), function2.GetMainName().c_str());
 #endif
 
-					for (d=dbest-1; d>=0; d--) {	// Use (d-1) for loop so all calls to R() don't below don't have to subtract 1
-						bool bDeleteEntry = false;			// True if this entry should get deleted
-
-						// The curR pair will be the current operation with the
-						//		current adjusted 'R' value being tested:
-						//	Operation will be:
-						//		-1 for deletion    (>)
-						//		0  for replacement (-)
-						//		1  for insertion   (<)
-						std::pair<int, int> curR(0, (R(d, k) + 1));				// Default to '-' (replacement)
-						if ((R(d, k-1) + 1) > curR.second) {
-							curR = std::pair<int, int>(1, (R(d, k-1) + 1));		// Check for '>' (deletion)
+					// Which of the three 'd' row entries the traceback steps to
+					//	from diagonal 'k' of the next row, returning it as
+					//	the operation and its 'i':
+					//		-1 for deletion    (>)
+					//		0  for replacement (-)
+					//		1  for insertion   (<)
+					//	The next 'k' is then 'k' minus the operation:
+					auto &&fnGreedyTraceOp = [](const TGreedyRow &row, int k, int &i)->int {
+						std::pair<int, int> curR(0, (row.R(k) + 1));				// Default to '-' (replacement)
+						if ((row.R(k-1) + 1) > curR.second) {
+							curR = std::pair<int, int>(1, (row.R(k-1) + 1));		// Check for '>' (deletion)
 						}
-						if ((R(d, k+1)) > curR.second) {
-							curR = std::pair<int, int>(-1, (R(d, k+1)));		// Check for '<' (insertion)
+						if ((row.R(k+1)) > curR.second) {
+							curR = std::pair<int, int>(-1, (row.R(k+1)));		// Check for '<' (insertion)
 						}
-
 						i = curR.second;
-						j = i-k;
+						return curR.first;
+					};
+
+					// Traces back 'd' row 'row' from diagonal 'k' of the next
+					//	row, outputting its edit script entry.  Rows must be
+					//	traced in order from dbest-1 down to 0:
+					auto &&fnGreedyTraceRow = [&](int d, const TGreedyRow &row, int &k)->void {
+						bool bDeleteEntry = false;			// True if this entry should get deleted
+						int i;
+						int nOp = fnGreedyTraceOp(row, k, i);
+						int j = i-k;
 
 #if DEBUG_OES_SCRIPT
 printf("(%3d, %3d) : %3d(%5d), %3d(%5d), %3d(%5d) :", d, k,
-						(R(d, k-1) + 1), (int)Sp((R(d, k-1))*2-k+1, d),
-						(R(d, k) + 1), (int)Sp((R(d, k))*2-k, d),
-						(R(d, k+1)), (int)Sp((R(d, k+1))*2-k-1, d));
+						(row.R(k-1) + 1), (int)Sp((row.R(k-1))*2-k+1, d),
+						(row.R(k) + 1), (int)Sp((row.R(k))*2-k, d),
+						(row.R(k+1)), (int)Sp((row.R(k+1))*2-k-1, d));
 
-for (int ktemp=Rvisitmin[dbest-1]-1; ktemp<=Rvisitmax[dbest-1]+1; ktemp++) {
+for (int ktemp=row.m_nVisitMin-1; ktemp<=row.m_nVisitMax+1; ktemp++) {
 	if (ktemp == k-1) printf("("); else printf(" ");
-	if (R(d,ktemp)<0) printf("   "); else printf("%3d", R(d, ktemp));
+	if (row.R(ktemp)<0) printf("   "); else printf("%3d", row.R(ktemp));
 	if (ktemp == k+1) printf(")"); else printf(" ");
 }
 printf("\n");
 #endif
 
-						if (curR.first == 1) {
+						if (nOp == 1) {
 							std::sprintf(arrTemp, "%d>%d", i-1, j);
 							k--;
-						} else if (curR.first == -1) {
+						} else if (nOp == -1) {
 							std::sprintf(arrTemp, "%d<%d", i, j-1);
 							k++;
-						} else {	// curR.first == 0
+						} else {	// nOp == 0
 							std::sprintf(arrTemp, "%d-%d", i-1, j-1);
 							int cur_i = i-1;
 							int cur_j = j-1;
@@ -589,19 +993,17 @@ printf(" - becomes > : ");
 #endif
 								std::sprintf(arrTemp, "%d>%d", cur_i, N);
 								//k--;  // ?? these are always last entries, so no need to update k
-								curR.first = 1;		// But update curR so we have a consistent operation value
 							} else if ((cur_i >= M) && (cur_j < N)) {
 #if DEBUG_OES_SCRIPT
 printf(" - becomes < : ");
 #endif
 								std::sprintf(arrTemp, "%d<%d", M, cur_j);
 								//k++;  // ?? these are always last entries, so no need to update k
-								curR.first = -1;	// But update curR so we have a consistent operation value
 							} else if ((cur_i >= M) && (cur_j >= N)) {
 								bDeleteEntry = true;
 							}
 						}
-						g_EditScript[d] = arrTemp;
+						aRetVal.m_arrEditScript[d] = arrTemp;
 
 #if DEBUG_OES_SCRIPT
 printf("%d : %s", d, arrTemp);
@@ -616,7 +1018,7 @@ printf("%d : %s", d, arrTemp);
 						//				End - End			(needs to be deleted here)
 						if (bDeleteEntry) {
 							// This is always a last entry and where both: cur_i==M and cur_j==N
-							g_EditScript.erase(g_EditScript.begin() + d);
+							aRetVal.m_arrEditScript.erase(aRetVal.m_arrEditScript.begin() + d);
 #if DEBUG_OES_SCRIPT
 printf("  *** erasing: %d", d);
 #endif
@@ -625,21 +1027,147 @@ printf("  *** erasing: %d", d);
 #if DEBUG_OES_SCRIPT
 printf("\n");
 #endif
+					};
 
+					if (bAllRows) {
+						k = kbest;
+						for (d=dbest-1; d>=0; d--) fnGreedyTraceRow(d, fnRowSlot(d), k);
+					} else {
+						// The rows didn't all fit, so they're recomputed for the
+						//	traceback, keeping its memory linear:  The traceback
+						//	of rows dLo to dHi-1 is split into sections, by
+						//	computing the rows forward from dLo and keeping only
+						//	the first row of each section.  Each section is
+						//	then traced in turn, from the last one down, which
+						//	keeps the rows traced in order from dbest-1 down to
+						//	0, and 'k' carries over from one to the next.  A
+						//	section with few enough rows is recomputed and traced
+						//	directly, and any others are split in the same way:
+						struct TGreedyTrace {
+							int m_dLo;
+							int m_dHi;
+							TGreedyRow m_rowLo;		// Row m_dLo
+						};
+						const int nTraceRows = std::max<int>(2, CAlignmentWorkspace::GREEDY_MAX_ROW_CELLS / ((2*kmax)+3));
+						std::vector<TGreedyTrace> arrTraces;
+						arrTraces.push_back({ 0, dbest, rowFirst });
+						k = kbest;
+						while (!arrTraces.empty()) {
+							TGreedyTrace aTrace = std::move(arrTraces.back());
+							arrTraces.pop_back();
+							const int nRows = aTrace.m_dHi - aTrace.m_dLo;
+
+							if (nRows <= nTraceRows) {
+								std::swap(aWorkspace.greedyRow(0), aTrace.m_rowLo);
+								for (d=aTrace.m_dLo+1; d<aTrace.m_dHi; d++) {
+									TGreedyRow &row = aWorkspace.greedyRow(d-aTrace.m_dLo);
+									fnGreedyRow(d, aWorkspace.greedyRow(d-aTrace.m_dLo-1), row, fnNoVisit);
+								}
+								for (d=aTrace.m_dHi-1; d>=aTrace.m_dLo; d--) fnGreedyTraceRow(d, aWorkspace.greedyRow(d-aTrace.m_dLo), k);
+								continue;
+							}
+
+							// As few sections as will each fit, up to as many as
+							//	there's room to keep the first rows of:
+							const int nSections = std::min(nTraceRows, (nRows + nTraceRows - 1) / nTraceRows);
+							auto &&fnSectionStart = [&aTrace, nRows, nSections](int nSection)->int {
+								return aTrace.m_dLo + static_cast<int>((static_cast<int64_t>(nRows) * nSection) / nSections);
+							};
+							std::vector<TGreedyTrace> arrSections;
+							const TGreedyRow *pRow = &aTrace.m_rowLo;
+							d = aTrace.m_dLo;
+							for (int nSection = 1; nSection < nSections; ++nSection) {
+								const int dSection = fnSectionStart(nSection);
+								while (d < dSection) {
+									++d;
+									TGreedyRow &row = aWorkspace.greedyRow(d & 1);
+									fnGreedyRow(d, *pRow, row, fnNoVisit);
+									pRow = &row;
+								}
+								arrSections.push_back({ dSection, fnSectionStart(nSection+1), *pRow });
+							}
+							arrTraces.push_back({ aTrace.m_dLo, fnSectionStart(1), std::move(aTrace.m_rowLo) });
+							for (auto &aSection : arrSections) arrTraces.push_back(std::move(aSection));
+						}
 					}
 				}
 
 
 				// Note: if the two are identical, array stays empty:
-				g_bEditScriptValid = true;
+				aRetVal.m_bEditScriptValid = true;
 			}
 
-			// Deallocate Memory:
-			delete[] T;
-			delete[] Rvisitmin;
-			delete[] Rvisitmax;
-			for (i=0; i<dmax; i++) delete[] (Rm[i]);
-			delete[] Rm;
+			#undef Sp
+		}
+		break;
+
+		case FCM_DYNPROG_XDROP_VECTOR:
+		{
+			//
+			//	This computes exactly the same score as FCM_DYNPROG_XDROP above,
+			//		restated as an integer kernel that runs as SIMD:
+			//
+			//	With X = -1, nothing is ever clipped, so every S(i, j) of the
+			//		whole M x N grid is reached.  And since a half-cell is only
+			//		ever S(i-1, j-1) + mat/2 (or mis/2), which is never more
+			//		than either S(i-1, j-1) or the S(i, j) it leads to, the
+			//		half-cells can be folded into their whole-cells:
+			//
+			//			H(0, 0) = 0
+			//			H(I, J) = Max of:
+			//						H(I-1, J-1) + mat		if a(I) = b(J)
+			//						H(I-1, J-1) + mis		if a(I) != b(J)
+			//						H(I, J-1) + ind
+			//						H(I-1, J) + ind
+			//			T' = max{H(I, J)}
+			//
+			//		with anything outside of the grid being -∞, which means
+			//		H(0, J) and H(I, 0) only have the one indel predecessor.
+			//		All of the weights are integers, so the scores are exact
+			//		in int32_t and normalizing them gives bit-identical results
+			//		to the double version.
+			//
+			//	Every H on antidiagonal d = I+J depends only on antidiagonals
+			//		d-1 and d-2, so each antidiagonal is one loop over I with
+			//		no dependencies between iterations.  Storing the second
+			//		function's symbols reversed makes b(J) = b(d-I) contiguous
+			//		in I too, so that loop runs as SIMD (see xdropVectorCells).
+			//		The scores are between ind*(M+N) and mat*min(M,N), so
+			//		anything with M+N up to XDROP_VECTOR_MAX_INT16_SIZE runs
+			//		in int16_t lanes, which is nearly every real function, as
+			//		long as its symbols fit (see CAlignmentWorkspace).  Anything
+			//		else uses int32_t lanes, which is the scalar kernel:
+			//
+
+			const int M = nFunc1Size;
+			const int N = nFunc2Size;
+			const int32_t mat = XDROP_VECTOR_MAT;
+			int32_t Tp = 0;
+			CAlignmentWorkspace &aWorkspace = CAlignmentWorkspace::threadInstance();
+
+			// Same bound as for FCM_DYNPROG_XDROP, but in whole cells, a
+			//	diagonal step skips an antidiagonal, so later cells follow
+			//	from either this antidiagonal or the one before it:
+			auto &&fnStop = [&](int d, int32_t nBest, int32_t nDiagMax, int32_t nPrevDiagMax)->bool {
+				return (bBounded && fnBelowThreshold(std::max({ nBest,
+																nDiagMax + mat*std::min({ M, N, (M+N-d)/2 }),
+																nPrevDiagMax + mat*std::min({ M, N, (M+N-d+1)/2 }) }), mat));
+			};
+			CAlignmentWorkspace::CXDropVectorLanes16 *pLanes16 = (((M+N) <= XDROP_VECTOR_MAX_INT16_SIZE) ? aWorkspace.initXDropVector16(zFunc1, zFunc2) : nullptr);
+			if (pLanes16 != nullptr) {
+				if (!xdropVectorScore(*pLanes16, M, N, fnStop, Tp)) return aRetVal;
+			} else {
+				if (!xdropVectorScore(aWorkspace.initXDropVector32(zFunc1, zFunc2), M, N, fnStop, Tp)) return aRetVal;
+			}
+
+			// If the two PrimaryLabels at the function's address don't match, decrement match by 1*mat.
+			//		This helps if there are two are more functions that the user has labeled that
+			//		are identical except for the labels:
+			if (compareNoCase(file1.GetPrimaryLabel(CFuncDescFile::MEMORY_TYPE::MT_ROM, function1.GetMainAddress()),
+								file2.GetPrimaryLabel(CFuncDescFile::MEMORY_TYPE::MT_ROM, function2.GetMainAddress())) != 0) Tp = std::max(0, Tp - mat);
+
+			// Normalize it:
+			aRetVal.m_nMatchPercent = static_cast<double>(Tp)/(std::max(M,N)*static_cast<double>(mat));
 		}
 		break;
 
@@ -647,29 +1175,95 @@ printf("\n");
 			break;
 	}
 
-	return nRetVal;
+	return aRetVal;
+}
+
+CFuncCompareResult CompareFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC_COMPARE_METHOD nMethod,
+											const CFuncDescFile &file1, std::size_t nFile1FuncNdx,
+											const CFuncDescFile &file2, std::size_t nFile2FuncNdx,
+											bool bBuildEditScript)
+{
+	return compareFunctions(nCompareType, nMethod, file1, nFile1FuncNdx, file2, nFile2FuncNdx, bBuildEditScript, 0.0);
+}
+
+CFuncCompareResult CompareFunctionsBounded(FUNC_COMPARE_TYPE nCompareType, FUNC_COMPARE_METHOD nMethod,
+											const CFuncDescFile &file1, std::size_t nFile1FuncNdx,
+											const CFuncDescFile &file2, std::size_t nFile2FuncNdx,
+											double nThreshold)
+{
+	//
+	//	Gives the same match as CompareFunctions() when it's at least
+	//	nThreshold.  Otherwise, it may stop early with m_bBelowThreshold
+	//	set, such as for finding best matches, where nothing below the
+	//	current best is needed (see -bo in funcanal).  The bound of what
+	//	can still be reached is checked at the end of each antidiagonal
+	//	(XDROP) or 'd' row (GREEDY):
+	//
+	return compareFunctions(nCompareType, nMethod, file1, nFile1FuncNdx, file2, nFile2FuncNdx, false, nThreshold);
 }
 
-bool GetLastEditScript(CStringArray &anArray)
+double CompareFunctionsUpperBound(FUNC_COMPARE_TYPE nCompareType,
+						const CFuncDescFile &file1, std::size_t nFile1FuncNdx,
+						const CFuncDescFile &file2, std::size_t nFile2FuncNdx)
 {
-	anArray.clear();
-	if (!g_bEditScriptValid) return false;
+	//
+	//	Both the XDROP and GREEDY scores are the maximum, over the points of an
+	//	alignment, of mat*(matches) + mis*(mismatches) + ind*(indels).  Since
+	//	mis and ind are both negative, no score can exceed mat times the number
+	//	of matches in the alignment.  And since an alignment pairs each object
+	//	at most once, the number of matches is limited to the number of objects
+	//	on either side that match anything at all on the other side.  With the
+	//	normalization of Tp/(max(M,N)*mat), this gives:
+	//
+	//		match <= min(matchable(a in b), matchable(b in a)) / max(M, N)
+	//
+	//	Which is also never more than the length ratio of min(M,N)/max(M,N),
+	//	which is checked first as it's free.  The primary label penalty only
+	//	ever lowers the score, so it doesn't affect the bound.
+	//
+
+	assert(nFile1FuncNdx < ((nCompareType == FCT_FUNCTIONS) ? file1.GetFuncCount() : file1.GetDataBlockCount()));
+	const CFuncDesc &function1 = ((nCompareType == FCT_FUNCTIONS) ? file1.GetFunc(nFile1FuncNdx) : file1.GetDataBlock(nFile1FuncNdx));
+	assert(nFile2FuncNdx < ((nCompareType == FCT_FUNCTIONS) ? file2.GetFuncCount() : file2.GetDataBlockCount()));
+	const CFuncDesc &function2 = ((nCompareType == FCT_FUNCTIONS) ? file2.GetFunc(nFile2FuncNdx) : file2.GetDataBlock(nFile2FuncNdx));
 
-	anArray = g_EditScript;
+	const std::size_t M = function1.size();
+	const std::size_t N = function2.size();
+	if ((M == 0) || (N == 0)) return 0.0;
+	const double nMaxSize = static_cast<double>(std::max(M, N));
+	if (!function1.HasDiffSymbols() || !function2.HasDiffSymbols()) return (std::min(M, N) / nMaxSize);
+
+	auto &&fnCountMatchable = [](const CFuncDesc &funcA, const CFuncDesc &funcB)->std::size_t {
+		std::size_t nCount = 0;
+		const CDiffSymbolArray &arrSymbols = funcA.GetDiffSymbols();
+		for (CDiffSymbolArray::size_type ndxObj = 0; ndxObj < arrSymbols.size(); ndxObj += NUM_DIFF_SYMBOL_SLOTS) {
+			for (int nSlot = 0; nSlot < NUM_DIFF_SYMBOL_SLOTS; ++nSlot) {
+				const CDiffSymbolArray &arrSet = funcB.GetDiffSymbolSet(static_cast<DIFF_SYMBOL_SLOT>(nSlot));
+				if (std::binary_search(arrSet.cbegin(), arrSet.cend(), arrSymbols[ndxObj + nSlot])) {
+					++nCount;
+					break;
+				}
+			}
+		}
+		return nCount;
+	};
 
-	return true;
+	std::size_t nMatchable = fnCountMatchable(function1, function2);
+	if (nMatchable) nMatchable = std::min(nMatchable, fnCountMatchable(function2, function1));
+	return (nMatchable / nMaxSize);
 }
 
-TString DiffFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC_COMPARE_METHOD nMethod,
+CFuncDiffResult DiffFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC_COMPARE_METHOD nMethod,
 						const CFuncDescFile &file1, std::size_t nFile1FuncNdx,
 						const CFuncDescFile &file2, std::size_t nFile2FuncNdx,
 						OUTPUT_OPTIONS nOutputOptions,
-						double &nMatchPercent,
 						CSymbolMap *pSymbolMap)
 {
-	TString strRetVal;
+	CPerfStats::count(PC_DIFF_CALLS);
+
+	CFuncDiffResult aRetVal;
+	TString &strRetVal = aRetVal.m_strDiff;
 
-	CStringArray oes;
 	CStringArray Func1Lines;
 	CStringArray Func2Lines;
 
@@ -678,8 +1272,9 @@ TString DiffFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC_COMPARE_METHOD nMetho
 	assert(nFile2FuncNdx < ((nCompareType == FCT_FUNCTIONS) ? file2.GetFuncCount() : file2.GetDataBlockCount()));
 	const CFuncDesc &function2 = ((nCompareType == FCT_FUNCTIONS) ? file2.GetFunc(nFile2FuncNdx) : file2.GetDataBlock(nFile2FuncNdx));
 
-	nMatchPercent = CompareFunctions(nCompareType, nMethod, file1, nFile1FuncNdx, file2, nFile2FuncNdx, true);
-	if (!GetLastEditScript(oes)) return strRetVal;
+	static_cast<CFuncCompareResult &>(aRetVal) = CompareFunctions(nCompareType, nMethod, file1, nFile1FuncNdx, file2, nFile2FuncNdx, true);
+	if (!aRetVal.m_bEditScriptValid) return aRetVal;
+	const CStringArray &oes = aRetVal.m_arrEditScript;
 
 
 /*
@@ -777,7 +1372,7 @@ if ((nLeftPos != nLeftIndex) || (nRightPos != nRightIndex)) {
 			case '<':
 				if (nRightPos >= Func2Lines.size()) {
 					strRetVal += "\n\n*** ERROR: Right-Side Index Out-Of-Range!\n\n";
-					return strRetVal;
+					return aRetVal;
 				}
 				break;
 			case '-':
@@ -786,17 +1381,17 @@ if ((nLeftPos != nLeftIndex) || (nRightPos != nRightIndex)) {
 					if (nRightPos >= Func2Lines.size()) {
 						strRetVal += "\n\n*** ERROR: Right-Side Index Out-Of-Range!\n\n";
 					}
-					return strRetVal;
+					return aRetVal;
 				}
 				if (nRightPos >= Func2Lines.size()) {
 					strRetVal += "\n\n*** ERROR: Right-Side Index Out-Of-Range!\n\n";
-					return strRetVal;
+					return aRetVal;
 				}
 				break;
 			case '>':
 				if (nLeftPos >= Func1Lines.size()) {
 					strRetVal += "\n\n*** ERROR: Left-Side Index Out-Of-Range!\n\n";
-					return strRetVal;
+					return aRetVal;
 				}
 				break;
 		}
@@ -835,6 +1430,6 @@ if ((nLeftPos != nLeftIndex) || (nRightPos != nRightIndex)) {
 		if (pSymbolMap) pSymbolMap->AddObjectMapping(*function1.at(nLeftPos), *function2.at(nRightPos));
 	}
 
-	return strRetVal;
+	return aRetVal;
 }
 
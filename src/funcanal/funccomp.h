@@ -21,6 +21,7 @@ class CSymbolMap;
 enum FUNC_COMPARE_METHOD {
 	FCM_DYNPROG_XDROP = 0,
 	FCM_DYNPROG_GREEDY = 1,
+	FCM_DYNPROG_XDROP_VECTOR = 2,		// Same results as FCM_DYNPROG_XDROP, but with an integer kernel laid out for SIMD
 	FCM_COUNT
 };
 
@@ -45,18 +46,39 @@ enum OUTPUT_OPTIONS {
 };
 DEFINE_ENUM_FLAG_OPERATORS(OUTPUT_OPTIONS);
 
-double CompareFunctions(FUNC_COMPARE_TYPE nCompareType,
+// Function Comparison Results:
+//		These are returned by value (rather than being held in any
+//		static state) so that comparisons and diffs are re-entrant
+//		and can be run concurrently from multiple threads:
+struct CFuncCompareResult {
+	double m_nMatchPercent = 0.0;		// Normalized match (0.0 to 1.0)
+	bool m_bEditScriptValid = false;	// True if the edit script was built (it's empty if the functions are identical)
+	CStringArray m_arrEditScript;		// Optimal Edit Script (see funccomp.cpp for format)
+	bool m_bBelowThreshold = false;		// True if CompareFunctionsBounded() stopped early, in which case m_nMatchPercent is only an upper bound below the threshold
+};
+
+struct CFuncDiffResult : public CFuncCompareResult {
+	TString m_strDiff;					// Side-by-side diff text
+};
+
+CFuncCompareResult CompareFunctions(FUNC_COMPARE_TYPE nCompareType,
 						FUNC_COMPARE_METHOD nMethod,
 						const CFuncDescFile &file1, std::size_t nFile1FuncNdx,
 						const CFuncDescFile &file2, std::size_t nFile2FuncNdx,
 						bool bBuildEditScript);
-bool GetLastEditScript(CStringArray &anArray);
-TString DiffFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC_COMPARE_METHOD nMethod,
+CFuncCompareResult CompareFunctionsBounded(FUNC_COMPARE_TYPE nCompareType,
+						FUNC_COMPARE_METHOD nMethod,
+						const CFuncDescFile &file1, std::size_t nFile1FuncNdx,
+						const CFuncDescFile &file2, std::size_t nFile2FuncNdx,
+						double nThreshold);		// Same as CompareFunctions() (without an edit script), but stops once the match can't reach nThreshold
+double CompareFunctionsUpperBound(FUNC_COMPARE_TYPE nCompareType,
+						const CFuncDescFile &file1, std::size_t nFile1FuncNdx,
+						const CFuncDescFile &file2, std::size_t nFile2FuncNdx);		// Returns a cheap upper bound on CompareFunctions() match for any method
+CFuncDiffResult DiffFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC_COMPARE_METHOD nMethod,
 						const CFuncDescFile &file1, std::size_t nFile1FuncNdx,
 						const CFuncDescFile &file2, std::size_t nFile2FuncNdx,
 						OUTPUT_OPTIONS nOutputOptions,
-						double &nMatchPercent,
-						CSymbolMap *pSymbolMap = nullptr);
+						CSymbolMap *pSymbolMap = nullptr);		// Symbol mappings for the matched objects are added to pSymbolMap (if specified)
 
 #endif	// FUNC_COMP_H_
 
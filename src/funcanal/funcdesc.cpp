@@ -105,9 +105,50 @@
 //			digits, but an 8-bit immediate value, offset, or mask, will be outputted as only 2 hex digits.
 //
 
+//
+//	Format of Binary Function File:
+//
+//		The Binary Function File holds everything read from a Function Output
+//		File, including the tokenized diff symbols, so that it can be loaded
+//		without parsing.  All values are 32-bit words in the native byte
+//		order of the machine writing it, which is verified by the byte-order
+//		marker when read:
+//
+//			CBinaryFuncDescHeader			(48 bytes)
+//			uint32[m_nStrings+1]			String Pool offsets, the last being the end of the last string
+//			char[m_nStringBytes]			String Pool characters, padded to a multiple of 4 bytes
+//			uint32[m_nBodyWords]			Body Tables
+//
+//		Strings (labels, mnemonics, operands, object bytes, and diff symbol
+//		strings) are stored once in the String Pool and referenced by their
+//		index.  The Body consists of the following length-prefixed tables:
+//
+//			Memory Mappings:	count, { type, addr, size_lo, size_hi }
+//			Labels:				count, { type, addr, labels }
+//			Indirects:			count, { type (0=Code, 1=Data), addr, target_addr, labels }
+//			Functions:			count, { function }
+//			Data Blocks:		count, { function }
+//
+//		Where "labels" is a count followed by that many string indexes,
+//		and "function" is:
+//
+//			main_addr
+//			names:				count, { addr, labels }
+//			objects:			count, { type (0=Data Byte, 1=Mnemonic), rel_addr, abs_addr, labels, bytes,
+//											and for Mnemonics: opcode_bytes, operand_bytes, dst, src, mnemonic, operands }
+//			content_hash_lo, content_hash_hi
+//			diff symbols:		(count of objects * NUM_DIFF_SYMBOL_SLOTS) string indexes
+//
+//		Since the header and tables are all multiples of 4 bytes, the body
+//		is naturally aligned when the file is mapped at a page boundary.
+//
+
 //#include "funcanal.h"
 #include "funcdesc.h"
+#include "mapfile.h"
 #include <errmsgs.h>
+#include <perfstats.h>
+#include <threadhelp.h>
 
 #include <sstream>
 #include <iomanip>
@@ -115,6 +156,7 @@
 #include <iterator>
 #include <regex>
 #include <filesystem>
+#include <cstring>
 
 #define CALC_FIELD_WIDTH(x) x
 
@@ -126,7 +168,7 @@
 
 typedef std::map<std::string, int> TKeywordMap;
 
-int parseKeyword(const TKeywordMap &map, const std::string &strKeyword)
+static int parseKeyword(const TKeywordMap &map, const std::string &strKeyword)
 {
 	for (auto const & itr : map) {
 		if (std::regex_match(strKeyword, std::regex(itr.first, std::regex::extended))) return itr.second;
@@ -198,31 +240,294 @@ static std::string::size_type getLongestMemMapName()
 
 
 // ParseLine : Parses a line from the file and returns an array of
-//				items from the specified separator.
-static void ParseLine(const TString &line, TString::value_type cSepChar, CStringArray &argv)
+//				items from the specified separator.  The line can be one
+//				of the items of argv:
+static void ParseLine(std::string_view line, TString::value_type cSepChar, CStringArray &argv)
 {
-	TString strLine = line;
-	TString strTemp;
-	TString::size_type pos;
+	CStringArray arrItems;
+
+	while (1) {
+		std::string_view::size_type pos = line.find(cSepChar);
+		std::string_view strItem = line.substr(0, pos);
+		arrItems.emplace_back(trim(strItem));
+		if (pos == std::string_view::npos) break;
+		line.remove_prefix(pos+1);
+	}
 
-	argv.clear();
+	argv.swap(arrItems);
+}
 
-	strLine += cSepChar;
 
-	while (!strLine.empty()) {
-		pos = strLine.find(cSepChar);
-		if (pos != TString::npos) {
-			strTemp = strLine.substr(0, pos);
-			trim(strTemp);
-			strLine = strLine.substr(pos+1);
-		} else {
-			strTemp = strLine;
-			trim(strTemp);
-			strLine.clear();
+// diffSymbolString : Returns the comparison string for the specified
+//				DIFF_SYMBOL_SLOT of the object.  Exact bytes are prefixed
+//				with a type that can't be generated by ExportToDiff() so
+//				they can share the same pool:
+static TString diffSymbolString(const CFuncObject &anObject, int nSlot)
+{
+	if (nSlot == DSS_EXACT_BYTES) return "B|" + anObject.GetBytes();
+	return anObject.ExportToDiff(static_cast<FUNC_DIFF_LEVEL>(nSlot - DSS_DIFF_LEVEL));
+}
+
+// ============================================================================
+
+static constexpr char g_arrFuncFileSignature[8] = { 'F', 'A', 'F', 'U', 'N', 'C', 'S', 0 };
+static constexpr uint32_t g_nFuncFileByteOrder = 0x01020304ul;
+static constexpr uint32_t g_nFuncFileVersion = 1;
+
+enum FUNC_FILE_FLAGS {
+	FFF_NONE = 0,
+	FFF_MEMRANGEOVERLAP = 1,		// "memrangeoverlap" FuncAnal Command was true
+};
+
+enum FUNC_FILE_OBJECTS {
+	FFO_DATA_BYTE = 0,				// CFuncDataByteObject
+	FFO_ASM_INST = 1,				// CFuncAsmInstObject
+};
+
+struct CBinaryFuncDescHeader {
+	char m_arrSignature[8];
+	uint32_t m_nByteOrder;
+	uint32_t m_nVersion;
+	uint32_t m_nFlags;				// FUNC_FILE_FLAGS
+	uint32_t m_nOpcodeSymbolSize;
+	uint32_t m_nDiffLevels;			// NUM_FUNC_DIFF_LEVELS of the diff symbols
+	uint32_t m_nStrings;
+	uint32_t m_nStringBytes;
+	uint32_t m_nBodyWords;
+	uint32_t m_nReserved1;
+	uint32_t m_nReserved2;
+};
+static_assert(sizeof(CBinaryFuncDescHeader) == 48, "Binary function file header must be 48 bytes");
+
+//////////////////////////////////////////////////////////////////////
+// CFuncBinaryWriter Class
+//////////////////////////////////////////////////////////////////////
+//		Accumulates the body of a Binary Function File, pooling the
+//		strings it references, until written out with writeFile().
+class CFuncBinaryWriter
+{
+public:
+	void write(uint32_t nValue) { m_arrBody.push_back(nValue); }
+	void write64(uint64_t nValue)
+	{
+		write(static_cast<uint32_t>(nValue));
+		write(static_cast<uint32_t>(nValue >> 32));
+	}
+
+	void writeString(const TString &strValue)
+	{
+		auto itrString = m_mapStrings.find(strValue);
+		if (itrString == m_mapStrings.end()) {
+			itrString = m_mapStrings.insert({ strValue, static_cast<uint32_t>(m_arrStrings.size()) }).first;
+			m_arrStrings.push_back(&itrString->first);
 		}
-		argv.push_back(strTemp);
+		write(itrString->second);
 	}
-}
+	void writeBytes(const TMemoryElement *pBytes, std::size_t nCount) { writeString(TString(pBytes, pBytes + nCount)); }
+
+	void writeLabels(const CLabelArray &arrLabels)
+	{
+		write(arrLabels.size());
+		for (auto const & strLabel : arrLabels) writeString(strLabel);
+	}
+
+	bool writeFile(std::ostream &outFile, uint32_t nFlags, uint32_t nOpcodeSymbolSize) const
+	{
+		std::vector<uint32_t> arrOffsets;
+		arrOffsets.reserve(m_arrStrings.size() + 1);
+		uint32_t nOffset = 0;
+		for (auto const & pString : m_arrStrings) {
+			arrOffsets.push_back(nOffset);
+			nOffset += pString->size();
+		}
+		arrOffsets.push_back(nOffset);
+		const uint32_t nStringBytes = ((nOffset + sizeof(uint32_t) - 1) / sizeof(uint32_t)) * sizeof(uint32_t);
+
+		CBinaryFuncDescHeader header;
+		std::memset(&header, 0, sizeof(header));
+		std::memcpy(header.m_arrSignature, g_arrFuncFileSignature, sizeof(header.m_arrSignature));
+		header.m_nByteOrder = g_nFuncFileByteOrder;
+		header.m_nVersion = g_nFuncFileVersion;
+		header.m_nFlags = nFlags;
+		header.m_nOpcodeSymbolSize = nOpcodeSymbolSize;
+		header.m_nDiffLevels = NUM_FUNC_DIFF_LEVELS;
+		header.m_nStrings = m_arrStrings.size();
+		header.m_nStringBytes = nStringBytes;
+		header.m_nBodyWords = m_arrBody.size();
+
+		outFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		outFile.write(reinterpret_cast<const char *>(arrOffsets.data()), arrOffsets.size() * sizeof(uint32_t));
+		for (auto const & pString : m_arrStrings) outFile.write(pString->data(), pString->size());
+		for ( ; nOffset < nStringBytes; ++nOffset) outFile.put(0);
+		outFile.write(reinterpret_cast<const char *>(m_arrBody.data()), m_arrBody.size() * sizeof(uint32_t));
+		return outFile.good();
+	}
+
+private:
+	std::vector<uint32_t> m_arrBody;
+	std::unordered_map<TString, uint32_t> m_mapStrings;		// String Pool index of each string
+	std::vector<const TString *> m_arrStrings;				// Strings in String Pool order (keys of m_mapStrings)
+};
+
+//////////////////////////////////////////////////////////////////////
+// CFuncBinaryReader Class
+//////////////////////////////////////////////////////////////////////
+//		Reads the body of a mapped Binary Function File.  Reading past
+//		the end of the body or referencing a string that isn't in the
+//		pool puts the reader in a failed state (see good()), while
+//		returning zero for values and empty strings, so that callers
+//		only need to check it once per table entry.
+class CFuncBinaryReader
+{
+public:
+	bool open(const void *pData, std::size_t nSize, TString &strError)
+	{
+		const uint8_t *pBytes = static_cast<const uint8_t *>(pData);
+		if (nSize < sizeof(CBinaryFuncDescHeader)) {
+			strError = "File too short for header";
+			return false;
+		}
+		std::memcpy(&m_header, pBytes, sizeof(m_header));
+		if (std::memcmp(m_header.m_arrSignature, g_arrFuncFileSignature, sizeof(m_header.m_arrSignature)) != 0) {
+			strError = "Not a binary function file";
+			return false;
+		}
+		if (m_header.m_nByteOrder != g_nFuncFileByteOrder) {
+			strError = "Function file was written on a machine with a different byte order";
+			return false;
+		}
+		if (m_header.m_nVersion != g_nFuncFileVersion) {
+			strError = "Unsupported function file version " + std::to_string(m_header.m_nVersion);
+			return false;
+		}
+		if (m_header.m_nDiffLevels != NUM_FUNC_DIFF_LEVELS) {
+			strError = "Function file was written with a different number of diff levels";
+			return false;
+		}
+		const std::size_t nOffsetsOffset = sizeof(CBinaryFuncDescHeader);
+		const std::size_t nStringsOffset = nOffsetsOffset + ((static_cast<std::size_t>(m_header.m_nStrings) + 1) * sizeof(uint32_t));
+		const std::size_t nBodyOffset = nStringsOffset + m_header.m_nStringBytes;
+		if ((m_header.m_nStringBytes % sizeof(uint32_t)) ||
+			(nSize != (nBodyOffset + (static_cast<std::size_t>(m_header.m_nBodyWords) * sizeof(uint32_t))))) {
+			strError = "File size doesn't match its header";
+			return false;
+		}
+
+		const uint32_t *pOffsets = reinterpret_cast<const uint32_t *>(pBytes + nOffsetsOffset);
+		const char *pStrings = reinterpret_cast<const char *>(pBytes + nStringsOffset);
+		m_arrStrings.clear();
+		m_arrStrings.reserve(m_header.m_nStrings);
+		for (uint32_t ndx = 0; ndx < m_header.m_nStrings; ++ndx) {
+			if ((pOffsets[ndx] > pOffsets[ndx+1]) || (pOffsets[ndx+1] > m_header.m_nStringBytes)) {
+				strError = "Invalid string pool";
+				return false;
+			}
+			m_arrStrings.emplace_back(pStrings + pOffsets[ndx], pOffsets[ndx+1] - pOffsets[ndx]);
+		}
+		m_arrSymbols.assign(m_arrStrings.size(), NO_SYMBOL);
+		m_arrStoreStrings.assign(m_arrStrings.size(), NO_STRING);
+
+		m_pBody = reinterpret_cast<const uint32_t *>(pBytes + nBodyOffset);
+		m_nBodyWords = m_header.m_nBodyWords;
+		m_nPos = 0;
+		m_bGood = true;
+		return true;
+	}
+
+	const CBinaryFuncDescHeader &header() const { return m_header; }
+	bool good() const { return m_bGood; }
+	void fail() { m_bGood = false; }		// Flags invalid content found by the caller
+	bool atEnd() const { return (m_nPos == m_nBodyWords); }
+
+	uint32_t read()
+	{
+		if (m_nPos >= m_nBodyWords) {
+			m_bGood = false;
+			return 0;
+		}
+		return m_pBody[m_nPos++];
+	}
+	uint64_t read64()
+	{
+		uint64_t nValue = read();
+		return (nValue | (static_cast<uint64_t>(read()) << 32));
+	}
+
+	// Table lengths are bounded by the remaining body, so that a corrupt
+	//	count can't cause a huge allocation:
+	uint32_t readCount()
+	{
+		uint32_t nCount = read();
+		if (nCount > (m_nBodyWords - m_nPos)) {
+			m_bGood = false;
+			return 0;
+		}
+		return nCount;
+	}
+
+	const TString &readString()
+	{
+		static const TString strEmpty;
+		uint32_t nIndex = read();
+		if (nIndex >= m_arrStrings.size()) {
+			m_bGood = false;
+			return strEmpty;
+		}
+		return m_arrStrings[nIndex];
+	}
+	CFuncByteSpan readBytes(CFuncObjectStore &aStore)
+	{
+		const TString &strBytes = readString();
+		return aStore.addBytes(reinterpret_cast<const TMemoryElement *>(strBytes.data()), strBytes.size());
+	}
+	// Interns each pooled string in the object store only the first time
+	//	it's used:
+	TFuncStringIndex readString(CFuncObjectStore &aStore)
+	{
+		uint32_t nIndex = read();
+		if (nIndex >= m_arrStrings.size()) {
+			m_bGood = false;
+			nIndex = 0;
+			if (m_arrStrings.empty()) return aStore.addString(TString());
+		}
+		if (m_arrStoreStrings[nIndex] == NO_STRING) m_arrStoreStrings[nIndex] = aStore.addString(m_arrStrings[nIndex]);
+		return m_arrStoreStrings[nIndex];
+	}
+	CLabelArray readLabels()
+	{
+		CLabelArray arrLabels;
+		uint32_t nCount = readCount();
+		arrLabels.reserve(nCount);
+		for (uint32_t ndx = 0; ndx < nCount; ++ndx) arrLabels.push_back(readString());
+		return arrLabels;
+	}
+
+	// Interns each pooled string only the first time it's used as a
+	//	diff symbol:
+	TDiffSymbol readSymbol(CDiffSymbolPool &aPool)
+	{
+		uint32_t nIndex = read();
+		if (nIndex >= m_arrStrings.size()) {
+			m_bGood = false;
+			return 0;
+		}
+		if (m_arrSymbols[nIndex] == NO_SYMBOL) m_arrSymbols[nIndex] = aPool.intern(m_arrStrings[nIndex]);
+		return m_arrSymbols[nIndex];
+	}
+
+private:
+	static constexpr TDiffSymbol NO_SYMBOL = static_cast<TDiffSymbol>(-1);
+	static constexpr TFuncStringIndex NO_STRING = static_cast<TFuncStringIndex>(-1);
+
+	CBinaryFuncDescHeader m_header = {};
+	CStringArray m_arrStrings;					// String Pool
+	std::vector<TDiffSymbol> m_arrSymbols;		// Interned diff symbol of each String Pool entry, or NO_SYMBOL if not yet used as one
+	std::vector<TFuncStringIndex> m_arrStoreStrings;	// Object store index of each String Pool entry, or NO_STRING if not yet used as one
+	const uint32_t *m_pBody = nullptr;
+	uint32_t m_nBodyWords = 0;
+	uint32_t m_nPos = 0;
+	bool m_bGood = false;
+};
 
 
 //////////////////////////////////////////////////////////////////////
@@ -273,9 +578,9 @@ bool CIndirectEntry::AddLabel(const TLabel &strLabel)
 // CFuncObject Class
 //////////////////////////////////////////////////////////////////////
 
-CFuncObject::CFuncObject(std::shared_ptr<const CFuncDescFile> pParentFuncFile, std::shared_ptr<const CFuncDesc> pParentFunc, CStringArray &argv)
-	:	m_pParentFuncFile(pParentFuncFile),
-		m_pParentFunc(pParentFunc)
+CFuncObject::CFuncObject(CFuncObjectStore &aStore, const CFuncDescFile &aParentFuncFile, const CFuncDesc &aParentFunc, CStringArray &argv)
+	:	m_pParentFuncFile(&aParentFuncFile),
+		m_pParentFunc(&aParentFunc)
 {
 	assert(argv.size() >= 4);
 	CStringArray arrstrLabels;
@@ -286,17 +591,37 @@ CFuncObject::CFuncObject(std::shared_ptr<const CFuncDescFile> pParentFuncFile, s
 		ParseLine(argv.at(2), ',', arrstrLabels);
 		for (auto const &itrLabel : arrstrLabels) AddLabel(itrLabel);
 	}
-	if (argv.size() >= 4) {
-		TString strTemp = argv.at(3);
-		for (TString::size_type ndx = 0; ndx < strTemp.size()/2; ++ndx) {
-			m_Bytes.push_back(strtoul(strTemp.substr(ndx*2, 2).c_str(), nullptr, 16));
-		}
-	}
+	if (argv.size() >= 4) m_Bytes = aStore.addHexBytes(argv.at(3));
+}
+
+CFuncObject::CFuncObject(CFuncObjectStore &aStore, const CFuncDescFile &aParentFuncFile, const CFuncDesc &aParentFunc, CFuncBinaryReader &aReader)
+	:	m_pParentFuncFile(&aParentFuncFile),
+		m_pParentFunc(&aParentFunc)
+{
+	m_nRelFuncAddress = aReader.read();
+	m_nAbsAddress = aReader.read();
+	m_arrLabelTable = aReader.readLabels();
+	m_Bytes = aReader.readBytes(aStore);
+}
+
+const CFuncObjectStore &CFuncObject::store() const
+{
+	return m_pParentFuncFile->objectStore();
+}
+
+void CFuncObject::WriteBinaryCommon(CFuncBinaryWriter &aWriter) const
+{
+	aWriter.write(m_nRelFuncAddress);
+	aWriter.write(m_nAbsAddress);
+	aWriter.writeLabels(m_arrLabelTable);
+	aWriter.writeBytes(store().bytes(m_Bytes), m_Bytes.m_nCount);
 }
 
 bool CFuncObject::isExactMatch(const CFuncObject &obj) const
 {
-	return (m_Bytes == obj.m_Bytes);
+	const TMemoryElement *pBytes = store().bytes(m_Bytes);
+	const TMemoryElement *pObjBytes = obj.store().bytes(obj.m_Bytes);
+	return std::equal(pBytes, pBytes + m_Bytes.m_nCount, pObjBytes, pObjBytes + obj.m_Bytes.m_nCount);
 }
 
 bool CFuncObject::AddLabel(const TLabel &strLabel)
@@ -310,13 +635,21 @@ bool CFuncObject::AddLabel(const TLabel &strLabel)
 	return true;
 }
 
-TString CFuncObject::GetBytes() const
+// Formats bytes as uppercase hex digit pairs:
+static TString hexBytesString(const TMemoryElement *pBytes, std::size_t nCount)
 {
-	std::ostringstream ssTemp;
-	for (auto const &itrByte : m_Bytes) {
-		ssTemp << std::uppercase << std::setfill('0') << std::setw(2) << std::setbase(16) << static_cast<unsigned int>(itrByte);
+	static constexpr char arrHexDigits[] = "0123456789ABCDEF";
+	TString strHex(nCount*2, '0');
+	for (std::size_t ndx = 0; ndx < nCount; ++ndx) {
+		strHex[ndx*2] = arrHexDigits[(pBytes[ndx] >> 4) & 0x0F];
+		strHex[ndx*2+1] = arrHexDigits[pBytes[ndx] & 0x0F];
 	}
-	return ssTemp.str();
+	return strHex;
+}
+
+TString CFuncObject::GetBytes() const
+{
+	return hexBytesString(store().bytes(m_Bytes), m_Bytes.m_nCount);
 }
 
 CSymbolArray CFuncObject::GetSymbols() const
@@ -358,27 +691,60 @@ int CFuncObject::GetFieldWidth(FIELD_CODE nFC)
 // CFuncAsmInstObject Class
 //////////////////////////////////////////////////////////////////////
 
-CFuncAsmInstObject::CFuncAsmInstObject(std::shared_ptr<const CFuncDescFile> pParentFuncFile, std::shared_ptr<const CFuncDesc> pParentFunc, CStringArray &argv)
-	:	CFuncObject(pParentFuncFile, pParentFunc, argv)
+CFuncAsmInstObject::CFuncAsmInstObject(CFuncObjectStore &aStore, const CFuncDescFile &aParentFuncFile, const CFuncDesc &aParentFunc, CStringArray &argv)
+	:	CFuncObject(aStore, aParentFuncFile, aParentFunc, argv)
 {
 	assert(argv.size() >= 10);
 
-	if (argv.size() >= 5) {
-		TString strTemp = argv.at(4);
-		for (TString::size_type ndx = 0; ndx < strTemp.size()/2; ++ndx) {
-			m_OpCodeBytes.push_back(strtoul(strTemp.substr(ndx*2, 2).c_str(), nullptr, 16));
-		}
-	}
-	if (argv.size() >= 6) {
-		TString strTemp = argv.at(5);
-		for (TString::size_type ndx = 0; ndx < strTemp.size()/2; ++ndx) {
-			m_OperandBytes.push_back(strtoul(strTemp.substr(ndx*2, 2).c_str(), nullptr, 16));
-		}
-	}
-	if (argv.size() >= 7) m_strDstOperand = argv.at(6);
-	if (argv.size() >= 8) m_strSrcOperand = argv.at(7);
-	if (argv.size() >= 9) m_strOpCodeText = argv.at(8);
-	if (argv.size() >= 10) m_strOperandText = argv.at(9);
+	if (argv.size() >= 5) m_OpCodeBytes = aStore.addHexBytes(argv.at(4));
+	if (argv.size() >= 6) m_OperandBytes = aStore.addHexBytes(argv.at(5));
+	m_nDstOperand = aStore.addString((argv.size() >= 7) ? argv.at(6) : TString());
+	m_nSrcOperand = aStore.addString((argv.size() >= 8) ? argv.at(7) : TString());
+	m_nOpCodeText = aStore.addString((argv.size() >= 9) ? argv.at(8) : TString());
+	m_nOperandText = aStore.addString((argv.size() >= 10) ? argv.at(9) : TString());
+}
+
+CFuncAsmInstObject::CFuncAsmInstObject(CFuncObjectStore &aStore, const CFuncDescFile &aParentFuncFile, const CFuncDesc &aParentFunc, CFuncBinaryReader &aReader)
+	:	CFuncObject(aStore, aParentFuncFile, aParentFunc, aReader)
+{
+	m_OpCodeBytes = aReader.readBytes(aStore);
+	m_OperandBytes = aReader.readBytes(aStore);
+	m_nDstOperand = aReader.readString(aStore);
+	m_nSrcOperand = aReader.readString(aStore);
+	m_nOpCodeText = aReader.readString(aStore);
+	m_nOperandText = aReader.readString(aStore);
+}
+
+const TString &CFuncAsmInstObject::GetDstOperand() const
+{
+	return store().string(m_nDstOperand);
+}
+
+const TString &CFuncAsmInstObject::GetSrcOperand() const
+{
+	return store().string(m_nSrcOperand);
+}
+
+const TString &CFuncAsmInstObject::GetOpCodeText() const
+{
+	return store().string(m_nOpCodeText);
+}
+
+const TString &CFuncAsmInstObject::GetOperandText() const
+{
+	return store().string(m_nOperandText);
+}
+
+void CFuncAsmInstObject::WriteBinary(CFuncBinaryWriter &aWriter) const
+{
+	aWriter.write(FFO_ASM_INST);
+	WriteBinaryCommon(aWriter);
+	aWriter.writeBytes(store().bytes(m_OpCodeBytes), m_OpCodeBytes.m_nCount);
+	aWriter.writeBytes(store().bytes(m_OperandBytes), m_OperandBytes.m_nCount);
+	aWriter.writeString(GetDstOperand());
+	aWriter.writeString(GetSrcOperand());
+	aWriter.writeString(GetOpCodeText());
+	aWriter.writeString(GetOperandText());
 }
 
 TString CFuncAsmInstObject::ExportToDiff(FUNC_DIFF_LEVEL nLevel) const
@@ -399,10 +765,10 @@ TString CFuncAsmInstObject::ExportToDiff(FUNC_DIFF_LEVEL nLevel) const
 	for (int i=0; i<2; i++) {
 		switch (i) {
 			case 0:
-				strTemp = m_strDstOperand;
+				strTemp = GetDstOperand();
 				break;
 			case 1:
-				strTemp = m_strSrcOperand;
+				strTemp = GetSrcOperand();
 				break;
 		}
 
@@ -647,8 +1013,8 @@ TString CFuncAsmInstObject::CreateOutputLine(OUTPUT_OPTIONS nOutputOptions) cons
 
 	TString strTemp = m_pParentFunc->GetPrimaryLabel(m_nAbsAddress);
 	strRetVal += padString(strTemp + ((!strTemp.empty()) ? ": " : " "), GetFieldWidth(FIELD_CODE::FC_LABEL));
-	strRetVal += padString(m_strOpCodeText + " ", GetFieldWidth(FIELD_CODE::FC_MNEMONIC));
-	strRetVal += padString(m_strOperandText, GetFieldWidth(FIELD_CODE::FC_OPERANDS));
+	strRetVal += padString(GetOpCodeText() + " ", GetFieldWidth(FIELD_CODE::FC_MNEMONIC));
+	strRetVal += padString(GetOperandText(), GetFieldWidth(FIELD_CODE::FC_OPERANDS));
 
 	return strRetVal;
 }
@@ -670,11 +1036,11 @@ CSymbolArray CFuncAsmInstObject::GetSymbols() const
 	for (int i=0; i<2; i++) {
 		switch (i) {
 			case 0:
-				strTemp = m_strDstOperand;
+				strTemp = GetDstOperand();
 				strLabelPrefix = "RD";
 				break;
 			case 1:
-				strTemp = m_strSrcOperand;
+				strTemp = GetSrcOperand();
 				strLabelPrefix = "RS";
 				break;
 		}
@@ -785,26 +1151,24 @@ CSymbolArray CFuncAsmInstObject::GetSymbols() const
 
 TString CFuncAsmInstObject::GetOpCodeBytes() const
 {
-	std::ostringstream ssTemp;
-	for (auto const &itrByte : m_OpCodeBytes) {
-		ssTemp << std::uppercase << std::setfill('0') << std::setw(2) << std::setbase(16) << static_cast<unsigned int>(itrByte);
-	}
-	return ssTemp.str();
+	return hexBytesString(store().bytes(m_OpCodeBytes), m_OpCodeBytes.m_nCount);
 }
 
 TString CFuncAsmInstObject::GetOperandBytes() const
 {
-	std::ostringstream ssTemp;
-	for (auto const &itrByte : m_OperandBytes) {
-		ssTemp << std::uppercase << std::setfill('0') << std::setw(2) << std::setbase(16) << static_cast<unsigned int>(itrByte);
-	}
-	return ssTemp.str();
+	return hexBytesString(store().bytes(m_OperandBytes), m_OperandBytes.m_nCount);
 }
 
 
 //////////////////////////////////////////////////////////////////////
 // CFuncDataByteObject Class
 //////////////////////////////////////////////////////////////////////
+void CFuncDataByteObject::WriteBinary(CFuncBinaryWriter &aWriter) const
+{
+	aWriter.write(FFO_DATA_BYTE);
+	WriteBinaryCommon(aWriter);
+}
+
 TString CFuncDataByteObject::ExportToDiff(FUNC_DIFF_LEVEL nLevel) const
 {
 	UNUSED(nLevel);
@@ -830,9 +1194,10 @@ TString CFuncDataByteObject::CreateOutputLine(OUTPUT_OPTIONS nOutputOptions) con
 	strRetVal += padString(strTemp + ((!strTemp.empty()) ? ": " : " "), GetFieldWidth(FIELD_CODE::FC_LABEL));
 	strRetVal += padString(".data ", GetFieldWidth(FIELD_CODE::FC_MNEMONIC));
 	strTemp.clear();
-	for (auto const &itrBytes : m_Bytes) {
+	const TMemoryElement *pBytes = store().bytes(m_Bytes);
+	for (uint32_t ndx = 0; ndx < m_Bytes.m_nCount; ++ndx) {
 		if (!strTemp.empty()) strTemp += ", ";
-		std::sprintf(arrTemp, "0x%02X", itrBytes);
+		std::sprintf(arrTemp, "0x%02X", pBytes[ndx]);
 		strTemp += arrTemp;
 	}
 	strRetVal += padString(strTemp, GetFieldWidth(FIELD_CODE::FC_OPERANDS));
@@ -841,6 +1206,77 @@ TString CFuncDataByteObject::CreateOutputLine(OUTPUT_OPTIONS nOutputOptions) con
 }
 
 
+//////////////////////////////////////////////////////////////////////
+// CFuncObjectStore Class
+//////////////////////////////////////////////////////////////////////
+
+CFuncByteSpan CFuncObjectStore::addBytes(const TMemoryElement *pBytes, std::size_t nCount)
+{
+	CFuncByteSpan aSpan{ static_cast<uint32_t>(m_arrBytes.size()), static_cast<uint32_t>(nCount) };
+	m_arrBytes.insert(m_arrBytes.end(), pBytes, pBytes + nCount);
+	return aSpan;
+}
+
+CFuncByteSpan CFuncObjectStore::addHexBytes(const TString &strHexBytes)
+{
+	auto &&fnHexDigit = [](char ch)->int {
+		if ((ch >= '0') && (ch <= '9')) return (ch - '0');
+		if ((ch >= 'A') && (ch <= 'F')) return (ch - 'A' + 10);
+		if ((ch >= 'a') && (ch <= 'f')) return (ch - 'a' + 10);
+		return -1;
+	};
+
+	CFuncByteSpan aSpan{ static_cast<uint32_t>(m_arrBytes.size()), static_cast<uint32_t>(strHexBytes.size()/2) };
+	for (TString::size_type ndx = 0; ndx < aSpan.m_nCount; ++ndx) {
+		// Same as strtoul() of each pair, which stops at the first non-hex digit:
+		int nHigh = fnHexDigit(strHexBytes[ndx*2]);
+		int nLow = fnHexDigit(strHexBytes[ndx*2+1]);
+		if (nHigh < 0) {
+			m_arrBytes.push_back(0);
+		} else if (nLow < 0) {
+			m_arrBytes.push_back(nHigh);
+		} else {
+			m_arrBytes.push_back((nHigh << 4) | nLow);
+		}
+	}
+	return aSpan;
+}
+
+TFuncStringIndex CFuncObjectStore::addString(const TString &strValue)
+{
+	auto itrString = m_mapStrings.find(strValue);
+	if (itrString != m_mapStrings.end()) return itrString->second;
+
+	TFuncStringIndex nIndex = static_cast<TFuncStringIndex>(m_arrStrings.size());
+	m_mapStrings[m_arrStrings.emplace_back(strValue)] = nIndex;
+	return nIndex;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// CDiffSymbolPool Class
+//////////////////////////////////////////////////////////////////////
+
+TDiffSymbol CDiffSymbolPool::intern(TString strSymbol)
+{
+	makeUpper(strSymbol);
+
+	std::lock_guard<std::mutex> lock(m_mtxSymbols);
+	auto itrSymbol = m_mapSymbols.find(strSymbol);
+	if (itrSymbol != m_mapSymbols.end()) return itrSymbol->second;
+
+	TDiffSymbol nSymbol = static_cast<TDiffSymbol>(m_mapSymbols.size());
+	m_mapSymbols[strSymbol] = nSymbol;
+	return nSymbol;
+}
+
+CDiffSymbolPool &CDiffSymbolPool::instance()
+{
+	static CDiffSymbolPool thePool;
+	return thePool;
+}
+
+
 //////////////////////////////////////////////////////////////////////
 // CFuncDesc Class
 //////////////////////////////////////////////////////////////////////
@@ -948,7 +1384,51 @@ void CFuncDesc::ExportToDiff(FUNC_DIFF_LEVEL nLevel, CStringArray &anArray) cons
 	}
 }
 
-void CFuncDesc::Add(std::shared_ptr<CFuncObject> pObj)
+void CFuncDesc::ExportToDiffSymbols(CDiffSymbolPool &aPool, CDiffSymbolArray &anArray, TContentHash *pContentHash) const
+{
+	anArray.clear();
+	anArray.reserve(size() * NUM_DIFF_SYMBOL_SLOTS);
+	if (pContentHash) *pContentHash = CONTENT_HASH_INIT;
+
+	auto &&fnAddSymbol = [&](const TString &strSymbol)->void {
+		anArray.push_back(aPool.intern(strSymbol));
+		if (pContentHash) *pContentHash = hashContent(makeUpperCopy(strSymbol), *pContentHash);
+	};
+
+	for (auto const &itrObject : *this) {
+		for (int nSlot = 0; nSlot < NUM_DIFF_SYMBOL_SLOTS; ++nSlot) {
+			fnAddSymbol(diffSymbolString(*itrObject, nSlot));
+		}
+	}
+}
+
+void CFuncDesc::BuildDiffSymbols(CDiffSymbolPool &aPool)
+{
+	CDiffSymbolArray arrDiffSymbols;
+	TContentHash nContentHash;
+	ExportToDiffSymbols(aPool, arrDiffSymbols, &nContentHash);
+	SetDiffSymbols(std::move(arrDiffSymbols), nContentHash);
+}
+
+void CFuncDesc::SetDiffSymbols(CDiffSymbolArray &&arrDiffSymbols, TContentHash nContentHash)
+{
+	assert(arrDiffSymbols.size() == (size() * NUM_DIFF_SYMBOL_SLOTS));
+	m_arrDiffSymbols = std::move(arrDiffSymbols);
+	m_nContentHash = nContentHash;
+
+	for (int nSlot = 0; nSlot < NUM_DIFF_SYMBOL_SLOTS; ++nSlot) {
+		CDiffSymbolArray &arrSet = m_arrDiffSymbolSets[nSlot];
+		arrSet.clear();
+		arrSet.reserve(size());
+		for (CDiffSymbolArray::size_type ndx = nSlot; ndx < m_arrDiffSymbols.size(); ndx += NUM_DIFF_SYMBOL_SLOTS) {
+			arrSet.push_back(m_arrDiffSymbols.at(ndx));
+		}
+		std::sort(arrSet.begin(), arrSet.end());
+		arrSet.erase(std::unique(arrSet.begin(), arrSet.end()), arrSet.end());
+	}
+}
+
+void CFuncDesc::Add(CFuncObject *pObj)
 {
 	for (CLabelArray::size_type i=0; i<pObj->GetLabelCount(); i++) {
 		AddLabel(pObj->GetAbsAddress(), pObj->GetLabel(i));
@@ -957,6 +1437,30 @@ void CFuncDesc::Add(std::shared_ptr<CFuncObject> pObj)
 	push_back(pObj);
 }
 
+void CFuncDesc::WriteBinary(CFuncBinaryWriter &aWriter) const
+{
+	assert(HasDiffSymbols());
+
+	aWriter.write(m_nMainAddress);
+	aWriter.write(m_mapFuncNameTable.size());
+	for (auto const & itrNames : m_mapFuncNameTable) {
+		aWriter.write(itrNames.first);
+		aWriter.writeLabels(itrNames.second);
+	}
+
+	aWriter.write(size());
+	for (auto const & itrObject : *this) itrObject->WriteBinary(aWriter);
+
+	// The diff symbols themselves are only valid within this run, so
+	//	write their strings, already uppercased as they are interned:
+	aWriter.write64(m_nContentHash);
+	for (auto const & itrObject : *this) {
+		for (int nSlot = 0; nSlot < NUM_DIFF_SYMBOL_SLOTS; ++nSlot) {
+			aWriter.writeString(makeUpperCopy(diffSymbolString(*itrObject, nSlot)));
+		}
+	}
+}
+
 
 //////////////////////////////////////////////////////////////////////
 // CFuncDescFile Class
@@ -964,10 +1468,15 @@ void CFuncDesc::Add(std::shared_ptr<CFuncObject> pObj)
 
 bool CFuncDescFile::ReadFuncDescFile(std::shared_ptr<CFuncDescFile> pThis, ifstreamFuncDescFile &inFile, std::ostream *msgFile, std::ostream *errFile, int nStartLineCount)
 {
+	return ReadFuncDescFile(pThis, inFile, inFile.getFilename(), msgFile, errFile, nStartLineCount);
+}
+
+bool CFuncDescFile::ReadFuncDescFile(std::shared_ptr<CFuncDescFile> pThis, std::istream &inFile, const std::string &strFilename, std::ostream *msgFile, std::ostream *errFile, int nStartLineCount)
+{
+	CPerfStats::CPhase phase("ReadFuncDescFile");
 	bool bRetVal = true;
 	TString strError = g_strUnexpectedError;
 	int nLineCount = nStartLineCount;
-	TString strLine;
 	CStringArray argv;
 	TAddress nAddress;
 	TSize nSize;
@@ -978,16 +1487,44 @@ bool CFuncDescFile::ReadFuncDescFile(std::shared_ptr<CFuncDescFile> pThis, ifstr
 	constexpr int BUSY_CALLBACK_RATE = 50;
 
 	if (msgFile) {
-		(*msgFile) << "Reading Function Definition File " << std::filesystem::relative(inFile.getFilename()) << "...\n";
+		(*msgFile) << "Reading Function Definition File " << std::filesystem::relative(strFilename) << "...\n";
 	}
 
-	m_strFilePathName = std::filesystem::path(inFile.getFilename()).relative_path();
-	m_strFileName = std::filesystem::path(inFile.getFilename()).filename();
+	SetFilename(strFilename);
+
+	// Read the whole file and split it into trimmed lines, noting where
+	//	each function and data block declaration starts a new section.  The
+	//	object lines of the sections are split into their fields on the
+	//	m_nReadThreads threads, but that's the only part of reading them
+	//	that is parallel.  The objects are all built by the loop below,
+	//	serially in file order, since every object adds its bytes and
+	//	strings to the one m_ObjectStore of the file (and labels to the
+	//	file's tables).  BuildDiffSymbols() is parallel again after that:
+	const std::string strText((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+	std::vector<std::string_view> arrLines;
+	std::vector<std::size_t> arrSections(1, 0);		// First line of each section
+	for (std::size_t nPos = 0; nPos <= strText.size(); ) {		// Note: Like getline(), "a\n" is two lines with the second empty
+		std::size_t nEndPos = strText.find('\n', nPos);
+		if (nEndPos == std::string::npos) nEndPos = strText.size();
+		std::string_view strView(strText.data() + nPos, nEndPos - nPos);
+		trim(strView);
+		if (!strView.empty() && ((strView.front() == '@') || (strView.front() == '$'))) arrSections.push_back(arrLines.size());
+		arrLines.push_back(strView);
+		nPos = nEndPos + 1;
+	}
+
+	std::vector<CStringArray> arrObjectFields(arrLines.size());		// Fields of the lines that can be objects (those starting with a hex digit)
+	runParallelThreads(arrSections.size(), m_nReadThreads, [&](std::size_t ndxSection)->void {
+		const std::size_t ndxEndLine = (((ndxSection+1) < arrSections.size()) ? arrSections.at(ndxSection+1) : arrLines.size());
+		for (std::size_t ndxLine = arrSections.at(ndxSection); ndxLine < ndxEndLine; ++ndxLine) {
+			const std::string_view strLine = arrLines[ndxLine];
+			if (!strLine.empty() && isxdigit(strLine.front())) ParseLine(strLine, '|', arrObjectFields[ndxLine]);
+		}
+	}, "Split Function Definition Lines");
 
-	while (bRetVal && inFile.good() && !inFile.eof()) {
-		std::getline(inFile, strLine);
+	for (std::size_t ndxLine = 0; bRetVal && (ndxLine < arrLines.size()); ++ndxLine) {
+		const std::string_view strLine = arrLines[ndxLine];
 		nLineCount++;
-		trim(strLine);
 
 		if ((m_pfnProgressCallback) && ((nLineCount % BUSY_CALLBACK_RATE) == 0))
 			m_pfnProgressCallback(0, 1, false, m_nUserDataProgressCallback);
@@ -1218,7 +1755,7 @@ bool CFuncDescFile::ReadFuncDescFile(std::shared_ptr<CFuncDescFile> pThis, ifstr
 				if (pCurrentFunction) {
 					// If we are in a function, parse entry:
 					if (isxdigit(strLine.at(0))) {
-						ParseLine(strLine, '|', argv);
+						argv = std::move(arrObjectFields[ndxLine]);
 						if ((argv.size() != 4) &&
 							(argv.size() != 10)) {
 							strError = g_strSyntaxError;
@@ -1227,9 +1764,9 @@ bool CFuncDescFile::ReadFuncDescFile(std::shared_ptr<CFuncDescFile> pThis, ifstr
 						}
 
 						if (argv.size() == 4) {
-							pCurrentFunction->Add(std::make_shared<CFuncDataByteObject>(pThis, pCurrentFunction, argv));
+							pCurrentFunction->Add(m_ObjectStore.newObject<CFuncDataByteObject>(*pThis, *pCurrentFunction, argv));
 						} else {
-							std::shared_ptr<CFuncAsmInstObject> pAsmInst = std::make_shared<CFuncAsmInstObject>(pThis, pCurrentFunction, argv);
+							CFuncAsmInstObject *pAsmInst = m_ObjectStore.newObject<CFuncAsmInstObject>(*pThis, *pCurrentFunction, argv);
 							pCurrentFunction->Add(pAsmInst);
 							assert(pThis->opcodeSymbolSize() > 0);
 							if (pAsmInst->GetOpCodeByteCount() % pThis->opcodeSymbolSize()) {
@@ -1244,13 +1781,13 @@ bool CFuncDescFile::ReadFuncDescFile(std::shared_ptr<CFuncDescFile> pThis, ifstr
 				} else {
 					// If we are in a Data Block, parse entry:
 					if (isxdigit(strLine.at(0))) {
-						ParseLine(strLine, '|', argv);
+						argv = std::move(arrObjectFields[ndxLine]);
 						if (argv.size() != 4) {
 							strError = g_strSyntaxError;
 							bRetVal = false;
 							break;
 						}
-						pCurrentDataBlock->Add(std::make_shared<CFuncDataByteObject>(pThis, pCurrentDataBlock, argv));
+						pCurrentDataBlock->Add(m_ObjectStore.newObject<CFuncDataByteObject>(*pThis, *pCurrentDataBlock, argv));
 					} else {
 						strError = g_strSyntaxError;
 						bRetVal = false;
@@ -1264,81 +1801,320 @@ bool CFuncDescFile::ReadFuncDescFile(std::shared_ptr<CFuncDescFile> pThis, ifstr
 	}
 	assert(m_mapSortedFunctionMap.size() == m_arrFunctions.size());
 
-	if ((bRetVal) && (msgFile)) {
-		if (allowMemRangeOverlap()) {
-			(*msgFile) << "\n    Allowing Memory Range Overlaps\n";
+	// Now that all functions, data blocks, and labels are known, tokenize
+	//	the objects for the comparison logic.  This can't be done as they are
+	//	added since ExportToDiff() depends on the complete function size and
+	//	file label table.  Each is independent, so they are built on the
+	//	m_nReadThreads threads, largest functions first.  The symbols are
+	//	only ever compared for equality, so it doesn't matter that their
+	//	values depend on the order they're first interned in:
+	if (bRetVal) {
+		std::vector<CFuncDesc *> arrToBuild;
+		arrToBuild.reserve(m_arrFunctions.size() + m_arrDataBlocks.size());
+		for (auto const & itrFunc : m_mapSortedFunctionMap) arrToBuild.push_back(m_arrFunctions.at(itrFunc.second).get());
+		for (auto const & data : m_arrDataBlocks) arrToBuild.push_back(data.get());
+		runParallelThreads(arrToBuild.size(), m_nReadThreads, [&](std::size_t ndx)->void {
+			arrToBuild.at(ndx)->BuildDiffSymbols(CDiffSymbolPool::instance());
+		}, "Build Diff Symbols");
+	}
+
+	if ((bRetVal) && (msgFile)) ReportContents(*msgFile);
+
+	if (!bRetVal && errFile) {
+		(*errFile) << "*** Error: " << strError << " : on line " << nLineCount << " of file\n"
+					  "           \"" << std::filesystem::relative(strFilename) << "\"\n";
+	}
+
+	return bRetVal;
+}
+
+void CFuncDescFile::SetFilename(const TString &strFilename)
+{
+	m_strFilePathName = std::filesystem::path(strFilename).relative_path();
+	m_strFileName = std::filesystem::path(strFilename).filename();
+}
+
+void CFuncDescFile::ReportContents(std::ostream &msgFile) const
+{
+	if (allowMemRangeOverlap()) {
+		msgFile << "\n    Allowing Memory Range Overlaps\n";
+	}
+	if (opcodeSymbolSize() > 1) {
+		msgFile << "\n    Opcode Symbol Size: " << opcodeSymbolSize() << "\n";
+	}
+
+	msgFile << "\n    Memory Mappings:\n";
+
+	for (int nMemType = 0; nMemType < MEMORY_TYPE::NUM_MEMORY_TYPES; ++nMemType) {
+		msgFile << "        ";
+		for (std::string::size_type i = (getLongestMemMapName() - g_arrstrMemRanges[nMemType].size()); i; --i) {
+			msgFile << " ";
 		}
-		if (opcodeSymbolSize() > 1) {
-			(*msgFile) << "\n    Opcode Symbol Size: " << opcodeSymbolSize() << "\n";
+		msgFile << g_arrstrMemRanges[nMemType] << " Memory Map:";
+
+		if (m_MemoryRanges[nMemType].isNullRange()) {
+			msgFile << " <Not Defined>\n";
+		} else {
+			msgFile << "\n";
+			for (auto const & itr : m_MemoryRanges[nMemType]) {
+				msgFile << "            0x"
+							<< std::uppercase << std::setfill('0') << std::setw(4) << std::setbase(16) << itr.startAddr()
+							<< std::nouppercase << std::setbase(0) << " - 0x"
+							<< std::uppercase << std::setfill('0') << std::setw(4) << std::setbase(16) << (itr.startAddr() + itr.size() - 1)
+							<< std::nouppercase << std::setbase(0) << "  (Size: 0x"
+							<< std::uppercase << std::setfill('0') << std::setw(4) << std::setbase(16) << itr.size()
+							<< std::nouppercase << std::setbase(0) << ")\n";
+			}
 		}
+	}
 
-		(*msgFile) << "\n    Memory Mappings:\n";
+	msgFile << "\n    " << m_arrFunctions.size() << " Function"
+				<< ((m_arrFunctions.size() != 1) ? "s" : "") << " Defined"
+				<< ((m_arrFunctions.size() != 0) ? ":" : "") << "\n";
 
-		for (int nMemType = 0; nMemType < MEMORY_TYPE::NUM_MEMORY_TYPES; ++nMemType) {
-			(*msgFile) << "        ";
-			for (std::string::size_type i = (getLongestMemMapName() - g_arrstrMemRanges[nMemType].size()); i; --i) {
-				(*msgFile) << " ";
+	for (auto const & func : m_arrFunctions) {
+		msgFile << "        0x"
+					<< std::uppercase << std::setfill('0') << std::setw(4) << std::setbase(16) << func->GetMainAddress()
+					<< std::nouppercase << std::setbase(0)
+					<< " -> " << func->GetMainName() << "\n";
+	}
+
+	for (int nMemType = 0; nMemType < MEMORY_TYPE::NUM_MEMORY_TYPES; ++nMemType) {
+		msgFile << "\n";
+		msgFile << "    " << m_mapLabelTable[nMemType].size()
+					<< " Unique " << g_arrstrMemRanges[nMemType] << " Label"
+					<< ((m_mapLabelTable[nMemType].size() != 1) ? "s" : "") << " Defined"
+					<< ((m_mapLabelTable[nMemType].size() != 0) ? ":" : "") << "\n";
+		for (auto const & labelList : m_mapLabelTable[nMemType]) {
+			msgFile << "        0x"
+						<< std::uppercase << std::setfill('0') << std::setw(4) << std::setbase(16) << labelList.first
+						<< std::nouppercase << std::setbase(0)
+						<< "=";
+			bool bFirst = true;
+			for (auto const & label : labelList.second) {
+				msgFile << (!bFirst ? "," : "") << label;
+				bFirst = false;
 			}
-			(*msgFile) << g_arrstrMemRanges[nMemType] << " Memory Map:";
+			msgFile << "\n";
+		}
+	}
 
-			if (m_MemoryRanges[nMemType].isNullRange()) {
-				(*msgFile) << " <Not Defined>\n";
-			} else {
-				(*msgFile) << "\n";
-				for (auto const & itr : m_MemoryRanges[nMemType]) {
-					(*msgFile) << "            0x"
-								<< std::uppercase << std::setfill('0') << std::setw(4) << std::setbase(16) << itr.startAddr()
-								<< std::nouppercase << std::setbase(0) << " - 0x"
-								<< std::uppercase << std::setfill('0') << std::setw(4) << std::setbase(16) << (itr.startAddr() + itr.size() - 1)
-								<< std::nouppercase << std::setbase(0) << "  (Size: 0x"
-								<< std::uppercase << std::setfill('0') << std::setw(4) << std::setbase(16) << itr.size()
-								<< std::nouppercase << std::setbase(0) << ")\n";
-				}
+	msgFile << "\n";
+}
+
+bool CFuncDescFile::isBinaryFile(const TString &strFilename)
+{
+	std::ifstream fileIn(strFilename, std::ios_base::in | std::ios_base::binary);
+	char arrSignature[sizeof(g_arrFuncFileSignature)];
+	if (!fileIn.read(arrSignature, sizeof(arrSignature))) return false;
+	return (std::memcmp(arrSignature, g_arrFuncFileSignature, sizeof(arrSignature)) == 0);
+}
+
+bool CFuncDescFile::WriteBinaryFile(std::ostream &outFile) const
+{
+	CPerfStats::CPhase phase("WriteBinaryFile");
+	CFuncBinaryWriter aWriter;
+
+	TSize nMemRanges = 0;
+	for (int nMemType = 0; nMemType < MEMORY_TYPE::NUM_MEMORY_TYPES; ++nMemType) nMemRanges += m_MemoryRanges[nMemType].size();
+	aWriter.write(nMemRanges);
+	for (int nMemType = 0; nMemType < MEMORY_TYPE::NUM_MEMORY_TYPES; ++nMemType) {
+		for (auto const & itrRange : m_MemoryRanges[nMemType]) {
+			aWriter.write(nMemType);
+			aWriter.write(itrRange.startAddr());
+			aWriter.write64(itrRange.size());
+		}
+	}
+
+	TSize nLabels = 0;
+	for (int nMemType = 0; nMemType < MEMORY_TYPE::NUM_MEMORY_TYPES; ++nMemType) nLabels += m_mapLabelTable[nMemType].size();
+	aWriter.write(nLabels);
+	for (int nMemType = 0; nMemType < MEMORY_TYPE::NUM_MEMORY_TYPES; ++nMemType) {
+		for (auto const & itrLabels : m_mapLabelTable[nMemType]) {
+			aWriter.write(nMemType);
+			aWriter.write(itrLabels.first);
+			aWriter.writeLabels(itrLabels.second);
+		}
+	}
+
+	aWriter.write(m_mapCodeIndirects.size() + m_mapDataIndirects.size());
+	for (auto const & itrIndirect : m_mapCodeIndirects) {
+		aWriter.write(0);
+		aWriter.write(itrIndirect.second.GetAddress());
+		aWriter.write(itrIndirect.second.GetTargetAddress());
+		aWriter.writeLabels(itrIndirect.second.GetLabels());
+	}
+	for (auto const & itrIndirect : m_mapDataIndirects) {
+		aWriter.write(1);
+		aWriter.write(itrIndirect.second.GetAddress());
+		aWriter.write(itrIndirect.second.GetTargetAddress());
+		aWriter.writeLabels(itrIndirect.second.GetLabels());
+	}
+
+	aWriter.write(m_arrFunctions.size());
+	for (auto const & func : m_arrFunctions) func->WriteBinary(aWriter);
+	aWriter.write(m_arrDataBlocks.size());
+	for (auto const & data : m_arrDataBlocks) data->WriteBinary(aWriter);
+
+	return aWriter.writeFile(outFile, (allowMemRangeOverlap() ? FFF_MEMRANGEOVERLAP : FFF_NONE), opcodeSymbolSize());
+}
+
+// readBinaryFunctions : Reads a Functions or Data Blocks table of a
+//				Binary Function File into arrFunctions, with their objects
+//				in aStore:
+static bool readBinaryFunctions(std::shared_ptr<CFuncDescFile> pThis, CFuncObjectStore &aStore, CFuncBinaryReader &aReader, CFuncDescArray &arrFunctions)
+{
+	uint32_t nFunctions = aReader.readCount();
+	arrFunctions.reserve(nFunctions);
+	for (uint32_t ndxFunc = 0; (aReader.good() && (ndxFunc < nFunctions)); ++ndxFunc) {
+		std::shared_ptr<CFuncDesc> pFunction = std::make_shared<CFuncDesc>(aReader.read(), TString());
+		uint32_t nNames = aReader.readCount();
+		for (uint32_t ndxName = 0; ndxName < nNames; ++ndxName) {
+			TAddress nAddress = aReader.read();
+			for (auto const & strName : aReader.readLabels()) pFunction->AddName(nAddress, strName);
+		}
+		if (!aReader.good()) return false;
+
+		uint32_t nObjects = aReader.readCount();
+		pFunction->reserve(nObjects);
+		for (uint32_t ndxObj = 0; (aReader.good() && (ndxObj < nObjects)); ++ndxObj) {
+			switch (aReader.read()) {
+				case FFO_DATA_BYTE:
+					pFunction->Add(aStore.newObject<CFuncDataByteObject>(*pThis, *pFunction, aReader));
+					break;
+				case FFO_ASM_INST:
+					pFunction->Add(aStore.newObject<CFuncAsmInstObject>(*pThis, *pFunction, aReader));
+					break;
+				default:
+					return false;
 			}
 		}
 
-		(*msgFile) << "\n    " << m_arrFunctions.size() << " Function"
-					<< ((m_arrFunctions.size() != 1) ? "s" : "") << " Defined"
-					<< ((m_arrFunctions.size() != 0) ? ":" : "") << "\n";
+		TContentHash nContentHash = aReader.read64();
+		CDiffSymbolArray arrDiffSymbols;
+		arrDiffSymbols.reserve(pFunction->size() * NUM_DIFF_SYMBOL_SLOTS);
+		for (CDiffSymbolArray::size_type ndx = 0; ndx < (pFunction->size() * NUM_DIFF_SYMBOL_SLOTS); ++ndx) {
+			arrDiffSymbols.push_back(aReader.readSymbol(CDiffSymbolPool::instance()));
+		}
+		if (!aReader.good()) return false;
+		pFunction->SetDiffSymbols(std::move(arrDiffSymbols), nContentHash);
 
-		for (auto const & func : m_arrFunctions) {
-			(*msgFile) << "        0x"
-						<< std::uppercase << std::setfill('0') << std::setw(4) << std::setbase(16) << func->GetMainAddress()
-						<< std::nouppercase << std::setbase(0)
-						<< " -> " << func->GetMainName() << "\n";
+		arrFunctions.push_back(pFunction);
+	}
+	return aReader.good();
+}
+
+bool CFuncDescFile::ReadBinaryFile(std::shared_ptr<CFuncDescFile> pThis, const TString &strFilename, std::ostream *msgFile, std::ostream *errFile)
+{
+	CPerfStats::CPhase phase("ReadBinaryFile");
+	TString strError = g_strUnexpectedError;
+
+	if (msgFile) {
+		(*msgFile) << "Reading Binary Function Definition File " << std::filesystem::relative(strFilename) << "...\n";
+	}
+
+	SetFilename(strFilename);
+
+	// Everything is copied out of the file as it's read, so the mapping
+	//	is only needed until this returns:
+	std::size_t nFileSize = 0;
+	std::shared_ptr<const void> pMapping = mapFile(strFilename, nFileSize);
+	CFuncBinaryReader aReader;
+	bool bRetVal = false;
+
+	while (1) {		// Setup dummy endless loop so we can use 'break' instead of 'goto'
+		if (!pMapping) {
+			strError = "Unable to map file";
+			break;
+		}
+		if (!aReader.open(pMapping.get(), nFileSize, strError)) break;
+		strError = g_strSyntaxError;
+
+		m_bAllowMemRangeOverlap = ((aReader.header().m_nFlags & FFF_MEMRANGEOVERLAP) != 0);
+		m_nOpcodeSymbolSize = aReader.header().m_nOpcodeSymbolSize;
+		if (m_nOpcodeSymbolSize == 0) {
+			strError = g_strInvalidOpcodeSymbolWidth;
+			break;
 		}
 
-		for (int nMemType = 0; nMemType < MEMORY_TYPE::NUM_MEMORY_TYPES; ++nMemType) {
-			(*msgFile) << "\n";
-			(*msgFile) << "    " << m_mapLabelTable[nMemType].size()
-						<< " Unique " << g_arrstrMemRanges[nMemType] << " Label"
-						<< ((m_mapLabelTable[nMemType].size() != 1) ? "s" : "") << " Defined"
-						<< ((m_mapLabelTable[nMemType].size() != 0) ? ":" : "") << "\n";
-			for (auto const & labelList : m_mapLabelTable[nMemType]) {
-				(*msgFile) << "        0x"
-							<< std::uppercase << std::setfill('0') << std::setw(4) << std::setbase(16) << labelList.first
-							<< std::nouppercase << std::setbase(0)
-							<< "=";
-				bool bFirst = true;
-				for (auto const & label : labelList.second) {
-					(*msgFile) << (!bFirst ? "," : "") << label;
-					bFirst = false;
-				}
-				(*msgFile) << "\n";
+		uint32_t nMemRanges = aReader.readCount();
+		for (uint32_t ndx = 0; (aReader.good() && (ndx < nMemRanges)); ++ndx) {
+			uint32_t nMemType = aReader.read();
+			TAddress nAddress = aReader.read();
+			TSize nSize = aReader.read64();
+			if (nMemType >= MEMORY_TYPE::NUM_MEMORY_TYPES) {
+				aReader.fail();
+				break;
+			}
+			m_MemoryRanges[nMemType].push_back(CMemRange(nAddress, nSize));
+		}
+
+		uint32_t nLabels = aReader.readCount();
+		for (uint32_t ndx = 0; (aReader.good() && (ndx < nLabels)); ++ndx) {
+			uint32_t nMemType = aReader.read();
+			TAddress nAddress = aReader.read();
+			CLabelArray arrLabels = aReader.readLabels();
+			if (nMemType >= MEMORY_TYPE::NUM_MEMORY_TYPES) {
+				aReader.fail();
+				break;
+			}
+			m_mapLabelTable[nMemType][nAddress] = std::move(arrLabels);
+		}
+
+		uint32_t nIndirects = aReader.readCount();
+		for (uint32_t ndx = 0; (aReader.good() && (ndx < nIndirects)); ++ndx) {
+			uint32_t nType = aReader.read();
+			TAddress nAddress = aReader.read();
+			TAddress nTargetAddress = aReader.read();
+			if (nType > 1) {
+				aReader.fail();
+				break;
 			}
+			CIndirectEntry anIndirect(nAddress, nTargetAddress, TString());
+			for (auto const & strLabel : aReader.readLabels()) anIndirect.AddLabel(strLabel);
+			((nType == 0) ? m_mapCodeIndirects : m_mapDataIndirects)[nAddress] = anIndirect;
+		}
+
+		if (!aReader.good() ||
+			!readBinaryFunctions(pThis, m_ObjectStore, aReader, m_arrFunctions) ||
+			!readBinaryFunctions(pThis, m_ObjectStore, aReader, m_arrDataBlocks) ||
+			!aReader.atEnd()) break;
+
+		for (CFuncDescArray::size_type ndx = 0; ndx < m_arrFunctions.size(); ++ndx) {
+			m_mapSortedFunctionMap.insert(std::pair<CFuncDesc::size_type, CFuncDescArray::size_type>(m_arrFunctions.at(ndx)->size(), ndx));
 		}
 
-		(*msgFile) << "\n";
+		bRetVal = true;
+		break;
 	}
 
+	if (bRetVal && msgFile) ReportContents(*msgFile);
+
 	if (!bRetVal && errFile) {
-		(*errFile) << "*** Error: " << strError << " : on line " << nLineCount << " of file\n"
-					  "           \"" << std::filesystem::relative(inFile.getFilename()) << "\"\n";
+		(*errFile) << "*** Error: " << strError << " : in binary function file\n"
+					  "           \"" << std::filesystem::relative(strFilename) << "\"\n";
 	}
 
 	return bRetVal;
 }
 
+bool CFuncDescFile::ReadDisassembly(std::shared_ptr<CFuncDescFile> pThis, CDisassembler &aDisassembler, std::ostream *msgFile, std::ostream *errFile)
+{
+	CPerfStats::CPhase phase("ReadDisassembly");
+	// The functions are still passed as the disassembler's textual
+	//	function output, since that's where the processor-specific
+	//	functional opcodes are formatted, but it's only ever in memory:
+	std::stringstream ssFunctions;
+	if (!aDisassembler.Disassemble(msgFile, errFile, nullptr, &ssFunctions)) return false;
+
+	// Report the functions under the name of the functions file that
+	//	the control file would have written, if any:
+	std::string strFilename = aDisassembler.functionsFilename();
+	if (strFilename.empty()) strFilename = "<" + aDisassembler.GetGDCShortName() + " disassembly>";
+
+	return ReadFuncDescFile(pThis, ssFunctions, strFilename, msgFile, errFile);
+}
+
 bool CFuncDescFile::AddLabel(MEMORY_TYPE nMemoryType, TAddress nAddress, const TLabel &strLabel)
 {
 	if (strLabel.empty()) return false;
@@ -1410,7 +2186,7 @@ CFuncDescArray::size_type CFuncDescFileArray::GetFuncCount() const
 	return nRetVal;
 }
 
-double CFuncDescFileArray::CompareFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC_COMPARE_METHOD nMethod,
+CFuncCompareResult CFuncDescFileArray::CompareFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC_COMPARE_METHOD nMethod,
 											size_type nFile1Ndx, std::size_t nFile1FuncNdx,
 											size_type nFile2Ndx, std::size_t nFile2FuncNdx,
 											bool bBuildEditScript) const
@@ -1427,18 +2203,17 @@ double CFuncDescFileArray::CompareFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC
 		}
 		std::cerr << "\n";
 	}
-	return 0.0;
+	return CFuncCompareResult();
 }
 
-TString CFuncDescFileArray::DiffFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC_COMPARE_METHOD nMethod,
+CFuncDiffResult CFuncDescFileArray::DiffFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC_COMPARE_METHOD nMethod,
 									int nFile1Ndx, int nFile1FuncNdx,
 									int nFile2Ndx, int nFile2FuncNdx,
 									OUTPUT_OPTIONS nOutputOptions,
-									double &nMatchPercent,
 									CSymbolMap *pSymbolMap) const
 {
 	return ::DiffFunctions(nCompareType, nMethod, *at(nFile1Ndx), nFile1FuncNdx, *at(nFile2Ndx), nFile2FuncNdx,
-							nOutputOptions, nMatchPercent, pSymbolMap);
+							nOutputOptions, pSymbolMap);
 }
 
 
@@ -1446,6 +2221,12 @@ TString CFuncDescFileArray::DiffFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC_C
 // CSymbolMap Class
 //////////////////////////////////////////////////////////////////////
 
+CSymbolMap::CSymbolMap()
+{
+	m_arrSymbols.emplace_back();		// EMPTY_SYMBOL
+	m_mapSymbolIDs.emplace(m_arrSymbols.front(), EMPTY_SYMBOL);
+}
+
 bool CSymbolMap::empty() const
 {
 	return (m_LeftSideCodeSymbols.empty() &&
@@ -1454,192 +2235,116 @@ bool CSymbolMap::empty() const
 			m_RightSideDataSymbols.empty());
 }
 
-void CSymbolMap::AddObjectMapping(const CFuncObject &aLeftObject, const CFuncObject &aRightObject)
+TSymbolID CSymbolMap::internSymbol(std::string_view strSymbol)
 {
-	CSymbolArray arrLeftSymbols;
-	CSymbolArray arrRightSymbols;
-	int nMode;		// 0 = Source, 1 = Destination
-	int nType;		// 0 = Code, 1 = Data
-
-	arrLeftSymbols = aLeftObject.GetSymbols();
-	arrRightSymbols = aRightObject.GetSymbols();
-
-	// Since we are comparing functions, any "L" and "CL" entries are automatically "Code" entries:
-	for (auto const & leftSymbol : arrLeftSymbols) {
-		if (leftSymbol.empty() || ((leftSymbol.at(0) != 'L') && !leftSymbol.starts_with("CL"))) continue;
-		if (leftSymbol.size() < 2) continue;
-		bool bFlag = false;
-		for (auto const & rightSymbol : arrRightSymbols) {
-			if (rightSymbol.empty() || ((rightSymbol.at(0) != 'L') && !rightSymbol.starts_with("CL"))) continue;
-			if (rightSymbol.size() < 2) continue;
-			AddLeftSideCodeSymbol(leftSymbol.substr(1), rightSymbol.substr(1));
-			bFlag = true;
-		}
-		if (!bFlag) AddLeftSideCodeSymbol(leftSymbol.substr(1), TSymbol());
-	}
+	auto itrID = m_mapSymbolIDs.find(strSymbol);
+	if (itrID != m_mapSymbolIDs.end()) return itrID->second;
 
-	for (auto const & rightSymbol : arrRightSymbols) {
-		if (rightSymbol.empty() || ((rightSymbol.at(0) != 'L') && !rightSymbol.starts_with("CL"))) continue;
-		if (rightSymbol.size() < 2) continue;
-		bool bFlag = false;
-		for (auto const & leftSymbol : arrLeftSymbols) {
-			if (leftSymbol.empty() || ((leftSymbol.at(0) != 'L') && !leftSymbol.starts_with("CL"))) continue;
-			if (leftSymbol.size() < 2) continue;
-			AddRightSideCodeSymbol(rightSymbol.substr(1), leftSymbol.substr(1));
-			bFlag = true;
-		}
-		if (!bFlag) AddRightSideCodeSymbol(rightSymbol.substr(1), TSymbol());
-	}
+	TSymbolID nID = m_arrSymbols.size();
+	m_mapSymbolIDs.emplace(m_arrSymbols.emplace_back(strSymbol), nID);
+	return nID;
+}
 
-	// Add Left Source/Destination entries:
-	for (auto const & leftSymbol : arrLeftSymbols) {
-		if (leftSymbol.empty() || (leftSymbol.at(0) != 'R')) continue;
-		if (leftSymbol.size() < 4) continue;
-		switch (leftSymbol.at(1)) {
-			case 'S':
-				nMode = 0;
-				break;
-			case 'D':
-				nMode = 1;
-				break;
-			default:
-				continue;
-		}
-		switch (leftSymbol.at(2)) {
-			case 'C':
-				nType = 0;
-				break;
-			case 'D':
-				nType = 1;
-				break;
-			default:
-				continue;
-		}
-		bool bFlag = false;
-		for (auto const & rightSymbol : arrRightSymbols) {
-			if (rightSymbol.empty() || (rightSymbol.at(0) != 'R')) continue;
-			if (rightSymbol.size() < 4) continue;
-			bool bFlag2 = false;
-			switch (rightSymbol.at(1)) {
-				case 'S':
-					if (nMode == 0) {
-						bFlag2 = true;
-					}
-					break;
-				case 'D':
-					if (nMode == 1) {
-						bFlag2 = true;
-					}
-					break;
-				default:
-					continue;
-			}
-			if (bFlag2) {
-				switch (rightSymbol.at(2)) {
-					case 'C':
-						if (nType == 0) {
-							AddLeftSideCodeSymbol(leftSymbol.substr(3), rightSymbol.substr(3));
-							bFlag = true;
-						}
+void CSymbolMap::AddObjectMapping(const CFuncObject &aLeftObject, const CFuncObject &aRightObject)
+{
+	// Symbols of each object by kind.  Since we are comparing functions, any
+	//	"L" and "CL" entries are automatically "Code" entries.  "R" entries are
+	//	by Source/Destination mode and Code/Data type:
+	struct TObjectSymbols {
+		std::vector<TSymbolID> m_arrLabels;
+		std::vector<TSymbolID> m_arrRefs[2][2];		// [nMode][nType] : nMode 0 = Source, 1 = Destination; nType 0 = Code, 1 = Data
+	};
+
+	auto &&fnSortSymbols = [this](const CSymbolArray &arrSymbols, TObjectSymbols &aSymbols)->void {
+		for (auto const & strSymbol : arrSymbols) {
+			if (strSymbol.empty()) continue;
+			if ((strSymbol.at(0) == 'L') || strSymbol.starts_with("CL")) {
+				if (strSymbol.size() < 2) continue;
+				aSymbols.m_arrLabels.push_back(internSymbol(std::string_view(strSymbol).substr(1)));
+			} else if (strSymbol.at(0) == 'R') {
+				if (strSymbol.size() < 4) continue;
+				int nMode;
+				int nType;
+				switch (strSymbol.at(1)) {
+					case 'S':
+						nMode = 0;
 						break;
 					case 'D':
-						if (nType == 1) {
-							AddLeftSideDataSymbol(leftSymbol.substr(3), rightSymbol.substr(3));
-							bFlag = true;
-						}
+						nMode = 1;
 						break;
 					default:
 						continue;
 				}
-			}
-		}
-		if (!bFlag) {
-			switch (nType) {
-				case 0:
-					AddLeftSideCodeSymbol(leftSymbol.substr(3), TSymbol());
-					break;
-				case 1:
-					AddLeftSideDataSymbol(leftSymbol.substr(3), TSymbol());
-					break;
-			}
-		}
-	}
-
-	// Add Right Source/Destination entries:
-	for (auto const & rightSymbol : arrRightSymbols) {
-		if (rightSymbol.empty() || (rightSymbol.at(0) != 'R')) continue;
-		if (rightSymbol.size() < 4) continue;
-		switch (rightSymbol.at(1)) {
-			case 'S':
-				nMode = 0;
-				break;
-			case 'D':
-				nMode = 1;
-				break;
-			default:
-				continue;
-		}
-		switch (rightSymbol.at(2)) {
-			case 'C':
-				nType = 0;
-				break;
-			case 'D':
-				nType = 1;
-				break;
-			default:
-				continue;
-		}
-		bool bFlag = false;
-		for (auto const & leftSymbol : arrLeftSymbols) {
-			if (leftSymbol.empty() || (leftSymbol.at(0) != 'R')) continue;
-			if (leftSymbol.size() < 4) continue;
-			bool bFlag2 = false;
-			switch (leftSymbol.at(1)) {
-				case 'S':
-					if (nMode == 0) {
-						bFlag2 = true;
-					}
-					break;
-				case 'D':
-					if (nMode == 1) {
-						bFlag2 = true;
-					}
-					break;
-				default:
-					continue;
-			}
-			if (bFlag2) {
-				switch (leftSymbol.at(2)) {
+				switch (strSymbol.at(2)) {
 					case 'C':
-						if (nType == 0) {
-							AddRightSideCodeSymbol(rightSymbol.substr(3), leftSymbol.substr(3));
-							bFlag = true;
-						}
+						nType = 0;
 						break;
 					case 'D':
-						if (nType == 1) {
-							AddRightSideDataSymbol(rightSymbol.substr(3), leftSymbol.substr(3));
-							bFlag = true;
-						}
+						nType = 1;
 						break;
 					default:
 						continue;
 				}
+				aSymbols.m_arrRefs[nMode][nType].push_back(internSymbol(std::string_view(strSymbol).substr(3)));
 			}
 		}
-		if (!bFlag) {
-			switch (nType) {
-				case 0:
-					AddRightSideCodeSymbol(rightSymbol.substr(3), TSymbol());
-					break;
-				case 1:
-					AddRightSideDataSymbol(rightSymbol.substr(3), TSymbol());
-					break;
+	};
+
+	TObjectSymbols leftSymbols;
+	TObjectSymbols rightSymbols;
+	fnSortSymbols(aLeftObject.GetSymbols(), leftSymbols);
+	fnSortSymbols(aRightObject.GetSymbols(), rightSymbols);
+
+	// Each symbol gets a hit for every symbol of the same kind on the other
+	//	side, or a hit on the empty symbol if the other side has none:
+	auto &&fnAddHits = [](CSymbolHitsMap &mapSymbolHits, const std::vector<TSymbolID> &arrSymbols,
+							const std::vector<TSymbolID> &arrTargets)->void {
+		for (TSymbolID nSymbol : arrSymbols) {
+			TSymbolHits &hits = mapSymbolHits[nSymbol];
+			if (arrTargets.empty()) {
+				++hits.m_mapHits[EMPTY_SYMBOL];
+				++hits.m_nTotal;
+			} else {
+				for (TSymbolID nTarget : arrTargets) ++hits.m_mapHits[nTarget];
+				hits.m_nTotal += arrTargets.size();
 			}
 		}
+	};
+
+	fnAddHits(m_LeftSideCodeSymbols, leftSymbols.m_arrLabels, rightSymbols.m_arrLabels);
+	fnAddHits(m_RightSideCodeSymbols, rightSymbols.m_arrLabels, leftSymbols.m_arrLabels);
+
+	for (int nMode = 0; nMode < 2; ++nMode) {
+		fnAddHits(m_LeftSideCodeSymbols, leftSymbols.m_arrRefs[nMode][0], rightSymbols.m_arrRefs[nMode][0]);
+		fnAddHits(m_LeftSideDataSymbols, leftSymbols.m_arrRefs[nMode][1], rightSymbols.m_arrRefs[nMode][1]);
+		fnAddHits(m_RightSideCodeSymbols, rightSymbols.m_arrRefs[nMode][0], leftSymbols.m_arrRefs[nMode][0]);
+		fnAddHits(m_RightSideDataSymbols, rightSymbols.m_arrRefs[nMode][1], leftSymbols.m_arrRefs[nMode][1]);
 	}
 }
 
+void CSymbolMap::Merge(const CSymbolMap &aSymbolMap)
+{
+	// Translate aSymbolMap's symbol IDs to ours:
+	std::vector<TSymbolID> arrIDs;
+	arrIDs.reserve(aSymbolMap.m_arrSymbols.size());
+	for (auto const & strSymbol : aSymbolMap.m_arrSymbols) arrIDs.push_back(internSymbol(strSymbol));
+
+	auto &&fnMerge = [&arrIDs](CSymbolHitsMap &mapDst, const CSymbolHitsMap &mapSrc)->void {
+		for (auto const & itrSymbol : mapSrc) {
+			TSymbolHits &hitsDst = mapDst[arrIDs[itrSymbol.first]];
+			hitsDst.m_nTotal += itrSymbol.second.m_nTotal;
+			for (auto const & itrHit : itrSymbol.second.m_mapHits) {
+				hitsDst.m_mapHits[arrIDs[itrHit.first]] += itrHit.second;
+			}
+		}
+	};
+
+	fnMerge(m_LeftSideCodeSymbols, aSymbolMap.m_LeftSideCodeSymbols);
+	fnMerge(m_RightSideCodeSymbols, aSymbolMap.m_RightSideCodeSymbols);
+	fnMerge(m_LeftSideDataSymbols, aSymbolMap.m_LeftSideDataSymbols);
+	fnMerge(m_RightSideDataSymbols, aSymbolMap.m_RightSideDataSymbols);
+}
+
 CSymbolArray CSymbolMap::GetLeftSideCodeSymbolList() const
 {
 	return GetSymbolList(m_LeftSideCodeSymbols);
@@ -1660,12 +2365,13 @@ CSymbolArray CSymbolMap::GetRightSideDataSymbolList() const
 	return GetSymbolList(m_RightSideDataSymbols);
 }
 
-CSymbolArray CSymbolMap::GetSymbolList(const CSymbolArrayMap &mapSymbolArrays) const
+CSymbolArray CSymbolMap::GetSymbolList(const CSymbolHitsMap &mapSymbolHits) const
 {
 	CSymbolArray arrRetVal;
 
-	std::transform(mapSymbolArrays.cbegin(), mapSymbolArrays.cend(), std::back_inserter(arrRetVal),
-					[](const CSymbolArrayMap::value_type &val)->CSymbolArrayMap::key_type { return val.first; });
+	arrRetVal.reserve(mapSymbolHits.size());
+	for (auto const & itrSymbol : mapSymbolHits) arrRetVal.push_back(m_arrSymbols[itrSymbol.first]);
+	std::sort(arrRetVal.begin(), arrRetVal.end());
 	return arrRetVal;
 }
 
@@ -1689,63 +2395,35 @@ THitCount CSymbolMap::GetRightSideDataHitList(const TSymbol &aSymbol, CSymbolArr
 	return GetHitList(m_RightSideDataSymbols, aSymbol, aSymbolArray, aHitCountArray);
 }
 
-THitCount CSymbolMap::GetHitList(const CSymbolArrayMap &mapSymbolArrays, const TSymbol &aSymbol,
+THitCount CSymbolMap::GetHitList(const CSymbolHitsMap &mapSymbolHits, const TSymbol &aSymbol,
 									CSymbolArray &aSymbolArray, CHitCountArray &aHitCountArray) const
 {
-	CSymbolHitMap mapSymbolHits;
-	THitCount nTotal = 0;
-
 	aSymbolArray.clear();
 	aHitCountArray.clear();
 
-	CSymbolArrayMap::const_iterator itrSymbolMap = mapSymbolArrays.find(aSymbol);
-	if (itrSymbolMap != mapSymbolArrays.cend()) {
-		for (auto const &itrSymbols : itrSymbolMap->second) {
-			CSymbolHitMap::iterator itrHitMap = mapSymbolHits.find(itrSymbols);
-			if (itrHitMap != mapSymbolHits.end()) {
-				++itrHitMap->second;
-			} else {
-				mapSymbolHits[itrSymbols] = 1;
-			}
-		}
-
-		for (auto const &itrHits : mapSymbolHits) {
-			CHitCountArray::size_type ndx;
-			for (ndx = 0; ndx < aHitCountArray.size(); ++ndx) {
-				if (itrHits.second > aHitCountArray.at(ndx)) break;
-				if (itrHits.second == aHitCountArray.at(ndx)) {
-					if (aSymbolArray.at(ndx).empty()) break;
-					if ((itrHits.first < aSymbolArray.at(ndx)) &&
-						!itrHits.first.empty()) break;
-				}
-			}
-			aSymbolArray.insert(aSymbolArray.begin() + ndx, itrHits.first);
-			aHitCountArray.insert(aHitCountArray.begin() + ndx, itrHits.second);
-		}
-
-		nTotal = itrSymbolMap->second.size();
+	auto itrID = m_mapSymbolIDs.find(aSymbol);
+	if (itrID == m_mapSymbolIDs.cend()) return 0;
+	CSymbolHitsMap::const_iterator itrSymbolHits = mapSymbolHits.find(itrID->second);
+	if (itrSymbolHits == mapSymbolHits.cend()) return 0;
+
+	// Rank by most hits first, with ties in symbol order, but with the
+	//	empty (unmatched) symbol after the others:
+	std::vector<std::pair<TSymbolID, THitCount>> arrHits(itrSymbolHits->second.m_mapHits.cbegin(),
+															itrSymbolHits->second.m_mapHits.cend());
+	std::sort(arrHits.begin(), arrHits.end(),
+				[this](const std::pair<TSymbolID, THitCount> &hit1, const std::pair<TSymbolID, THitCount> &hit2)->bool {
+					if (hit1.second != hit2.second) return (hit1.second > hit2.second);
+					if ((hit1.first == EMPTY_SYMBOL) || (hit2.first == EMPTY_SYMBOL)) return (hit2.first == EMPTY_SYMBOL) && (hit1.first != EMPTY_SYMBOL);
+					return (m_arrSymbols[hit1.first] < m_arrSymbols[hit2.first]);
+				});
+
+	aSymbolArray.reserve(arrHits.size());
+	aHitCountArray.reserve(arrHits.size());
+	for (auto const & itrHit : arrHits) {
+		aSymbolArray.push_back(m_arrSymbols[itrHit.first]);
+		aHitCountArray.push_back(itrHit.second);
 	}
 
-	return nTotal;
-}
-
-void CSymbolMap::AddLeftSideCodeSymbol(const TSymbol &aLeftSymbol, const TSymbol &aRightSymbol)
-{
-	m_LeftSideCodeSymbols[aLeftSymbol].push_back(aRightSymbol);
-}
-
-void CSymbolMap::AddRightSideCodeSymbol(const TSymbol &aRightSymbol, const TSymbol &aLeftSymbol)
-{
-	m_RightSideCodeSymbols[aRightSymbol].push_back(aLeftSymbol);
-}
-
-void CSymbolMap::AddLeftSideDataSymbol(const TSymbol &aLeftSymbol, const TSymbol &aRightSymbol)
-{
-	m_LeftSideDataSymbols[aLeftSymbol].push_back(aRightSymbol);
-}
-
-void CSymbolMap::AddRightSideDataSymbol(const TSymbol &aRightSymbol, const TSymbol &aLeftSymbol)
-{
-	m_RightSideDataSymbols[aRightSymbol].push_back(aLeftSymbol);
+	return itrSymbolHits->second.m_nTotal;
 }
 
@@ -21,23 +21,39 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <deque>
 #include <fstream>
 #include <memory>
+#include <unordered_map>
+#include <string_view>
+#include <type_traits>
+#include <mutex>
+#include <stdint.h>
 
 // ============================================================================
 
 // Foward Declarations:
 class CFuncDesc;
 class CFuncDescFile;
+class CFuncObjectStore;
 class CSymbolMap;
+class CFuncBinaryWriter;		// Binary Function Description File writer (see funcdesc.cpp)
+class CFuncBinaryReader;		// Binary Function Description File reader (see funcdesc.cpp)
 
 typedef std::string TSymbol;
 typedef std::vector<TSymbol> CSymbolArray;
-typedef std::map<TSymbol, CSymbolArray> CSymbolArrayMap;
+typedef uint32_t TSymbolID;			// Index of a symbol interned in a CSymbolMap
 
 typedef std::size_t THitCount;
 typedef std::vector<THitCount> CHitCountArray;
-typedef std::map<TSymbol, THitCount> CSymbolHitMap;
+
+// Function object bytes and strings are held by the CFuncObjectStore of
+//	their file and referenced from the objects by these:
+struct CFuncByteSpan {
+	uint32_t m_nOffset = 0;			// Offset of the first byte in the store's byte array
+	uint32_t m_nCount = 0;			// Number of bytes
+};
+typedef uint32_t TFuncStringIndex;	// Index of a string in the store's string pool
 
 class CIndirectEntry
 {
@@ -98,11 +114,18 @@ typedef bool (*TFN_FuncAnalProgressCallback)(int nProgressPos, int nProgressMax,
 // CFuncObject Class
 //////////////////////////////////////////////////////////////////////
 //		This specifies a pure virtual base class for defining
-//		Function Objects:
+//		Function Objects.  Function Objects are created only by the
+//		CFuncObjectStore of their parent file, which owns them.  Their
+//		references to their parent file and function are non-owning,
+//		since those outlive them:
 class CFuncObject
 {
 public:
-	CFuncObject(std::shared_ptr<const CFuncDescFile> pParentFuncFile, std::shared_ptr<const CFuncDesc> pParentFunc, CStringArray &argv);
+	CFuncObject(CFuncObjectStore &aStore, const CFuncDescFile &aParentFuncFile, const CFuncDesc &aParentFunc, CStringArray &argv);
+	CFuncObject(CFuncObjectStore &aStore, const CFuncDescFile &aParentFuncFile, const CFuncDesc &aParentFunc, CFuncBinaryReader &aReader);
+	virtual ~CFuncObject() = default;
+
+	virtual void WriteBinary(CFuncBinaryWriter &aWriter) const = 0;	// Writes the object to a binary file, beginning with its object type, in the order read by the CFuncBinaryReader constructor
 
 	virtual bool isExactMatch(const CFuncObject &obj) const;
 
@@ -113,7 +136,7 @@ public:
 	CLabelArray::size_type GetLabelCount() const { return m_arrLabelTable.size(); }
 	TLabel GetLabel(CLabelArray::size_type nIndex) const { return m_arrLabelTable.at(nIndex); }
 	TString GetBytes() const;
-	CMemoryArray::size_type GetByteCount() const { return m_Bytes.size(); }
+	CMemoryArray::size_type GetByteCount() const { return m_Bytes.m_nCount; }
 
 	virtual TString ExportToDiff(FUNC_DIFF_LEVEL nLevel) const = 0;
 
@@ -129,13 +152,17 @@ public:
 	static int GetFieldWidth(FIELD_CODE nFC);
 
 protected:
-	std::shared_ptr<const CFuncDescFile> m_pParentFuncFile;
-	std::shared_ptr<const CFuncDesc> m_pParentFunc;
+	void WriteBinaryCommon(CFuncBinaryWriter &aWriter) const;	// Writes the members of this base class, as read by its CFuncBinaryReader constructor
+
+	const CFuncObjectStore &store() const;		// Store of the parent file, holding the bytes and strings of this object
+
+	const CFuncDescFile *m_pParentFuncFile;
+	const CFuncDesc *m_pParentFunc;
 
 	TAddress	m_nRelFuncAddress;		// Address of object relative to function start
 	TAddress	m_nAbsAddress;			// Absolute Address of object
 	CLabelArray		m_arrLabelTable;	// Labels assigned to this object
-	CMemoryArray	m_Bytes;			// Array of bytes for this object (TODO : Change this to TDisassembler::COpcodeSymbolArray)
+	CFuncByteSpan	m_Bytes;			// Bytes for this object (TODO : Change this to TDisassembler::COpcodeSymbolArray)
 };
 
 // ============================================================================
@@ -147,7 +174,10 @@ protected:
 class CFuncAsmInstObject : public CFuncObject
 {
 public:
-	CFuncAsmInstObject(std::shared_ptr<const CFuncDescFile> pParentFuncFile, std::shared_ptr<const CFuncDesc> pParentFunc, CStringArray &argv);
+	CFuncAsmInstObject(CFuncObjectStore &aStore, const CFuncDescFile &aParentFuncFile, const CFuncDesc &aParentFunc, CStringArray &argv);
+	CFuncAsmInstObject(CFuncObjectStore &aStore, const CFuncDescFile &aParentFuncFile, const CFuncDesc &aParentFunc, CFuncBinaryReader &aReader);
+
+	virtual void WriteBinary(CFuncBinaryWriter &aWriter) const override;
 
 	virtual TString ExportToDiff(FUNC_DIFF_LEVEL nLevel) const override;
 
@@ -156,18 +186,23 @@ public:
 	virtual CSymbolArray GetSymbols() const override;	// Returns specially encoded symbol array (see implementation comments)
 
 	TString GetOpCodeBytes() const;
-	CMemoryArray::size_type GetOpCodeByteCount() const { return m_OpCodeBytes.size(); }
+	CMemoryArray::size_type GetOpCodeByteCount() const { return m_OpCodeBytes.m_nCount; }
 
 	TString GetOperandBytes() const;
-	CMemoryArray::size_type GetOperandByteCount() const { return m_OperandBytes.size(); }
+	CMemoryArray::size_type GetOperandByteCount() const { return m_OperandBytes.m_nCount; }
+
+	const TString &GetDstOperand() const;
+	const TString &GetSrcOperand() const;
+	const TString &GetOpCodeText() const;
+	const TString &GetOperandText() const;
 
 protected:
-	CMemoryArray m_OpCodeBytes;			// Array of OpCode Bytes for this instruction  (TODO : Change this to TDisassembler::COpcodeSymbolArray)
-	CMemoryArray m_OperandBytes;		// Array of Operand Bytes for ths instruction  (TODO : Change this to TDisassembler::COpcodeSymbolArray)
-	TString m_strDstOperand;			// Encoded Destination Operand
-	TString m_strSrcOperand;			// Encoded Source Operand
-	TString m_strOpCodeText;			// Textual OpCode mnemonic
-	TString m_strOperandText;			// Textual Operands
+	CFuncByteSpan m_OpCodeBytes;		// OpCode Bytes for this instruction  (TODO : Change this to TDisassembler::COpcodeSymbolArray)
+	CFuncByteSpan m_OperandBytes;		// Operand Bytes for ths instruction  (TODO : Change this to TDisassembler::COpcodeSymbolArray)
+	TFuncStringIndex m_nDstOperand;		// Encoded Destination Operand
+	TFuncStringIndex m_nSrcOperand;		// Encoded Source Operand
+	TFuncStringIndex m_nOpCodeText;		// Textual OpCode mnemonic
+	TFuncStringIndex m_nOperandText;	// Textual Operands
 };
 
 // ============================================================================
@@ -179,10 +214,15 @@ protected:
 class CFuncDataByteObject : public CFuncObject
 {
 public:
-	CFuncDataByteObject(std::shared_ptr<const CFuncDescFile> pParentFuncFile, std::shared_ptr<const CFuncDesc> pParentFunc, CStringArray &argv)
-		:	CFuncObject(pParentFuncFile, pParentFunc, argv)
+	CFuncDataByteObject(CFuncObjectStore &aStore, const CFuncDescFile &aParentFuncFile, const CFuncDesc &aParentFunc, CStringArray &argv)
+		:	CFuncObject(aStore, aParentFuncFile, aParentFunc, argv)
+	{ }
+	CFuncDataByteObject(CFuncObjectStore &aStore, const CFuncDescFile &aParentFuncFile, const CFuncDesc &aParentFunc, CFuncBinaryReader &aReader)
+		:	CFuncObject(aStore, aParentFuncFile, aParentFunc, aReader)
 	{ }
 
+	virtual void WriteBinary(CFuncBinaryWriter &aWriter) const override;
+
 	virtual TString ExportToDiff(FUNC_DIFF_LEVEL nLevel) const override;
 
 	virtual TString CreateOutputLine(OUTPUT_OPTIONS nOutputOptions = OO_NONE) const override;
@@ -190,12 +230,129 @@ public:
 
 // ============================================================================
 
+//////////////////////////////////////////////////////////////////////
+// CFuncObjectStore Class
+//////////////////////////////////////////////////////////////////////
+//		This class owns all of the function objects of a single
+//		CFuncDescFile, along with their bytes and strings.  Objects
+//		are allocated in fixed-capacity blocks, so that they are
+//		contiguous and never move once created.  The bytes of all of
+//		the objects are kept in a single array, referenced by offset,
+//		and their strings are interned once per file, referenced by
+//		index.  The CFuncDesc objects of the file hold non-owning
+//		pointers to the objects in here.
+template<typename TFuncObject>
+class CFuncObjectBlocks
+{
+public:
+	template<typename... Args>
+	TFuncObject &emplace_back(Args &&...args)
+	{
+		if (m_arrBlocks.empty() || (m_arrBlocks.back().size() == m_arrBlocks.back().capacity())) {
+			m_arrBlocks.emplace_back();
+			m_arrBlocks.back().reserve(BLOCK_SIZE);		// Never grown past this, so objects don't move
+		}
+		return m_arrBlocks.back().emplace_back(std::forward<Args>(args)...);
+	}
+
+private:
+	static constexpr std::size_t BLOCK_SIZE = 256;
+	std::vector< std::vector<TFuncObject> > m_arrBlocks;
+};
+
+class CFuncObjectStore
+{
+public:
+	CFuncObjectStore() = default;
+	CFuncObjectStore(const CFuncObjectStore &) = delete;		// Objects point back to their parent file, so can't be copied with it
+	CFuncObjectStore &operator=(const CFuncObjectStore &) = delete;
+
+	// Creates a new CFuncAsmInstObject or CFuncDataByteObject from aSource (CStringArray or CFuncBinaryReader):
+	template<typename TFuncObject, typename TSource>
+	TFuncObject *newObject(const CFuncDescFile &aParentFuncFile, const CFuncDesc &aParentFunc, TSource &aSource)
+	{
+		if constexpr (std::is_same_v<TFuncObject, CFuncAsmInstObject>) {
+			return &m_arrAsmInstObjects.emplace_back(*this, aParentFuncFile, aParentFunc, aSource);
+		} else {
+			static_assert(std::is_same_v<TFuncObject, CFuncDataByteObject>);
+			return &m_arrDataByteObjects.emplace_back(*this, aParentFuncFile, aParentFunc, aSource);
+		}
+	}
+
+	CFuncByteSpan addBytes(const TMemoryElement *pBytes, std::size_t nCount);
+	CFuncByteSpan addHexBytes(const TString &strHexBytes);		// Adds bytes from a string of hex digit pairs
+	const TMemoryElement *bytes(const CFuncByteSpan &aSpan) const { return m_arrBytes.data() + aSpan.m_nOffset; }
+
+	TFuncStringIndex addString(const TString &strValue);		// Interns strValue, returning its index
+	const TString &string(TFuncStringIndex nIndex) const { return m_arrStrings[nIndex]; }
+
+private:
+	CFuncObjectBlocks<CFuncAsmInstObject> m_arrAsmInstObjects;
+	CFuncObjectBlocks<CFuncDataByteObject> m_arrDataByteObjects;
+	CMemoryArray m_arrBytes;
+	std::deque<TString> m_arrStrings;			// Deque so that the string_view keys of m_mapStrings stay valid
+	std::unordered_map<std::string_view, TFuncStringIndex> m_mapStrings;
+};
+
+// ============================================================================
+
+//////////////////////////////////////////////////////////////////////
+// CDiffSymbolPool Class
+//////////////////////////////////////////////////////////////////////
+//		This class interns the comparison strings of function objects
+//		(their exact bytes and their ExportToDiff output for each diff
+//		level) into compact integer symbols.  The strings are interned
+//		uppercased so that two symbols are equal if and only if the
+//		original strings are equal via compareNoCase.  A single pool
+//		is shared by all files so that symbols are directly comparable
+//		between them.
+typedef uint32_t TDiffSymbol;
+typedef std::vector<TDiffSymbol> CDiffSymbolArray;
+
+// Diff Symbol Slots -- Each CFuncObject is tokenized into this many
+//		consecutive symbols in the CFuncDesc symbol array:
+enum DIFF_SYMBOL_SLOT {
+	DSS_EXACT_BYTES = 0,						// Symbol for exact bytes match
+	DSS_DIFF_LEVEL = 1,							// First of NUM_FUNC_DIFF_LEVELS symbols for ExportToDiff() levels
+	NUM_DIFF_SYMBOL_SLOTS = DSS_DIFF_LEVEL + NUM_FUNC_DIFF_LEVELS,
+};
+
+// Content Hashes -- 64-bit FNV-1a hashes of the (uppercased) comparison
+//		strings of a function, identifying its content across runs (unlike
+//		the diff symbols, which are only valid within a single run):
+typedef uint64_t TContentHash;
+constexpr TContentHash CONTENT_HASH_INIT = 0xcbf29ce484222325ull;
+
+inline TContentHash hashContent(const TString &strContent, TContentHash nHash = CONTENT_HASH_INIT)
+{
+	for (auto const &ch : strContent) {
+		nHash ^= static_cast<unsigned char>(ch);
+		nHash *= 0x100000001b3ull;
+	}
+	nHash ^= '\n';		// Separator, so that concatenations of different strings give different hashes
+	return (nHash * 0x100000001b3ull);
+}
+
+class CDiffSymbolPool
+{
+public:
+	TDiffSymbol intern(TString strSymbol);		// Returns the symbol for strSymbol, adding it if new (case-insensitive)
+
+	static CDiffSymbolPool &instance();
+
+private:
+	std::mutex m_mtxSymbols;
+	std::unordered_map<TString, TDiffSymbol> m_mapSymbols;
+};
+
+// ============================================================================
+
 //////////////////////////////////////////////////////////////////////
 // CFuncDesc Class
 //////////////////////////////////////////////////////////////////////
 //		This specifies exactly one function as an array of CFuncObject
-//		objects:
-class CFuncDesc : public std::vector< std::shared_ptr<CFuncObject> >
+//		objects, which are owned by the CFuncObjectStore of the file:
+class CFuncDesc : public std::vector< CFuncObject * >
 {
 public:
 	CFuncDesc(TAddress nAddress, const TString &strNames);
@@ -213,7 +370,18 @@ public:
 
 	virtual void ExportToDiff(FUNC_DIFF_LEVEL nLevel, CStringArray &anArray) const;
 
-	void Add(std::shared_ptr<CFuncObject>pObj);
+	// Diff Symbols are NUM_DIFF_SYMBOL_SLOTS consecutive symbols per object, in object order:
+	void ExportToDiffSymbols(CDiffSymbolPool &aPool, CDiffSymbolArray &anArray, TContentHash *pContentHash = nullptr) const;	// Optionally also hashes the symbol strings into pContentHash
+	void BuildDiffSymbols(CDiffSymbolPool &aPool);
+	void SetDiffSymbols(CDiffSymbolArray &&arrDiffSymbols, TContentHash nContentHash);	// Sets symbols previously built by BuildDiffSymbols, such as from a binary file
+	TContentHash GetContentHash() const { return m_nContentHash; }		// Hash of the diff symbol strings (valid only if HasDiffSymbols())
+	bool HasDiffSymbols() const { return (m_arrDiffSymbols.size() == (size() * NUM_DIFF_SYMBOL_SLOTS)); }
+	const CDiffSymbolArray &GetDiffSymbols() const { return m_arrDiffSymbols; }
+	const CDiffSymbolArray &GetDiffSymbolSet(DIFF_SYMBOL_SLOT nSlot) const { return m_arrDiffSymbolSets[nSlot]; }		// Sorted unique symbols used in nSlot (valid only if HasDiffSymbols())
+
+	void Add(CFuncObject *pObj);
+
+	void WriteBinary(CFuncBinaryWriter &aWriter) const;		// Writes names, objects, and diff symbols (which must have been built) to a binary file
 
 
 	// Warning: This object supports ADDing only!  Removing an item does NOT remove labels
@@ -231,6 +399,10 @@ protected:
 	//			contain 'L' labels.
 	CLabelTableMap m_mapFuncNameTable;				// Table of names for this function.  First entry is typical default
 	CLabelTableMap m_mapLabelTable;					// Table of labels in this function.  First entry is typical default
+
+	CDiffSymbolArray m_arrDiffSymbols;				// Pre-tokenized comparison symbols, built once the function is complete (see BuildDiffSymbols)
+	CDiffSymbolArray m_arrDiffSymbolSets[NUM_DIFF_SYMBOL_SLOTS];	// Sorted unique symbols of each slot of m_arrDiffSymbols
+	TContentHash m_nContentHash = CONTENT_HASH_INIT;	// Hash of the strings of m_arrDiffSymbols
 };
 typedef std::vector< std::shared_ptr<CFuncDesc> > CFuncDescArray;
 typedef std::multimap< CFuncDesc::size_type, CFuncDescArray::size_type, std::greater<CFuncDesc::size_type> > CFunctionSizeMultimap;	// MultiMap of Function Length to Function Index
@@ -250,6 +422,11 @@ public:
 	using MEMORY_TYPE = CDisassembler::MEMORY_TYPE;
 
 	virtual bool ReadFuncDescFile(std::shared_ptr<CFuncDescFile> pThis, ifstreamFuncDescFile &inFile, std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr, int nStartLineCount = 0);			// Read already open control file 'infile', outputs messages to 'msgFile' and errors to 'errFile', nStartLineCount = initial line counter value
+	virtual bool ReadFuncDescFile(std::shared_ptr<CFuncDescFile> pThis, std::istream &inFile, const std::string &strFilename, std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr, int nStartLineCount = 0);	// Same as above, but reads the function definitions from any stream, such as directly from the disassembler's Pass3 output, with strFilename as the name to report them under
+	virtual bool ReadBinaryFile(std::shared_ptr<CFuncDescFile> pThis, const TString &strFilename, std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr);	// Reads (by mapping) a binary file written by WriteBinaryFile, outputs messages to 'msgFile' and errors to 'errFile'
+	virtual bool WriteBinaryFile(std::ostream &outFile) const;		// Writes everything read into this file, including the diff symbols, to a binary file (outFile must be opened in binary mode)
+	static bool isBinaryFile(const TString &strFilename);			// True if the file has the binary function description file signature
+	virtual bool ReadDisassembly(std::shared_ptr<CFuncDescFile> pThis, CDisassembler &aDisassembler, std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr);		// Disassembles the memory of 'aDisassembler' (which must already have its control file(s) read) and reads its function output directly, without writing and reparsing a functions file
 
 	virtual bool AddLabel(MEMORY_TYPE nMemoryType, TAddress nAddress, const TLabel &strLabel);
 	virtual bool AddrHasLabel(MEMORY_TYPE nMemoryType, TAddress nAddress) const;
@@ -278,10 +455,20 @@ public:
 		m_nUserDataProgressCallback = nUserData;
 	}
 
+	// Number of threads for ReadFuncDescFile() to parse the functions and build
+	//	their diff symbols on, default is 1.  The result is the same for any number:
+	virtual unsigned int readThreads() const { return m_nReadThreads; }
+	virtual void setReadThreads(unsigned int nThreads) { m_nReadThreads = nThreads; }
+
 	virtual bool allowMemRangeOverlap() const { return m_bAllowMemRangeOverlap; }
 	virtual size_t opcodeSymbolSize() const { return m_nOpcodeSymbolSize; }
 
+	const CFuncObjectStore &objectStore() const { return m_ObjectStore; }
+
 protected:
+	void SetFilename(const TString &strFilename);
+	void ReportContents(std::ostream &msgFile) const;	// Outputs the summary of what was read to msgFile
+
 	TString		m_strFilePathName;
 	TString		m_strFileName;
 
@@ -293,11 +480,14 @@ protected:
 	TFN_FuncAnalProgressCallback m_pfnProgressCallback = nullptr;
 	TUserData m_nUserDataProgressCallback = {};
 
+	unsigned int	m_nReadThreads = 1;		// See setReadThreads()
+
 	// Note: The File's Label Table only contains those labels defined
 	//			at the file level by "!" entries.  NOT those down at the
 	//			individual function level.  Specifically it doesn't
 	//			include 'L' names.
 	CLabelTableMap m_mapLabelTable[MEMORY_TYPE::NUM_MEMORY_TYPES];		// Table of labels.  First entry is typical default
+	CFuncObjectStore m_ObjectStore;						// Owner of the objects of all functions and data blocks
 	CFuncDescArray m_arrFunctions;						// Array of functions in the file
 	CFunctionSizeMultimap m_mapSortedFunctionMap;		// Mapping of functions by size
 
@@ -319,16 +509,15 @@ class CFuncDescFileArray : public std::vector< std::shared_ptr<CFuncDescFile> >
 public:
 	virtual CFuncDescArray::size_type GetFuncCount() const;
 
-	virtual double CompareFunctions(FUNC_COMPARE_TYPE nCompareType,
+	virtual CFuncCompareResult CompareFunctions(FUNC_COMPARE_TYPE nCompareType,
 									FUNC_COMPARE_METHOD nMethod,
 									size_type nFile1Ndx, std::size_t nFile1FuncNdx,
 									size_type nFile2Ndx, std::size_t nFile2FuncNdx,
 									bool bBuildEditScript) const;
-	virtual TString DiffFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC_COMPARE_METHOD nMethod,
+	virtual CFuncDiffResult DiffFunctions(FUNC_COMPARE_TYPE nCompareType, FUNC_COMPARE_METHOD nMethod,
 									int nFile1Ndx, int nFile1FuncNdx,
 									int nFile2Ndx, int nFile2FuncNdx,
 									OUTPUT_OPTIONS nOutputOptions,
-									double &nMatchPercent,
 									CSymbolMap *pSymbolMap = nullptr) const;
 
 	virtual void SetProgressCallback(TFN_FuncAnalProgressCallback pfnCallback, const TUserData &nUserData = {})
@@ -353,9 +542,16 @@ protected:
 class CSymbolMap
 {
 public:
+	CSymbolMap();
+	CSymbolMap(const CSymbolMap &) = delete;			// Not copyable, since m_mapSymbolIDs views m_arrSymbols
+	CSymbolMap &operator=(const CSymbolMap &) = delete;
+	CSymbolMap(CSymbolMap &&) = default;
+	CSymbolMap &operator=(CSymbolMap &&) = default;
+
 	bool empty() const;
 
 	void AddObjectMapping(const CFuncObject &aLeftObject, const CFuncObject &aRightObject);
+	void Merge(const CSymbolMap &aSymbolMap);			// Adds all of the mappings from aSymbolMap to this map
 
 	CSymbolArray GetLeftSideCodeSymbolList() const;		// Returns sorted list of left-side code symbols
 	CSymbolArray GetRightSideCodeSymbolList() const;	// Returns sorted list of right-side code symbols
@@ -378,21 +574,31 @@ public:
 	static THitCount GetLeftSideDataHitList(const CSymbolMap *pThis, const TSymbol &aSymbol, CSymbolArray &aSymbolArray, CHitCountArray &aHitCountArray) { return pThis->GetLeftSideDataHitList(aSymbol, aSymbolArray, aHitCountArray); }
 	static THitCount GetRightSideDataHitList(const CSymbolMap *pThis, const TSymbol &aSymbol, CSymbolArray &aSymbolArray, CHitCountArray &aHitCountArray) { return pThis->GetRightSideDataHitList(aSymbol, aSymbolArray, aHitCountArray); }
 
+protected:
+	static constexpr TSymbolID EMPTY_SYMBOL = 0;		// ID of the empty symbol, used for unmatched mappings
+
+	// Hits of one symbol: the number of times it was mapped to each target symbol:
+	struct TSymbolHits {
+		THitCount m_nTotal = 0;
+		std::unordered_map<TSymbolID, THitCount> m_mapHits;
+	};
+	typedef std::unordered_map<TSymbolID, TSymbolHits> CSymbolHitsMap;
+
+	TSymbolID internSymbol(std::string_view strSymbol);		// Returns the ID of strSymbol, adding it if it's new
+
 private:
-	CSymbolArray GetSymbolList(const CSymbolArrayMap &mapSymbolArrays) const;
-	THitCount GetHitList(const CSymbolArrayMap &mapSymbolArrays,
+	CSymbolArray GetSymbolList(const CSymbolHitsMap &mapSymbolHits) const;
+	THitCount GetHitList(const CSymbolHitsMap &mapSymbolHits,
 						const TSymbol &aSymbol, CSymbolArray &aSymbolArray, CHitCountArray &aHitCountArray) const;
 
 protected:
-	void AddLeftSideCodeSymbol(const TSymbol &aLeftSymbol, const TSymbol &aRightSymbol);
-	void AddRightSideCodeSymbol(const TSymbol &aRightSymbol, const TSymbol &aLeftSymbol);
-	void AddLeftSideDataSymbol(const TSymbol &aLeftSymbol, const TSymbol &aRightSymbol);
-	void AddRightSideDataSymbol(const TSymbol &aRightSymbol, const TSymbol &aLeftSymbol);
-
-	CSymbolArrayMap m_LeftSideCodeSymbols;
-	CSymbolArrayMap m_RightSideCodeSymbols;
-	CSymbolArrayMap m_LeftSideDataSymbols;
-	CSymbolArrayMap m_RightSideDataSymbols;
+	std::deque<TSymbol> m_arrSymbols;				// Symbol text by TSymbolID (deque so that the views in m_mapSymbolIDs stay valid)
+	std::unordered_map<std::string_view, TSymbolID> m_mapSymbolIDs;
+
+	CSymbolHitsMap m_LeftSideCodeSymbols;
+	CSymbolHitsMap m_RightSideCodeSymbols;
+	CSymbolHitsMap m_LeftSideDataSymbols;
+	CSymbolHitsMap m_RightSideDataSymbols;
 };
 
 // ============================================================================
@@ -0,0 +1,406 @@
+//
+//	Function Comparison Matrix
+//
+//
+//	Fuzzy Function Analyzer
+//	for the Generic Code-Seeking Disassembler
+//	Copyright(c)2021 by Donna Whisnant
+//
+
+//
+//	The Binary Matrix File is defined as follows (all values are in the
+//	native byte order of the machine writing it, which is verified by the
+//	byte-order marker when read):
+//
+//		CBinaryMatrixHeader			(64 bytes)
+//		TMatrixHash[m_nRows]		Row (left file) function hashes
+//		TMatrixHash[m_nCols]		Column (right file) function hashes
+//		CBinaryMatrixRows			(16 bytes, only if MFF_PARTIAL is set)
+//		double[]					Results, in CCompResultMatrix storage
+//										order.  That is, m_nRows*m_nCols
+//										values, row by row, or if the
+//										MFF_SYMMETRIC flag is set, only the
+//										m_nRows*(m_nRows+1)/2 values of the
+//										upper triangle, packed row by row.
+//										If MFF_PARTIAL is set, only the
+//										values of the CBinaryMatrixRows
+//										rows are stored.
+//
+//	The header's m_nRows and m_nCols, and the hashes, are always those of
+//	the whole matrix, even for a partial file.
+//
+//	Since the header and hashes are all multiples of 8 bytes, the results
+//	are naturally aligned when the file is mapped at a page boundary.
+//
+
+#include "funcmtx.h"
+#include "mapfile.h"
+
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+
+// ============================================================================
+
+static constexpr char g_arrMatrixFileSignature[8] = { 'F', 'A', 'M', 'A', 'T', 'R', 'X', 0 };
+static constexpr uint32_t g_nMatrixFileByteOrder = 0x01020304ul;
+static constexpr uint32_t g_nMatrixFileVersion = 2;		// Version 2 : Hashes are of function content rather than function names
+
+enum MATRIX_FILE_FLAGS {
+	MFF_NONE = 0,
+	MFF_SYMMETRIC = 1,			// Only the upper triangle is stored (self-comparison)
+	MFF_PARTIAL = 2,			// Only a range of rows is stored (see CBinaryMatrixRows)
+	MFF_ALL = (MFF_SYMMETRIC | MFF_PARTIAL),		// Every known flag, for rejecting the rest
+};
+
+struct CBinaryMatrixHeader {
+	char m_arrSignature[8];
+	uint32_t m_nByteOrder;
+	uint32_t m_nVersion;
+	uint32_t m_nCompareMethod;	// FUNC_COMPARE_METHOD
+	uint32_t m_nDiffLevels;		// NUM_FUNC_DIFF_LEVELS of the comparison
+	uint32_t m_nFlags;			// MATRIX_FILE_FLAGS
+	uint32_t m_nReserved1;
+	uint64_t m_nRows;
+	uint64_t m_nCols;
+	double m_nPreFilterLimit;
+	uint64_t m_nReserved2;
+};
+static_assert(sizeof(CBinaryMatrixHeader) == 64, "Binary matrix header must be 64 bytes");
+
+struct CBinaryMatrixRows {
+	uint64_t m_nFirstRow;
+	uint64_t m_nEndRow;			// One past the last row
+};
+static_assert(sizeof(CBinaryMatrixRows) == 16, "Binary matrix rows must be 16 bytes");
+
+// Binary matrix file mapped and checked by CCompResultMatrix::mapBinary():
+struct CBinaryMatrixMapping {
+	std::shared_ptr<const void> m_pMapping;
+	const CBinaryMatrixHeader *m_pHeader = nullptr;
+	const TMatrixHash *m_pHashes = nullptr;		// Row hashes, followed by the column hashes
+	uint64_t m_nFirstRow = 0;					// Rows of the results, all of them unless MFF_PARTIAL
+	uint64_t m_nEndRow = 0;
+	const double *m_pResults = nullptr;
+	std::size_t m_nResultCount = 0;
+};
+
+// ============================================================================
+
+CMatrixHashArray CCompResultMatrix::hashFunctions(const CFuncDescFile &aFuncFile)
+{
+	CMatrixHashArray arrHashes;
+	arrHashes.reserve(aFuncFile.GetFuncCount());
+	for (CFuncDescArray::size_type ndx = 0; ndx < aFuncFile.GetFuncCount(); ++ndx) {
+		const CFuncDesc &function = aFuncFile.GetFunc(ndx);
+		TMatrixHash nHash = function.GetContentHash();
+		if (!function.HasDiffSymbols()) {
+			CDiffSymbolArray arrTempSymbols;
+			function.ExportToDiffSymbols(CDiffSymbolPool::instance(), arrTempSymbols, &nHash);
+		}
+		// Besides the content, CompareFunctions also compares the primary
+		//	labels at the functions' addresses:
+		nHash = hashContent(makeUpperCopy(aFuncFile.GetPrimaryLabel(CFuncDescFile::MEMORY_TYPE::MT_ROM, function.GetMainAddress())), nHash);
+		arrHashes.push_back(nHash);
+	}
+	return arrHashes;
+}
+
+bool CCompResultMatrix::isBinaryFile(const TString &strFilename)
+{
+	std::ifstream fileIn(strFilename, std::ios_base::in | std::ios_base::binary);
+	char arrSignature[sizeof(g_arrMatrixFileSignature)];
+	if (!fileIn.read(arrSignature, sizeof(arrSignature))) return false;
+	return (std::memcmp(arrSignature, g_arrMatrixFileSignature, sizeof(arrSignature)) == 0);
+}
+
+bool CCompResultMatrix::writeBinaryRows(std::ostream &outFile, const CCompMatrixInfo &info, size_type nFirstRow, size_type nEndRow) const
+{
+	assert(info.m_arrRowHashes.size() == m_nRows);
+	assert(info.m_arrColHashes.size() == m_nCols);
+	assert((nFirstRow <= nEndRow) && (nEndRow <= m_nRows));
+	const bool bPartial = ((nFirstRow != 0) || (nEndRow != m_nRows));
+
+	CBinaryMatrixHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.m_arrSignature, g_arrMatrixFileSignature, sizeof(header.m_arrSignature));
+	header.m_nByteOrder = g_nMatrixFileByteOrder;
+	header.m_nVersion = g_nMatrixFileVersion;
+	header.m_nCompareMethod = info.m_nCompareMethod;
+	header.m_nDiffLevels = NUM_FUNC_DIFF_LEVELS;
+	header.m_nFlags = (m_bSymmetric ? MFF_SYMMETRIC : MFF_NONE) | (bPartial ? MFF_PARTIAL : MFF_NONE);
+	header.m_nRows = m_nRows;
+	header.m_nCols = m_nCols;
+	header.m_nPreFilterLimit = info.m_nPreFilterLimit;
+
+	outFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	outFile.write(reinterpret_cast<const char *>(info.m_arrRowHashes.data()), info.m_arrRowHashes.size() * sizeof(TMatrixHash));
+	outFile.write(reinterpret_cast<const char *>(info.m_arrColHashes.data()), info.m_arrColHashes.size() * sizeof(TMatrixHash));
+	if (bPartial) {
+		const CBinaryMatrixRows rows = { nFirstRow, nEndRow };
+		outFile.write(reinterpret_cast<const char *>(&rows), sizeof(rows));
+	}
+	const size_type nFirstResult = rowOffset(nFirstRow, m_nCols, m_bSymmetric);
+	outFile.write(reinterpret_cast<const char *>((m_pMapping ? m_pMappedResults : m_arrResults.data()) + nFirstResult),
+					(rowOffset(nEndRow, m_nCols, m_bSymmetric) - nFirstResult) * sizeof(double));
+	return outFile.good();
+}
+
+bool CCompResultMatrix::mapBinary(const TString &strFilename, CBinaryMatrixMapping &mapping, TString &strError)
+{
+	std::size_t nFileSize = 0;
+	std::shared_ptr<const void> pMapping = mapFile(strFilename, nFileSize);
+	if (!pMapping) {
+		strError = "Unable to map file";
+		return false;
+	}
+
+	const uint8_t *pData = static_cast<const uint8_t *>(pMapping.get());
+	if (nFileSize < sizeof(CBinaryMatrixHeader)) {
+		strError = "File too short for header";
+		return false;
+	}
+	const CBinaryMatrixHeader &header = *reinterpret_cast<const CBinaryMatrixHeader *>(pData);
+	if (std::memcmp(header.m_arrSignature, g_arrMatrixFileSignature, sizeof(header.m_arrSignature)) != 0) {
+		strError = "Not a binary matrix file";
+		return false;
+	}
+	if (header.m_nByteOrder != g_nMatrixFileByteOrder) {
+		strError = "Matrix file was written on a machine with a different byte order";
+		return false;
+	}
+	if (header.m_nVersion != g_nMatrixFileVersion) {
+		strError = "Unsupported matrix file version " + std::to_string(header.m_nVersion);
+		return false;
+	}
+	if ((header.m_nCompareMethod >= FCM_COUNT) || (header.m_nDiffLevels != NUM_FUNC_DIFF_LEVELS)) {
+		strError = "Matrix file was computed with an unsupported comparison";
+		return false;
+	}
+	if (header.m_nFlags & ~static_cast<uint32_t>(MFF_ALL)) {
+		strError = "Unsupported matrix file flags";
+		return false;
+	}
+	const bool bSymmetric = ((header.m_nFlags & MFF_SYMMETRIC) != 0);
+	if (bSymmetric && (header.m_nRows != header.m_nCols)) {
+		strError = "Invalid symmetric matrix size";
+		return false;
+	}
+
+	// Everything after the header is checked against what's left of the
+	//	file as it goes, dividing rather than multiplying out the header's
+	//	sizes, so that no size from the file can overflow:
+	const std::size_t nHashesOffset = sizeof(CBinaryMatrixHeader);
+	std::size_t nRemaining = nFileSize - nHashesOffset;
+	if ((header.m_nRows > (nRemaining / sizeof(TMatrixHash))) ||
+		(header.m_nCols > ((nRemaining / sizeof(TMatrixHash)) - header.m_nRows))) {
+		strError = "File too short for its hashes";
+		return false;
+	}
+	nRemaining -= (header.m_nRows + header.m_nCols) * sizeof(TMatrixHash);
+	std::size_t nResultsOffset = nFileSize - nRemaining;
+	uint64_t nFirstRow = 0;
+	uint64_t nEndRow = header.m_nRows;
+	if (header.m_nFlags & MFF_PARTIAL) {
+		if (nRemaining < sizeof(CBinaryMatrixRows)) {
+			strError = "File too short for its rows";
+			return false;
+		}
+		const CBinaryMatrixRows &rows = *reinterpret_cast<const CBinaryMatrixRows *>(pData + nResultsOffset);
+		nFirstRow = rows.m_nFirstRow;
+		nEndRow = rows.m_nEndRow;
+		if ((nFirstRow > nEndRow) || (nEndRow > header.m_nRows)) {
+			strError = "Invalid partial matrix rows";
+			return false;
+		}
+		nRemaining -= sizeof(CBinaryMatrixRows);
+		nResultsOffset += sizeof(CBinaryMatrixRows);
+	}
+	// The row offsets can't overflow with nEndRow*cols in range, as the
+	//	symmetric offsets are smaller, and they can't go negative with
+	//	nEndRow <= rows, and rows equal to columns if bSymmetric:
+	if ((header.m_nCols > 0) && (nEndRow > (std::numeric_limits<std::size_t>::max() / header.m_nCols))) {
+		strError = "File size doesn't match its header";
+		return false;
+	}
+	const std::size_t nResultCount = rowOffset(nEndRow, header.m_nCols, bSymmetric) - rowOffset(nFirstRow, header.m_nCols, bSymmetric);
+	if ((nResultCount > (nRemaining / sizeof(double))) || (nRemaining != (nResultCount * sizeof(double)))) {
+		strError = "File size doesn't match its header";
+		return false;
+	}
+
+	mapping.m_pMapping = pMapping;
+	mapping.m_pHeader = &header;
+	mapping.m_pHashes = reinterpret_cast<const TMatrixHash *>(pData + nHashesOffset);
+	mapping.m_nFirstRow = nFirstRow;
+	mapping.m_nEndRow = nEndRow;
+	mapping.m_pResults = reinterpret_cast<const double *>(pData + nResultsOffset);
+	mapping.m_nResultCount = nResultCount;
+	return true;
+}
+
+bool CCompResultMatrix::readBinary(const TString &strFilename, CCompMatrixInfo &info, TString &strError)
+{
+	CBinaryMatrixMapping mapping;
+	if (!mapBinary(strFilename, mapping, strError)) return false;
+	const CBinaryMatrixHeader &header = *mapping.m_pHeader;
+	if (header.m_nFlags & MFF_PARTIAL) {
+		strError = "Matrix file is a partial matrix of rows " + std::to_string(mapping.m_nFirstRow) + ":" +
+					std::to_string(mapping.m_nEndRow) + ", which must be merged with the other rows first";
+		return false;
+	}
+
+	info.m_nCompareMethod = static_cast<FUNC_COMPARE_METHOD>(header.m_nCompareMethod);
+	info.m_nPreFilterLimit = header.m_nPreFilterLimit;
+	info.m_arrRowHashes.assign(mapping.m_pHashes, mapping.m_pHashes + header.m_nRows);
+	info.m_arrColHashes.assign(mapping.m_pHashes + header.m_nRows, mapping.m_pHashes + header.m_nRows + header.m_nCols);
+
+	m_nRows = header.m_nRows;
+	m_nCols = header.m_nCols;
+	m_bSymmetric = ((header.m_nFlags & MFF_SYMMETRIC) != 0);
+	m_arrResults.clear();
+	m_arrResults.shrink_to_fit();
+	m_pMappedResults = mapping.m_pResults;
+	m_pMapping = mapping.m_pMapping;
+	return true;
+}
+
+bool CCompResultMatrix::mergeBinary(const CStringArray &arrFilenames, std::ostream &outFile, TString &strError)
+{
+	std::vector<CBinaryMatrixMapping> arrMappings(arrFilenames.size());
+	for (CStringArray::size_type ndx = 0; ndx < arrFilenames.size(); ++ndx) {
+		if (!mapBinary(arrFilenames.at(ndx), arrMappings[ndx], strError)) {
+			strError = "\"" + arrFilenames.at(ndx) + "\" : " + strError;
+			return false;
+		}
+	}
+	if (arrMappings.empty()) {
+		strError = "No matrix files to merge";
+		return false;
+	}
+
+	// The files must all be rows of the same matrix, computed the same way,
+	//	other than their pre-filter limits, where the highest one applies to
+	//	the merged matrix:
+	const CBinaryMatrixHeader &header0 = *arrMappings.front().m_pHeader;
+	const std::size_t nHashCount = header0.m_nRows + header0.m_nCols;
+	double nPreFilterLimit = header0.m_nPreFilterLimit;
+	for (CStringArray::size_type ndx = 1; ndx < arrMappings.size(); ++ndx) {
+		const CBinaryMatrixHeader &header = *arrMappings[ndx].m_pHeader;
+		if ((header.m_nCompareMethod != header0.m_nCompareMethod) ||
+			((header.m_nFlags & MFF_SYMMETRIC) != (header0.m_nFlags & MFF_SYMMETRIC)) ||
+			(header.m_nRows != header0.m_nRows) ||
+			(header.m_nCols != header0.m_nCols) ||
+			!std::equal(arrMappings[ndx].m_pHashes, arrMappings[ndx].m_pHashes + nHashCount, arrMappings.front().m_pHashes)) {
+			strError = "\"" + arrFilenames.at(ndx) + "\" isn't from the same comparison as \"" + arrFilenames.front() + "\"";
+			return false;
+		}
+		nPreFilterLimit = std::max(nPreFilterLimit, header.m_nPreFilterLimit);
+	}
+
+	// And have every row exactly once:
+	std::vector<CStringArray::size_type> arrOrder(arrMappings.size());
+	for (CStringArray::size_type ndx = 0; ndx < arrOrder.size(); ++ndx) arrOrder[ndx] = ndx;
+	std::stable_sort(arrOrder.begin(), arrOrder.end(), [&arrMappings](CStringArray::size_type nLeft, CStringArray::size_type nRight)->bool {
+		return (arrMappings[nLeft].m_nFirstRow < arrMappings[nRight].m_nFirstRow);
+	});
+	uint64_t nNextRow = 0;
+	for (auto const & ndx : arrOrder) {
+		const CBinaryMatrixMapping &mapping = arrMappings[ndx];
+		if (mapping.m_nFirstRow == mapping.m_nEndRow) continue;		// No rows
+		if (mapping.m_nFirstRow != nNextRow) {
+			strError = ((mapping.m_nFirstRow < nNextRow) ? "Rows of \"" + arrFilenames.at(ndx) + "\" overlap those of another file" :
+															"Rows " + std::to_string(nNextRow) + ":" + std::to_string(mapping.m_nFirstRow) + " are missing");
+			return false;
+		}
+		nNextRow = mapping.m_nEndRow;
+	}
+	if (nNextRow != header0.m_nRows) {
+		strError = "Rows " + std::to_string(nNextRow) + ":" + std::to_string(header0.m_nRows) + " are missing";
+		return false;
+	}
+
+	CBinaryMatrixHeader header = header0;
+	header.m_nFlags &= ~MFF_PARTIAL;
+	header.m_nPreFilterLimit = nPreFilterLimit;
+	outFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	outFile.write(reinterpret_cast<const char *>(arrMappings.front().m_pHashes), nHashCount * sizeof(TMatrixHash));
+	for (auto const & ndx : arrOrder) {
+		outFile.write(reinterpret_cast<const char *>(arrMappings[ndx].m_pResults), arrMappings[ndx].m_nResultCount * sizeof(double));
+	}
+	return outFile.good();
+}
+
+// ============================================================================
+
+void CCompBestMatches::add(size_type nRow, size_type nCol, double nResult)
+{
+	if ((nResult <= 0.0) || (nResult < m_nMinLimit)) return;
+	if (m_bSymmetric) {
+		if (nRow == nCol) return;
+		addMatch(m_arrRows.at(nCol), nRow, nResult);
+		addMatch(m_arrCols.at(nRow), nCol, nResult);
+	}
+	addMatch(m_arrRows.at(nRow), nCol, nResult);
+	addMatch(m_arrCols.at(nCol), nRow, nResult);
+}
+
+void CCompBestMatches::addMatrix(const CCompResultMatrix &matrix)
+{
+	assert((matrix.rows() == rows()) && (matrix.cols() == cols()) && (matrix.isSymmetric() == m_bSymmetric));
+	for (size_type nRow = 0; nRow < matrix.rows(); ++nRow) {
+		for (size_type nCol = (m_bSymmetric ? (nRow + 1) : 0); nCol < matrix.cols(); ++nCol) {
+			add(nRow, nCol, matrix.at(nRow, nCol));
+		}
+	}
+}
+
+void CCompBestMatches::addMatch(TMatchList &list, size_type nIndex, double nResult) const
+{
+	std::lock_guard<std::mutex> lock(list.m_mtxMatches);
+	CMatchArray &arrMatches = list.m_arrMatches;
+
+	if ((arrMatches.size() >= m_nTopK) && (nResult < arrMatches[m_nTopK-1].m_nResult)) return;
+
+	const TMatch aMatch = { nIndex, nResult };
+	arrMatches.insert(std::upper_bound(arrMatches.begin(), arrMatches.end(), aMatch,
+						[](const TMatch &aLeft, const TMatch &aRight)->bool {
+							if (aLeft.m_nResult != aRight.m_nResult) return (aLeft.m_nResult > aRight.m_nResult);
+							return (aLeft.m_nIndex < aRight.m_nIndex);
+						}), aMatch);
+
+	// Drop anything that's fallen below the K'th result, keeping its ties:
+	if (arrMatches.size() > m_nTopK) {
+		const double nKthResult = arrMatches[m_nTopK-1].m_nResult;
+		while (arrMatches.back().m_nResult < nKthResult) arrMatches.pop_back();
+	}
+}
+
+double CCompBestMatches::threshold(size_type nRow, size_type nCol) const
+{
+	// It's kept if any of the lists it's added to keeps it:
+	double nThreshold = std::min(listThreshold(m_arrRows.at(nRow)), listThreshold(m_arrCols.at(nCol)));
+	if (m_bSymmetric && (nRow != nCol)) {
+		nThreshold = std::min(nThreshold, std::min(listThreshold(m_arrRows.at(nCol)), listThreshold(m_arrCols.at(nRow))));
+	}
+	return nThreshold;
+}
+
+double CCompBestMatches::listThreshold(const TMatchList &list) const
+{
+	std::lock_guard<std::mutex> lock(list.m_mtxMatches);
+	if (list.m_arrMatches.size() < m_nTopK) return m_nMinLimit;
+	return std::max(m_nMinLimit, list.m_arrMatches[m_nTopK-1].m_nResult);
+}
+
+std::span<const CCompBestMatches::TMatch> CCompBestMatches::bestOf(const CMatchArray &arrMatches)
+{
+	if (arrMatches.empty()) return {};
+	auto const itrEnd = std::find_if(arrMatches.cbegin(), arrMatches.cend(), [nBest = arrMatches.front().m_nResult](const TMatch &aMatch)->bool {
+		return (aMatch.m_nResult != nBest);
+	});
+	return std::span<const TMatch>(arrMatches.data(), static_cast<std::size_t>(itrEnd - arrMatches.cbegin()));
+}
+
+// ============================================================================
@@ -0,0 +1,212 @@
+//
+//	Function Comparison Matrix
+//
+//
+//	Fuzzy Function Analyzer
+//	for the Generic Code-Seeking Disassembler
+//	Copyright(c)2021 by Donna Whisnant
+//
+
+#ifndef FUNC_MTX_H_
+#define FUNC_MTX_H_
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <span>
+#include <mutex>
+#include <stdint.h>
+
+#include <stringhelp.h>
+
+#include "funcdesc.h"
+
+#include <assert.h>
+
+// ============================================================================
+
+typedef TContentHash TMatrixHash;
+typedef std::vector<TMatrixHash> CMatrixHashArray;
+
+// Information stored alongside the results in a binary matrix file,
+//	used to verify that the matrix still matches the functions it's
+//	being applied to.  Since a comparison result depends only on the
+//	content of the two functions compared, the row and column hashes
+//	also allow the results of unchanged functions to be reused by a
+//	later run after only some of the functions have changed:
+struct CCompMatrixInfo {
+	FUNC_COMPARE_METHOD m_nCompareMethod = FCM_DYNPROG_XDROP;
+	double m_nPreFilterLimit = 0.0;		// Pre-Filter limit used when computing the matrix (0 if none, see -pf), results below it are stored as 0
+	CMatrixHashArray m_arrRowHashes;	// Hash of each function of the left file (rows), see hashFunctions()
+	CMatrixHashArray m_arrColHashes;	// Hash of each function of the right file (columns), see hashFunctions()
+};
+
+struct CBinaryMatrixMapping;		// Mapped binary matrix file, see funcmtx.cpp
+
+//////////////////////////////////////////////////////////////////////
+// CCompResultMatrix Class
+//////////////////////////////////////////////////////////////////////
+//		Matrix of comparison results of each function (or data block) in
+//		the left file (rows) against each of those in the right file
+//		(columns).  When a file is compared against itself, the results
+//		are symmetric (the order of the two functions passed to
+//		CompareFunctions has no effect on the outcome) and so only the
+//		upper triangle, including the diagonal, is stored, packed row by
+//		row.  Accesses below the diagonal are mirrored.
+//
+//		The matrix can be written to and read from a binary file, which
+//		stores the results exactly as they are held in memory, so that
+//		reading it is just a matter of mapping the file and checking
+//		its header.  A mapped matrix is read-only.
+//
+//		A range of its rows can also be written as a partial matrix file,
+//		so that the rows of one matrix can be computed separately, such as
+//		on different machines, and then merged into the whole matrix file.
+//		Since the results are stored row by row, the rows of a partial file
+//		are simply one slice of the whole matrix file's results.
+class CCompResultMatrix
+{
+public:
+	typedef std::vector<double>::size_type size_type;
+
+	void resize(size_type nRows, size_type nCols, bool bSymmetric)
+	{
+		assert(!bSymmetric || (nRows == nCols));
+		m_nRows = nRows;
+		m_nCols = nCols;
+		m_bSymmetric = bSymmetric;
+		m_pMapping.reset();
+		m_pMappedResults = nullptr;
+		m_arrResults.assign(storageSize(nRows, nCols, bSymmetric), 0.0);
+	}
+
+	size_type rows() const { return m_nRows; }
+	size_type cols() const { return m_nCols; }
+	bool isSymmetric() const { return m_bSymmetric; }
+	bool isMapped() const { return (m_pMapping != nullptr); }
+
+	double at(size_type nRow, size_type nCol) const { return (m_pMapping ? m_pMappedResults : m_arrResults.data())[index(nRow, nCol)]; }
+	void set(size_type nRow, size_type nCol, double nValue) { assert(!m_pMapping); m_arrResults[index(nRow, nCol)] = nValue; }
+
+	// Result used for finding best matches.  When self-comparing,
+	//	everything trivially matches itself, so the diagonal is skipped:
+	double match(size_type nRow, size_type nCol) const { return ((m_bSymmetric && (nRow == nCol)) ? 0.0 : at(nRow, nCol)); }
+
+	// Binary Matrix Files:
+	static CMatrixHashArray hashFunctions(const CFuncDescFile &aFuncFile);	// Hashes everything about each function that affects its comparison results
+	static bool isBinaryFile(const TString &strFilename);		// True if the file has the binary matrix file signature
+	bool writeBinary(std::ostream &outFile, const CCompMatrixInfo &info) const { return writeBinaryRows(outFile, info, 0, m_nRows); }
+	bool writeBinaryRows(std::ostream &outFile, const CCompMatrixInfo &info, size_type nFirstRow, size_type nEndRow) const;	// Writes rows [nFirstRow, nEndRow), as a partial matrix file unless it's all of them
+	bool readBinary(const TString &strFilename, CCompMatrixInfo &info, TString &strError);	// Maps the file as this matrix's results, returning false with strError on failure
+	static bool mergeBinary(const CStringArray &arrFilenames, std::ostream &outFile, TString &strError);	// Merges partial matrix files, which together must have every row once, into a whole matrix file
+
+protected:
+	static size_type storageSize(size_type nRows, size_type nCols, bool bSymmetric)
+	{
+		return rowOffset(nRows, nCols, bSymmetric);
+	}
+
+	static size_type rowOffset(size_type nRow, size_type nCols, bool bSymmetric)		// Storage index of the row's first result
+	{
+		return (bSymmetric ? ((nRow * nCols) - ((nRow * (nRow - 1)) / 2)) : (nRow * nCols));
+	}
+
+	size_type index(size_type nRow, size_type nCol) const
+	{
+		assert((nRow < m_nRows) && (nCol < m_nCols));
+		if (!m_bSymmetric) return ((nRow * m_nCols) + nCol);
+		if (nRow > nCol) std::swap(nRow, nCol);
+		return (rowOffset(nRow, m_nCols, true) + (nCol - nRow));		// Each row 'r' stores only columns r..N-1
+	}
+
+	static bool mapBinary(const TString &strFilename, CBinaryMatrixMapping &mapping, TString &strError);
+
+private:
+	size_type m_nRows = 0;
+	size_type m_nCols = 0;
+	bool m_bSymmetric = false;
+	std::vector<double> m_arrResults;
+	std::shared_ptr<const void> m_pMapping;		// Mapped binary file, if reading one (see readBinary())
+	const double *m_pMappedResults = nullptr;	// Results within m_pMapping
+};
+
+//////////////////////////////////////////////////////////////////////
+// CCompBestMatches Class
+//////////////////////////////////////////////////////////////////////
+//		Best comparison results of each row and each column, as would be
+//		found by scanning a CCompResultMatrix with match(), but without
+//		needing to store (or scan) the whole matrix.  Each row and column
+//		keeps only its top 'K' results that meet the match limit, sorted
+//		by descending result and then by ascending index.  Any results
+//		tied with the K'th are also kept, so the set of best matches
+//		(those tied with the first) is always complete, even for K=1.
+//
+//		Results can be added from multiple threads at once.
+class CCompBestMatches
+{
+public:
+	typedef CCompResultMatrix::size_type size_type;
+
+	struct TMatch {
+		size_type m_nIndex;		// Column index of a row's match, or row index of a column's match
+		double m_nResult;
+	};
+	typedef std::vector<TMatch> CMatchArray;
+
+	void resize(size_type nRows, size_type nCols, bool bSymmetric, size_type nTopK, double nMinLimit)
+	{
+		assert(!bSymmetric || (nRows == nCols));
+		assert(nTopK > 0);
+		m_bSymmetric = bSymmetric;
+		m_nTopK = nTopK;
+		m_nMinLimit = nMinLimit;
+		m_arrRows = std::vector<TMatchList>(nRows);
+		m_arrCols = std::vector<TMatchList>(nCols);
+	}
+
+	size_type rows() const { return m_arrRows.size(); }
+	size_type cols() const { return m_arrCols.size(); }
+	bool isSymmetric() const { return m_bSymmetric; }
+
+	// Adds a result, as it would be set in a CCompResultMatrix.  When
+	//	self-comparing, only one triangle needs to be added, as each result
+	//	is also added as its mirror, and the diagonal is ignored, same as
+	//	CCompResultMatrix::match():
+	void add(size_type nRow, size_type nCol, double nResult);
+	void addMatrix(const CCompResultMatrix &matrix);		// Adds all of the matrix's results
+
+	// Lowest result that add() could still keep for the given row and
+	//	column, so anything less than this can't change their matches.
+	//	It only ever rises as results are added:
+	double threshold(size_type nRow, size_type nCol) const;
+
+	// Top results of a row/column:
+	const CMatchArray &rowMatches(size_type nRow) const { return m_arrRows.at(nRow).m_arrMatches; }
+	const CMatchArray &colMatches(size_type nCol) const { return m_arrCols.at(nCol).m_arrMatches; }
+
+	// Best matches of a row/column, which are the results tied with the
+	//	first, in order of index.  Empty if nothing meets the match limit:
+	std::span<const TMatch> bestOfRow(size_type nRow) const { return bestOf(rowMatches(nRow)); }
+	std::span<const TMatch> bestOfCol(size_type nCol) const { return bestOf(colMatches(nCol)); }
+
+protected:
+	struct TMatchList {
+		mutable std::mutex m_mtxMatches;
+		CMatchArray m_arrMatches;
+	};
+
+	void addMatch(TMatchList &list, size_type nIndex, double nResult) const;
+	double listThreshold(const TMatchList &list) const;
+	static std::span<const TMatch> bestOf(const CMatchArray &arrMatches);
+
+private:
+	bool m_bSymmetric = false;
+	size_type m_nTopK = 1;
+	double m_nMinLimit = 0.0;
+	std::vector<TMatchList> m_arrRows;
+	std::vector<TMatchList> m_arrCols;
+};
+
+// ============================================================================
+
+#endif	// FUNC_MTX_H_
@@ -0,0 +1,76 @@
+//
+//	Memory Mapped Files
+//
+//
+//	Fuzzy Function Analyzer
+//	for the Generic Code-Seeking Disassembler
+//	Copyright(c)2021 by Donna Whisnant
+//
+
+#include "mapfile.h"
+
+#include <fstream>
+
+#ifdef OS_UNIX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#elif defined (OS_WIN32)
+#include <windows.h>
+#endif
+
+// ============================================================================
+
+std::shared_ptr<const void> mapFile(const TString &strFilename, std::size_t &nSize)
+{
+	nSize = 0;
+#ifdef OS_UNIX
+	int fd = open(strFilename.c_str(), O_RDONLY);
+	if (fd < 0) return std::shared_ptr<const void>();
+	struct stat statFile;
+	if ((fstat(fd, &statFile) != 0) || (statFile.st_size <= 0)) {
+		close(fd);
+		return std::shared_ptr<const void>();
+	}
+	std::size_t nFileSize = statFile.st_size;
+	void *pData = mmap(nullptr, nFileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);			// The mapping keeps its own reference to the file
+	if (pData == MAP_FAILED) return std::shared_ptr<const void>();
+	nSize = nFileSize;
+	return std::shared_ptr<const void>(pData, [nFileSize](const void *pData)->void {
+		munmap(const_cast<void *>(pData), nFileSize);
+	});
+#elif defined (OS_WIN32)
+	HANDLE hFile = CreateFileA(strFilename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE) return std::shared_ptr<const void>();
+	LARGE_INTEGER nFileSize;
+	if (!GetFileSizeEx(hFile, &nFileSize) || (nFileSize.QuadPart <= 0)) {
+		CloseHandle(hFile);
+		return std::shared_ptr<const void>();
+	}
+	HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(hFile);
+	if (hMapping == nullptr) return std::shared_ptr<const void>();
+	const void *pData = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(hMapping);		// The view keeps its own reference to the mapping
+	if (pData == nullptr) return std::shared_ptr<const void>();
+	nSize = static_cast<std::size_t>(nFileSize.QuadPart);
+	return std::shared_ptr<const void>(pData, [](const void *pData)->void {
+		UnmapViewOfFile(pData);
+	});
+#else
+	// No memory mapping available, so just read it into memory:
+	std::ifstream fileIn(strFilename, std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
+	if (!fileIn.is_open()) return std::shared_ptr<const void>();
+	std::streamoff nFileSize = fileIn.tellg();
+	if (nFileSize <= 0) return std::shared_ptr<const void>();
+	std::shared_ptr<double[]> pData(new double[(nFileSize + sizeof(double) - 1) / sizeof(double)]);
+	fileIn.seekg(0);
+	if (!fileIn.read(reinterpret_cast<char *>(pData.get()), nFileSize)) return std::shared_ptr<const void>();
+	nSize = static_cast<std::size_t>(nFileSize);
+	return std::shared_ptr<const void>(pData, pData.get());
+#endif
+}
+
+// ============================================================================
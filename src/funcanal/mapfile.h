@@ -0,0 +1,28 @@
+//
+//	Memory Mapped Files
+//
+//
+//	Fuzzy Function Analyzer
+//	for the Generic Code-Seeking Disassembler
+//	Copyright(c)2021 by Donna Whisnant
+//
+
+#ifndef MAP_FILE_H_
+#define MAP_FILE_H_
+
+#include <memory>
+#include <cstddef>
+
+#include <stringhelp.h>
+
+// ============================================================================
+
+// Maps the entire specified file read-only, returning an empty
+//	pointer on failure.  The mapping is released with the last
+//	copy of the returned pointer.  Where memory mapping isn't
+//	available, the file is read into an aligned memory buffer:
+extern std::shared_ptr<const void> mapFile(const TString &strFilename, std::size_t &nSize);
+
+// ============================================================================
+
+#endif	// MAP_FILE_H_
@@ -0,0 +1,96 @@
+//
+//	Captured Output
+//
+//
+//	Generic Code-Seeking Disassembler
+//	Copyright(c)2021 by Donna Whisnant
+//
+
+#ifndef CAPTURED_OUTPUT_H
+#define CAPTURED_OUTPUT_H
+
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <utility>
+
+// ============================================================================
+
+//////////////////////////////////////////////////////////////////////
+// CCapturedOutput Class
+//////////////////////////////////////////////////////////////////////
+//		Captures everything written to a pair of message and error
+//		streams, in the order it was written, so that the output of
+//		work run on another thread can be replayed afterward as
+//		if it had been written to the real streams directly.
+class CCapturedOutput
+{
+public:
+	CCapturedOutput()
+		:	m_bufMsg(*this, false),
+			m_bufErr(*this, true),
+			m_streamMsg(&m_bufMsg),
+			m_streamErr(&m_bufErr)
+	{ }
+
+	std::ostream &msgFile() { return m_streamMsg; }
+	std::ostream &errFile() { return m_streamErr; }
+
+	void replay(std::ostream &msgFile, std::ostream &errFile) const
+	{
+		for (auto const & itrSegment : m_arrSegments) {
+			std::ostream &outFile = (itrSegment.first ? errFile : msgFile);
+			outFile << itrSegment.second;
+			outFile.flush();		// Flush on each switch to keep the order when both streams go to the same file
+		}
+	}
+
+private:
+	class CCaptureBuf : public std::streambuf
+	{
+	public:
+		CCaptureBuf(CCapturedOutput &output, bool bErrFile)
+			:	m_output(output),
+				m_bErrFile(bErrFile)
+		{ }
+
+	protected:
+		virtual int_type overflow(int_type c) override
+		{
+			if (!traits_type::eq_int_type(c, traits_type::eof())) {
+				char ch = traits_type::to_char_type(c);
+				m_output.append(m_bErrFile, &ch, 1);
+			}
+			return traits_type::not_eof(c);
+		}
+		virtual std::streamsize xsputn(const char *pData, std::streamsize nCount) override
+		{
+			m_output.append(m_bErrFile, pData, nCount);
+			return nCount;
+		}
+
+	private:
+		CCapturedOutput &m_output;
+		bool m_bErrFile;
+	};
+
+	void append(bool bErrFile, const char *pData, std::streamsize nCount)
+	{
+		if (m_arrSegments.empty() || (m_arrSegments.back().first != bErrFile)) {
+			m_arrSegments.push_back({ bErrFile, std::string() });
+		}
+		m_arrSegments.back().second.append(pData, nCount);
+	}
+
+	std::vector< std::pair<bool, std::string> > m_arrSegments;		// Runs of output text, flagged true for errFile and false for msgFile
+	CCaptureBuf m_bufMsg;
+	CCaptureBuf m_bufErr;
+	std::ostream m_streamMsg;
+	std::ostream m_streamErr;
+};
+
+// ============================================================================
+
+#endif	// CAPTURED_OUTPUT_H
+
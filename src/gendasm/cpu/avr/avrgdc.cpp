@@ -398,10 +398,6 @@
 
 #include <assert.h>
 
-#ifdef LIBIBERTY_SUPPORT
-#include <libiberty/demangle.h>
-#endif
-
 // ============================================================================
 
 #define DataDelim	"'"			// Specify ' as delimiter for data literals
@@ -904,6 +900,7 @@ CAVRDisassembler::CAVRDisassembler()
 	for (size_t ndx = 0; ndx < _countof(arrOpcodes); ++ndx) {
 		m_Opcodes.AddOpcode(arrOpcodes[ndx]);
 	}
+	m_Opcodes.BuildDecodeIndex();
 
 	m_bAllowMemRangeOverlap = true;
 
@@ -921,20 +918,6 @@ CAVRDisassembler::CAVRDisassembler()
 
 // ----------------------------------------------------------------------------
 
-#ifdef LIBIBERTY_SUPPORT
-extern "C" {
-	static void demangle_callback(const char *pString, size_t nSize, void *pData)
-	{
-		std::string *pRetVal = (std::string *)(pData);
-		if (pRetVal) {
-			(*pRetVal) += std::string(pString, nSize);
-		}
-	}
-}
-#endif
-
-// ----------------------------------------------------------------------------
-
 unsigned int CAVRDisassembler::GetVersionNumber() const
 {
 	return (CDisassembler::GetVersionNumber() | VERSION);			// Get GDC version and append our version to it
@@ -950,6 +933,11 @@ std::string CAVRDisassembler::GetGDCShortName() const
 	return "AVR";
 }
 
+std::unique_ptr<CDisassembler> CAVRDisassembler::CreateDisassembler() const
+{
+	return std::make_unique<CAVRDisassembler>();
+}
+
 // ----------------------------------------------------------------------------
 
 CStringArray CAVRDisassembler::GetMCUList() const
@@ -1004,8 +992,8 @@ bool CAVRDisassembler::SetMCU(const std::string &strMCUName)
 
 	// TODO : Put this is a global array that we can enumerate:
 	// Memory Mapping:
-	m_Memory[MT_RAM].push_back(CMemBlock{ 0x100ul, 0x100ul, true, 0x800ul, 0, DMEM_LOADED });		// RAM space
-//	m_Memory[MT_EE].push_back(CMemBlock{ 0x0000ul, 0x0000ul, true, 0x400ul, 0xFF, DMEM_LOADED });	// EE space
+	m_Memory[MT_RAM].addBlock(CMemBlock{ 0x100ul, 0x100ul, true, 0x800ul, 0, DMEM_LOADED });		// RAM space
+//	m_Memory[MT_EE].addBlock(CMemBlock{ 0x0000ul, 0x0000ul, true, 0x400ul, 0xFF, DMEM_LOADED });	// EE space
 
 	m_MemoryRanges[MT_ROM].push_back(CMemRange(0x0000ul, 0x8000ul));	// Main Flash Memory
 	m_MemoryRanges[MT_RAM].push_back(CMemRange(0x0000ul, 0x0100ul));	// I/O Space addressable as RAM
@@ -1044,12 +1032,18 @@ bool CAVRDisassembler::ScanSymbols(std::ostream *msgFile, std::ostream *errFile)
 
 #ifdef LIBIBERTY_SUPPORT
 	// Try to find vtables which get copied from the flash shadow
-	//	to RAM on init.  Then we can set its entries as indirects:
+	//	to RAM on init.  Then we can set its entries as indirects.
+	//	Only the "_ZTV" symbols can be vtables, so only those are
+	//	demangled now, all at once, and the rest wait until output:
+	std::vector<TLabel> arrVTables;
+	for (auto const & itrSymbol : m_SymbolTable[MT_RAM]) {
+		if (itrSymbol.second.starts_with("_ZTV")) arrVTables.push_back(itrSymbol.second);
+	}
+	DemangleSymbols(arrVTables);
+
 	for (auto const & itrSymbol : m_SymbolTable[MT_RAM]) {
 		if (itrSymbol.second.starts_with("_ZTV")) {
-			TLabel strDemangled;
-			if (!cplus_demangle_v3_callback(itrSymbol.second.c_str(), DMGL_PARAMS | DMGL_ANSI | DMGL_VERBOSE | DMGL_TYPES, demangle_callback, &strDemangled))
-				cplus_demangle_v3_callback(itrSymbol.second.c_str(), DMGL_NO_OPTS, demangle_callback, &strDemangled);
+			TLabel strDemangled = DemangleSymbol(itrSymbol.second);
 			if (strDemangled.starts_with("vtable")) {
 				// Lookup and compute the size of the object:
 				CAddressMap::const_iterator itrObject = m_ObjectMap[MT_RAM].find(itrSymbol.first);
@@ -1134,33 +1128,34 @@ bool CAVRDisassembler::ReadNextObj(MEMORY_TYPE nMemoryType, bool bTagMemory, std
 	if (!IsAddressLoaded(nMemoryType, m_PC-opcodeSymbolSize(), opcodeSymbolSize())) return false;
 
 	bool bOpcodeFound = false;
-	for (TOpcodeTable_type::const_iterator itrOpcode = m_Opcodes.cbegin(); (!bOpcodeFound && (itrOpcode != m_Opcodes.cend())); ++itrOpcode) {
-		if (itrOpcode->opcode().at(0) != (nFirstWord & itrOpcode->opcodeMask().at(0))) continue;
+	for (auto const & ndxOpcode : m_Opcodes.decodeCandidates(nFirstWord)) {		// Only the opcodes whose first word matches
+		const COpcodeEntry<TAVRDisassembler> &anOpcode = m_Opcodes.at(ndxOpcode);
 
 		COpcodeSymbolArray_type arrOpMemory;
 		arrOpMemory.push_back(nFirstWord);
 
 		bool bMatch = true;
-		for (COpcodeSymbolArray_type::size_type ndx = 1; (bMatch && (ndx < itrOpcode->opcode().size())); ++ndx) {
+		for (COpcodeSymbolArray_type::size_type ndx = 1; (bMatch && (ndx < anOpcode.opcode().size())); ++ndx) {
 			TAVRDisassembler::TOpcodeSymbol nNextWord = m_Memory[nMemoryType].element(m_PC + (ndx-1)*opcodeSymbolSize()) |
 														(m_Memory[nMemoryType].element(m_PC + (ndx-1)*opcodeSymbolSize() + 1) << 8);
 			if (!IsAddressLoaded(nMemoryType, m_PC + (ndx-1)*opcodeSymbolSize(), opcodeSymbolSize())) {
 				bMatch = false;
 				continue;
 			}
-			if (itrOpcode->opcode().at(ndx) != (nNextWord & itrOpcode->opcodeMask().at(ndx))) {
+			if (anOpcode.opcode().at(ndx) != (nNextWord & anOpcode.opcodeMask().at(ndx))) {
 				bMatch = false;
 				continue;
 			}
 			arrOpMemory.push_back(nNextWord);
 		}
 		if (bMatch) {
-			if (itrOpcode->matchFunc() && !itrOpcode->matchFunc()(*itrOpcode, arrOpMemory)) bMatch = false;
+			if (anOpcode.matchFunc() && !anOpcode.matchFunc()(anOpcode, arrOpMemory)) bMatch = false;
 		}
 		if (bMatch) {
 			m_OpMemory = arrOpMemory;
-			m_CurrentOpcode = *itrOpcode;
+			m_CurrentOpcode = anOpcode;
 			bOpcodeFound = true;
+			break;
 		}
 	}
 
@@ -1345,26 +1340,22 @@ std::string CAVRDisassembler::FormatOpBytes(MEMORY_TYPE nMemoryType, MNEMONIC_CO
 	UNUSED(nMemoryType);
 	UNUSED(nStartAddress);
 
-	std::ostringstream sstrTemp;
+	std::string strOpBytes;
 
 	if (nMemoryType == MT_ROM) {
+		strOpBytes.reserve(m_OpMemory.size() * 6);
 		for (decltype(m_OpMemory)::size_type i=0; i<m_OpMemory.size(); ++i) {
-			if (i) sstrTemp << " ";
+			if (i) strOpBytes += " ";
 			if (nMCCode != MC_OPCODE) {		// MC_OPCODE will be words on AVR, everything else will be bytes here:
-				sstrTemp << std::uppercase << std::setfill('0') << std::setw(2) << std::setbase(16) << static_cast<unsigned int>(m_OpMemory.at(i))
-							<< std::nouppercase << std::setbase(0);
+				appendHex(strOpBytes, static_cast<unsigned int>(m_OpMemory.at(i)), 2);
 			} else {
-				sstrTemp << std::uppercase << std::setfill('0') << std::setw(2) << std::setbase(16) << static_cast<unsigned int>(m_OpMemory.at(i) & 0xFF)
-							<< std::nouppercase << std::setbase(0);
-
-				sstrTemp << " ";
-
-				sstrTemp << std::uppercase << std::setfill('0') << std::setw(2) << std::setbase(16) << static_cast<unsigned int>((m_OpMemory.at(i) >> 8) & 0xFF)
-							<< std::nouppercase << std::setbase(0);
+				appendHex(strOpBytes, static_cast<unsigned int>(m_OpMemory.at(i) & 0xFF), 2);
+				strOpBytes += " ";
+				appendHex(strOpBytes, static_cast<unsigned int>((m_OpMemory.at(i) >> 8) & 0xFF), 2);
 			}
 		}
 	}
-	return sstrTemp.str();
+	return strOpBytes;
 }
 
 std::string CAVRDisassembler::FormatMnemonic(MEMORY_TYPE nMemoryType, MNEMONIC_CODE nMCCode, TAddress nStartAddress)
@@ -1549,8 +1540,7 @@ std::string CAVRDisassembler::FormatComments(MEMORY_TYPE nMemoryType, MNEMONIC_C
 	itrSymbol = m_SymbolTable[nMemoryType].find(nStartAddress);
 	if (itrSymbol != m_SymbolTable[nMemoryType].cend()) {
 		if (!itrSymbol->second.empty()) {
-			if (!cplus_demangle_v3_callback(itrSymbol->second.c_str(), DMGL_PARAMS | DMGL_ANSI | DMGL_VERBOSE | DMGL_TYPES, demangle_callback, &strLabel))
-				cplus_demangle_v3_callback(itrSymbol->second.c_str(), DMGL_NO_OPTS, demangle_callback, &strLabel);
+			strLabel = DemangleSymbol(itrSymbol->second);
 		}
 		if (!strLabel.empty()) {
 			if (!strRetVal.empty()) strRetVal += "\n";
@@ -1573,7 +1563,7 @@ std::string CAVRDisassembler::FormatComments(MEMORY_TYPE nMemoryType, MNEMONIC_C
 #ifdef LIBIBERTY_SUPPORT
 			itrSymbol = m_SymbolTable[nMemoryType].find(nBaseAddress);
 			if (itrSymbol != m_SymbolTable[nMemoryType].cend() && !itrSymbol->second.empty()) {
-				cplus_demangle_v3_callback(itrSymbol->second.c_str(), DMGL_NO_OPTS, demangle_callback, &strLabel);
+				strLabel = DemangleSymbol(itrSymbol->second, false);
 				if (!strLabel.empty()) bIsDemangled = true;
 			}
 #endif
@@ -1611,7 +1601,7 @@ std::string CAVRDisassembler::FormatComments(MEMORY_TYPE nMemoryType, MNEMONIC_C
 			strLabel.clear();
 			itrSymbol = m_SymbolTable[MT_RAM].find(nBaseAddress);
 			if (itrSymbol != m_SymbolTable[MT_RAM].cend() && !itrSymbol->second.empty()) {
-				cplus_demangle_v3_callback(itrSymbol->second.c_str(), DMGL_NO_OPTS, demangle_callback, &strLabel);
+				strLabel = DemangleSymbol(itrSymbol->second, false);
 			}
 
 			if (!strLabel.empty()) {
@@ -1691,8 +1681,7 @@ std::string CAVRDisassembler::FormatComments(MEMORY_TYPE nMemoryType, MNEMONIC_C
 			if (itrSymbol != m_SymbolTable[nMemoryType].cend()) {
 				strLabel.clear();
 				if (!itrSymbol->second.empty()) {
-					if (!cplus_demangle_v3_callback(itrSymbol->second.c_str(), DMGL_PARAMS | DMGL_ANSI | DMGL_VERBOSE | DMGL_TYPES, demangle_callback, &strLabel))
-						cplus_demangle_v3_callback(itrSymbol->second.c_str(), DMGL_NO_OPTS, demangle_callback, &strLabel);
+					strLabel = DemangleSymbol(itrSymbol->second);
 				}
 				if (!strLabel.empty()) {
 					if (!strRetVal.empty()) strRetVal += "\n";
@@ -2380,8 +2369,6 @@ bool CAVRDisassembler::ResolveIndirect(MEMORY_TYPE nMemoryType, TAddress nAddres
 
 TLabel CAVRDisassembler::GenLabel(MEMORY_TYPE nMemoryType, TAddress nAddress)
 {
-	std::ostringstream sstrTemp;
-
 	std::string strPrefix;
 	switch (nMemoryType) {
 		case MT_ROM:
@@ -2400,8 +2387,7 @@ TLabel CAVRDisassembler::GenLabel(MEMORY_TYPE nMemoryType, TAddress nAddress)
 			break;
 	}
 
-	sstrTemp << strPrefix << std::uppercase << std::setfill('0') << std::setw(4) << std::setbase(16) << nAddress;
-	return sstrTemp.str();
+	return appendHex(strPrefix, nAddress, 4);
 }
 
 // ----------------------------------------------------------------------------
@@ -105,6 +105,7 @@ public:
 	virtual unsigned int GetVersionNumber() const override;
 	virtual std::string GetGDCLongName() const override;
 	virtual std::string GetGDCShortName() const override;
+	virtual std::unique_ptr<CDisassembler> CreateDisassembler() const override;
 
 	virtual CStringArray GetMCUList() const override;
 	virtual bool SetMCU(const std::string &strMCUName) override;
@@ -137,10 +137,6 @@
 
 #include <assert.h>
 
-#ifdef LIBIBERTY_SUPPORT
-#include <libiberty/demangle.h>
-#endif
-
 // ============================================================================
 
 #define DataDelim	"'"			// Specify ' as delimiter for data literals
@@ -474,6 +470,7 @@ CM6811Disassembler::CM6811Disassembler()
 	m_Opcodes.AddOpcode({ { 0xFD }, { 0xFF }, MAKEOGRP(0x0, 0x2), MAKEOCTL(0x0, 0x1), "std" });
 	m_Opcodes.AddOpcode({ { 0xFE }, { 0xFF }, MAKEOGRP(0x0, 0x2), MAKEOCTL(0x0, 0x1), "ldx" });
 	m_Opcodes.AddOpcode({ { 0xFF }, { 0xFF }, MAKEOGRP(0x0, 0x2), MAKEOCTL(0x0, 0x1), "stx" });
+	m_Opcodes.BuildDecodeIndex();
 
 	m_bVBreakEquateLabels = false;
 	m_bVBreakCodeLabels = true;
@@ -497,6 +494,11 @@ std::string CM6811Disassembler::GetGDCShortName() const
 	return "M6811";
 }
 
+std::unique_ptr<CDisassembler> CM6811Disassembler::CreateDisassembler() const
+{
+	return std::make_unique<CM6811Disassembler>();
+}
+
 // ----------------------------------------------------------------------------
 
 bool CM6811Disassembler::ReadNextObj(MEMORY_TYPE nMemoryType, bool bTagMemory, std::ostream *msgFile, std::ostream *errFile)
@@ -527,11 +529,11 @@ bool CM6811Disassembler::ReadNextObj(MEMORY_TYPE nMemoryType, bool bTagMemory, s
 	m_OpMemory.push_back(nFirstByte);
 	if (IsAddressLoaded(nMemoryType, m_PC-1, 1) == false) return false;
 
-	TOpcodeTable_type::const_iterator itrOpcode = m_Opcodes.find(nFirstByte);
+	const COpcodeEntryArray<TM6811Disassembler> *pOpcodes = m_Opcodes.decodeCandidates(nFirstByte);
 	bFlag = false;
-	if (itrOpcode != m_Opcodes.cend()) {
-		for (COpcodeEntryArray<TM6811Disassembler>::size_type ndx = 0; ((ndx < itrOpcode->second.size()) && !bFlag); ++ndx) {
-			m_CurrentOpcode = itrOpcode->second.at(ndx);
+	if (pOpcodes != nullptr) {
+		for (COpcodeEntryArray<TM6811Disassembler>::size_type ndx = 0; ((ndx < pOpcodes->size()) && !bFlag); ++ndx) {
+			m_CurrentOpcode = pOpcodes->at(ndx);
 			bFlag = true;
 			for (COpcodeSymbolArray_type::size_type i=1; ((i<m_CurrentOpcode.opcode().size()) && (bFlag)); ++i) {
 				if (m_CurrentOpcode.opcode().at(i) != m_Memory[nMemoryType].element(m_PC+i-1)) bFlag = false;
@@ -711,14 +713,14 @@ std::string CM6811Disassembler::FormatOpBytes(MEMORY_TYPE nMemoryType, MNEMONIC_
 	UNUSED(nMCCode);			// Note: On M6811, opcode elements are bytes and so are data elements. No need to decode nMCCode
 	UNUSED(nStartAddress);
 
-	std::ostringstream sstrTemp;
+	std::string strOpBytes;
+	strOpBytes.reserve(m_OpMemory.size() * 3);
 
 	for (decltype(m_OpMemory)::size_type i=0; i<m_OpMemory.size(); ++i) {
-		if (i) sstrTemp << " ";
-		sstrTemp << std::uppercase << std::setfill('0') << std::setw(2) << std::setbase(16) << static_cast<unsigned int>(m_OpMemory.at(i))
-					<< std::nouppercase << std::setbase(0);
+		if (i) strOpBytes += " ";
+		appendHex(strOpBytes, static_cast<unsigned int>(m_OpMemory.at(i)), 2);
 	}
-	return sstrTemp.str();
+	return strOpBytes;
 }
 
 std::string CM6811Disassembler::FormatMnemonic(MEMORY_TYPE nMemoryType, MNEMONIC_CODE nMCCode, TAddress nStartAddress)
@@ -812,18 +814,6 @@ std::string CM6811Disassembler::FormatOperands(MEMORY_TYPE nMemoryType, MNEMONIC
 	return strOpStr;
 }
 
-#ifdef LIBIBERTY_SUPPORT
-extern "C" {
-	static void demangle_callback(const char *pString, size_t nSize, void *pData)
-	{
-		std::string *pRetVal = (std::string *)(pData);
-		if (pRetVal) {
-			(*pRetVal) += std::string(pString, nSize);
-		}
-	}
-}
-#endif
-
 std::string CM6811Disassembler::FormatComments(MEMORY_TYPE nMemoryType, MNEMONIC_CODE nMCCode, TAddress nStartAddress)
 {
 	std::string strRetVal;
@@ -838,8 +828,7 @@ std::string CM6811Disassembler::FormatComments(MEMORY_TYPE nMemoryType, MNEMONIC
 	itrSymbol = m_SymbolTable[nMemoryType].find(nStartAddress);
 	if (itrSymbol != m_SymbolTable[nMemoryType].cend()) {
 		if (!itrSymbol->second.empty()) {
-			if (!cplus_demangle_v3_callback(itrSymbol->second.c_str(), DMGL_PARAMS | DMGL_ANSI | DMGL_VERBOSE | DMGL_TYPES, demangle_callback, &strLabel))
-				cplus_demangle_v3_callback(itrSymbol->second.c_str(), DMGL_NO_OPTS, demangle_callback, &strLabel);
+			strLabel = DemangleSymbol(itrSymbol->second);
 		}
 		if (!strLabel.empty()) {
 			if (!strRetVal.empty()) strRetVal += "\n";
@@ -883,7 +872,7 @@ std::string CM6811Disassembler::FormatComments(MEMORY_TYPE nMemoryType, MNEMONIC
 #ifdef LIBIBERTY_SUPPORT
 				itrSymbol = m_SymbolTable[nMemoryType].find(nBaseAddress);
 				if (itrSymbol != m_SymbolTable[nMemoryType].cend() && !itrSymbol->second.empty()) {
-					cplus_demangle_v3_callback(itrSymbol->second.c_str(), DMGL_NO_OPTS, demangle_callback, &strLabel);
+					strLabel = DemangleSymbol(itrSymbol->second, false);
 					if (!strLabel.empty()) bIsDemangled = true;
 				}
 #endif
@@ -979,8 +968,7 @@ std::string CM6811Disassembler::FormatComments(MEMORY_TYPE nMemoryType, MNEMONIC
 			if (itrSymbol != m_SymbolTable[nMemoryType].cend()) {
 				strLabel.clear();
 				if (!itrSymbol->second.empty()) {
-					if (!cplus_demangle_v3_callback(itrSymbol->second.c_str(), DMGL_PARAMS | DMGL_ANSI | DMGL_VERBOSE | DMGL_TYPES, demangle_callback, &strLabel))
-						cplus_demangle_v3_callback(itrSymbol->second.c_str(), DMGL_NO_OPTS, demangle_callback, &strLabel);
+					strLabel = DemangleSymbol(itrSymbol->second);
 				}
 				if (!strLabel.empty()) {
 					if (!strRetVal.empty()) strRetVal += "\n";
@@ -32,6 +32,7 @@ public:
 	virtual unsigned int GetVersionNumber() const override;
 	virtual std::string GetGDCLongName() const override;
 	virtual std::string GetGDCShortName() const override;
+	virtual std::unique_ptr<CDisassembler> CreateDisassembler() const override;
 
 protected:
 	virtual bool ReadNextObj(MEMORY_TYPE nMemoryType, bool bTagMemory, std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr) override;
@@ -7,6 +7,9 @@
 //
 
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cassert>
 #include "dfc.h"
 #include "stringhelp.h"
 #include "memclass.h"
@@ -56,6 +59,19 @@ bool CDataFileConverter::ReadDataFile(CDisassembler &disassembler,
 	return bRetVal;
 }
 
+bool CDataFileConverter::LoadDataFile(CDisassembler &disassembler,
+		const std::string &strFilePathName, TAddress nNewBase, TDescElement nDesc,
+		std::ostream *msgFile, std::ostream *errFile) const
+{
+	if (!RetrieveFileMapping(disassembler, strFilePathName, nNewBase, msgFile, errFile)) {
+		if (errFile) {
+			(*errFile) << "*** Unable to completely retrieve the file mapping for \"" << strFilePathName << "\"\n";
+		}
+	}
+
+	return ReadDataFile(disassembler, strFilePathName, nNewBase, nDesc, msgFile, errFile);
+}
+
 bool CDataFileConverter::WriteDataFile(CDisassembler &disassembler,
 		const std::string &strFilePathName, const CMemRanges &aRange, TAddress nNewBase,
 		const CMemBlocks &aMemory, TDescElement nDesc, bool bUsePhysicalAddr,
@@ -77,6 +93,78 @@ bool CDataFileConverter::WriteDataFile(CDisassembler &disassembler,
 	return bRetVal;
 }
 
+// ----------------------------------------------------------------------------
+
+std::string CDataFileConverter::readFileData(std::istream &aFile)
+{
+	aFile.clear();
+	aFile.seekg(0L, std::ios_base::beg);
+	std::ostringstream ssData;
+	ssData << aFile.rdbuf();
+	if (aFile.bad()) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED);
+	return ssData.str();
+}
+
+std::string CDataFileConverter::readFileData(const std::string &strFilePathName)
+{
+	std::ifstream theFile(strFilePathName, std::ios_base::in | std::ios_base::binary);
+	if (!theFile.is_open()) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_OPENREAD);
+
+	theFile.seekg(0L, std::ios_base::end);
+	std::streamoff nSize = theFile.tellg();
+	theFile.seekg(0L, std::ios_base::beg);
+	if (nSize < 0) return readFileData(theFile);		// Not seekable, so read it as a stream
+
+	std::string strData(static_cast<std::string::size_type>(nSize), '\0');
+	if (!theFile.read(strData.data(), nSize)) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED);
+	return strData;
+}
+
+unsigned int CDataFileConverter::decodeHex(const char *pHex, int nDigits, int nLineCount)
+{
+	// Value of each hex digit character, or -1 if it isn't one:
+	static constexpr struct THexDigits {
+		signed char m_arrValues[256];
+		constexpr THexDigits() : m_arrValues()
+		{
+			for (int ch = 0; ch < 256; ++ch) m_arrValues[ch] = -1;
+			for (int ch = '0'; ch <= '9'; ++ch) m_arrValues[ch] = ch - '0';
+			for (int ch = 'A'; ch <= 'F'; ++ch) m_arrValues[ch] = ch - 'A' + 10;
+			for (int ch = 'a'; ch <= 'f'; ++ch) m_arrValues[ch] = ch - 'a' + 10;
+		}
+	} hexDigits;
+
+	unsigned int nValue = 0;
+	for (int i = 0; i < nDigits; ++i) {
+		int nDigit = hexDigits.m_arrValues[static_cast<unsigned char>(pHex[i])];
+		if (nDigit < 0) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_INVALID_RECORD, nLineCount, "Invalid hex digit");
+		nValue = (nValue << 4) | nDigit;
+	}
+	return nValue;
+}
+
+bool CDataFileConverter::loadMemory(CDisassembler &disassembler, const CMemRanges &ranges,
+									const CMemoryArray &arrData, TDescElement nDesc)
+{
+	bool bRetVal = true;
+	CMemBlocks &aMemory = disassembler.memory(CDisassembler::MT_ROM);
+
+	aMemory.initFromRanges(ranges, 0, true, 0, CDisassembler::DMEM_NOTLOADED);
+
+	CMemoryArray::size_type ndxData = 0;
+	for (auto const & itrRange : ranges) {
+		for (TSize nOffset = 0; nOffset < itrRange.size(); ++nOffset) {
+			TAddress nAddr = itrRange.startAddr() + nOffset;
+			if (!aMemory.setElement(nAddr, arrData.at(ndxData++))) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_OVERFLOW);
+			if (aMemory.descriptor(nAddr) != 0) bRetVal = false;	// Signal overlap
+			aMemory.setDescriptor(nAddr, nDesc);
+		}
+	}
+	assert(ndxData == arrData.size());
+
+	return bRetVal;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // CDataFileConverters Implementation
 
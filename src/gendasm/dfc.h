@@ -14,6 +14,7 @@
 #include "memclass.h"
 
 #include <iostream>
+#include <string>
 #include <vector>
 
 // ============================================================================
@@ -67,6 +68,15 @@ public:
 			const std::string &strFilePathName, TAddress nNewBase, TDescElement nDesc,
 			std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr) const;
 
+	// LoadDataFile: Does both of the above, setting the mapping of the disassembler's
+	//	memory from the file and reading its data.  The default does so by calling them
+	//	in turn, reporting an incomplete mapping to errFile, but converters that can get
+	//	both in a single pass over the file override it to do so.  Returns the status of
+	//	ReadDataFile:
+	virtual bool LoadDataFile(CDisassembler &disassembler,
+			const std::string &strFilePathName, TAddress nNewBase, TDescElement nDesc,
+			std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr) const;
+
 	virtual bool WriteDataFile(CDisassembler &disassembler,
 			const std::string &strFilePathName, const CMemRanges &aRange, TAddress nNewBase,
 			const CMemBlocks &aMemory, TDescElement nDesc, bool bUsePhysicalAddr,
@@ -172,6 +182,14 @@ public:
 	virtual bool WriteDataFile(std::ostream &aFile, const CMemRanges &aRange, TAddress nNewBase,
 													const CMemBlocks &aMemory, TDescElement nDesc, bool bUsePhysicalAddr,
 													DFC_FILL_MODE_ENUM nFillMode, TMemoryElement nFillValue, std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr) const = 0;
+
+protected:
+	// Helpers for single-pass loading of text (hex) files:
+	static std::string readFileData(std::istream &aFile);			// Reads the entire file from the beginning
+	static std::string readFileData(const std::string &strFilePathName);
+	static unsigned int decodeHex(const char *pHex, int nDigits, int nLineCount);	// Decodes nDigits hex digits, throwing ERR_INVALID_RECORD if any aren't
+	static bool loadMemory(CDisassembler &disassembler, const CMemRanges &ranges,
+							const CMemoryArray &arrData, TDescElement nDesc);	// Sets the memory mapping to 'ranges' and fills it from arrData, the data of each range in order, returning false on overlaps
 };
 
 
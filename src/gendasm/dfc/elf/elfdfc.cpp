@@ -17,6 +17,7 @@
 #include <iomanip>
 #include <vector>
 #include <map>
+#include <string_view>
 #include <fcntl.h>
 #include <unistd.h>
 #include <cerrno>
@@ -227,37 +228,177 @@ static TString getSymVis(unsigned char other)
 
 // ----------------------------------------------------------------------------
 
-size_t getStrTabSectionIndex(Elf *pElf)
+// CELFFile : Opens an ELF file through libelf with the file memory mapped,
+//	so that section data and strings can be used directly from the mapping
+//	rather than being read and copied.  Closes it on destruction.  If bOwnFD
+//	is false, the file descriptor belongs to the caller and isn't closed.
+class CELFFile
 {
+public:
+	explicit CELFFile(const std::string &strFilePathName)
+		:	m_fd(open(strFilePathName.c_str(), O_RDONLY)),
+			m_bOwnFD(true)
+	{
+		if (m_fd < 0) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_OPENREAD);
+		begin();
+	}
+
+	CELFFile(int fd, bool bOwnFD)
+		:	m_fd(fd),
+			m_bOwnFD(bOwnFD)
+	{
+		begin();
+	}
+
+	~CELFFile()
+	{
+		if (m_pElf) elf_end(m_pElf);
+		if (m_bOwnFD && (m_fd >= 0)) close(m_fd);
+	}
+
+	CELFFile(const CELFFile &) = delete;
+	CELFFile &operator=(const CELFFile &) = delete;
+
+	Elf *elf() const { return m_pElf; }
+
+private:
+	void begin()
+	{
+		if (elf_version(EV_CURRENT) == EV_NONE) {
+			if (m_bOwnFD) close(m_fd);
+			THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_LIBRARY_INIT_FAILED, 0,
+									std::string("ELF Initialization Failed: ") + std::string(elf_errmsg(-1)));
+		}
+
+		m_pElf = elf_begin(m_fd, ELF_C_READ_MMAP, nullptr);
+		if (m_pElf == nullptr) {
+			if (m_bOwnFD) close(m_fd);
+			THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
+									std::string("elf_begin() failed: ") + std::string(elf_errmsg(-1)));
+		}
+	}
+
+	int m_fd = -1;
+	bool m_bOwnFD = true;
+	Elf *m_pElf = nullptr;
+};
+
+// ----------------------------------------------------------------------------
+
+// CELFFileIndex : The ELF header, program headers, and section headers (with
+//	their names) of an ELF file, read once so that both the mapping and data
+//	passes can use them without asking libelf for them again for every lookup.
+//	Also locates the symbol string table, whose names are handed out as views
+//	into the mapped file.
+class CELFFileIndex
+{
+public:
+	struct TSection {
+		Elf_Scn *m_pScn;
+		GElf_Shdr m_shdr;
+		std::string_view m_strName;
+	};
+
+	explicit CELFFileIndex(Elf *pElf);
+
+	int elfClass() const { return m_nClass; }
+	const GElf_Ehdr &ehdr() const { return m_ehdr; }
+	const std::vector<GElf_Phdr> &phdrs() const { return m_arrPHdrs; }
+	const std::vector<TSection> &sections() const { return m_arrSections; }
+	size_t strTabIndex() const { return m_nStrTabNdx; }
+
+	const TSection &section(size_t ndx) const
+	{
+		if (ndx >= m_arrSections.size()) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
+												std::string("Invalid section index ") + std::to_string(ndx));
+		return m_arrSections[ndx];
+	}
+
+	std::string_view symbolName(GElf_Word nName) const		// Symbol names from .strtab
+	{
+		std::string_view::size_type nEnd = m_strStrTab.find('\0', nName);
+		if ((nName >= m_strStrTab.size()) || (nEnd == std::string_view::npos)) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
+												std::string("Invalid string index ") + std::to_string(nName));
+		return m_strStrTab.substr(nName, nEnd - nName);
+	}
+
+private:
+	int m_nClass = ELFCLASSNONE;
+	GElf_Ehdr m_ehdr;
+	std::vector<GElf_Phdr> m_arrPHdrs;
+	std::vector<TSection> m_arrSections;
+	size_t m_nStrTabNdx = 0;		// String table section index (0 if not found)
+	std::string_view m_strStrTab;	// String table data
+};
+
+CELFFileIndex::CELFFileIndex(Elf *pElf)
+{
+	// Basic ELF Header Verification:
+	// ------------------------------
+	if (elf_kind(pElf) != ELF_K_ELF) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_UNKNOWN_FILE_TYPE, 0, "Not an ELF object file");
+
+	if (gelf_getehdr(pElf, &m_ehdr) == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
+												std::string("getehdr() failed: ") + std::string(elf_errmsg(-1)));
+
+	m_nClass = gelf_getclass(pElf);
+	if (m_nClass == ELFCLASSNONE) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
+												std::string("getclass() failed: ") + std::string(elf_errmsg(-1)));
+
+	// Get Header Counts:
+	// ------------------
+	size_t nPHdrNum = 0;
 	size_t nSHdrNum = 0;
 	size_t nSHdrStrNdx = 0;
 
+	if (elf_getphdrnum(pElf, &nPHdrNum) != 0) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
+												std::string("getphdrnum() failed: ") + std::string(elf_errmsg(-1)));
 	if (elf_getshdrnum(pElf, &nSHdrNum) != 0) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
 												std::string("getshdrnum() failed: ") + std::string(elf_errmsg(-1)));
 	if (elf_getshdrstrndx(pElf, &nSHdrStrNdx) != 0) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
 												std::string("getshdrstrndx() failed: ") + std::string(elf_errmsg(-1)));
 
-	size_t nStrTabNdx = 0;		// String table section index
-	for (size_t ndx = 0; ndx < nSHdrNum; ++ndx) {
-		Elf_Scn *pScn = nullptr;
-		GElf_Shdr shdr;
-		char *pName;
-		pScn = elf_getscn(pElf, ndx);
-		if (pScn == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
+	// Program Headers:
+	// ----------------
+	m_arrPHdrs.resize(nPHdrNum);
+	for (size_t ndxP = 0; ndxP < nPHdrNum; ++ndxP) {
+		if (gelf_getphdr(pElf, ndxP, &m_arrPHdrs[ndxP]) != &m_arrPHdrs[ndxP]) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
+												std::string("getphdr() failed on index ") + std::to_string(ndxP) +
+															": " + std::string(elf_errmsg(-1)));
+	}
+
+	// Section Headers:
+	// ----------------
+	m_arrSections.resize(nSHdrNum);
+	for (size_t ndxS = 0; ndxS < nSHdrNum; ++ndxS) {
+		TSection &section = m_arrSections[ndxS];
+		section.m_pScn = elf_getscn(pElf, ndxS);
+		if (section.m_pScn == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
 									std::string("getscn() failed: ") + std::string(elf_errmsg(-1)));
-		if (gelf_getshdr(pScn, &shdr) != &shdr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
+		if (gelf_getshdr(section.m_pScn, &section.m_shdr) != &section.m_shdr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
 									std::string("getshdr() failed: ") + std::string(elf_errmsg(-1)));
-		pName = elf_strptr(pElf, nSHdrStrNdx, shdr.sh_name);
+		const char *pName = elf_strptr(pElf, nSHdrStrNdx, section.m_shdr.sh_name);
 		if (pName == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-									std::string("strptr() failed for string index ") + std::to_string(shdr.sh_name) + ": " + std::string(elf_errmsg(-1)));
+									std::string("strptr() failed for string index ") + std::to_string(section.m_shdr.sh_name) + ": " + std::string(elf_errmsg(-1)));
+		section.m_strName = pName;
+
+		if (m_nStrTabNdx != 0) continue;			// Already found the .strtab
 		if (compareNoCase(pName, ".strtab") != 0) continue;		// ??? necessary
-		if (shdr.sh_type != SHT_STRTAB) continue;
-		if (ndx == nSHdrStrNdx) continue;			// Not the .shstrtab
-		nStrTabNdx = ndx;
-		break;
+		if (section.m_shdr.sh_type != SHT_STRTAB) continue;
+		if (ndxS == nSHdrStrNdx) continue;			// Not the .shstrtab
+		m_nStrTabNdx = ndxS;
 	}
 
-	return nStrTabNdx;
+	// Symbol Strings:
+	// ---------------
+	if (m_nStrTabNdx != 0) {
+		const TSection &strTab = m_arrSections[m_nStrTabNdx];
+		Elf_Data *pData = elf_rawdata(strTab.m_pScn, nullptr);
+		if (pData == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
+									std::string("rawdata() failed for .strtab: ") + std::string(elf_errmsg(-1)));
+		if (pData->d_buf && pData->d_size) {
+			m_strStrTab = std::string_view(static_cast<const char *>(pData->d_buf), pData->d_size);
+		}
+	}
 }
 
 // ----------------------------------------------------------------------------
@@ -270,7 +411,7 @@ std::string CELFDataFileConverter::GetShortDescription() const
 
 // ============================================================================
 
-bool CELFDataFileConverter::_ReadDataFile(ELF_READ_MODE_ENUM nReadMode, CDisassembler *pDisassembler, struct Elf *pElf, TAddress nNewBase,
+bool CELFDataFileConverter::_ReadDataFile(ELF_READ_MODE_ENUM nReadMode, CDisassembler *pDisassembler, const CELFFileIndex &elfIndex, TAddress nNewBase,
 					CMemBlocks *pMemory, CMemRanges *pRange, TDescElement nDesc,
 					std::ostream *msgFile, std::ostream *errFile) const
 {
@@ -278,18 +419,8 @@ bool CELFDataFileConverter::_ReadDataFile(ELF_READ_MODE_ENUM nReadMode, CDisasse
 
 	if (pRange) pRange->clear();
 
-	// Basic ELF Header Verification:
-	// ------------------------------
-	if (elf_kind(pElf) != ELF_K_ELF) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_UNKNOWN_FILE_TYPE, 0, "Not an ELF object file");
-
-	GElf_Ehdr ehdr;
-
-	if (gelf_getehdr(pElf, &ehdr) == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-												std::string("getehdr() failed: ") + std::string(elf_errmsg(-1)));
-
-	int nClass = gelf_getclass(pElf);
-	if (nClass == ELFCLASSNONE) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-												std::string("getclass() failed: ") + std::string(elf_errmsg(-1)));
+	const GElf_Ehdr &ehdr = elfIndex.ehdr();
+	int nClass = elfIndex.elfClass();
 	if (nReadMode == ERM_Mapping) {
 		if (msgFile) (*msgFile) << ((nClass == ELFCLASS32) ? "32-bit" : "64-bit") << " ELF object\n";
 	}
@@ -357,23 +488,14 @@ bool CELFDataFileConverter::_ReadDataFile(ELF_READ_MODE_ENUM nReadMode, CDisasse
 
 	// Get Header Counts:
 	// ------------------
-	size_t nPHdrNum = 0;
-	size_t nSHdrNum = 0;
-	size_t nSHdrStrNdx = 0;
-
-	if (elf_getphdrnum(pElf, &nPHdrNum) != 0) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-												std::string("getphdrnum() failed: ") + std::string(elf_errmsg(-1)));
-	if (elf_getshdrnum(pElf, &nSHdrNum) != 0) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-												std::string("getshdrnum() failed: ") + std::string(elf_errmsg(-1)));
-	if (elf_getshdrstrndx(pElf, &nSHdrStrNdx) != 0) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-												std::string("getshdrstrndx() failed: ") + std::string(elf_errmsg(-1)));
+	size_t nPHdrNum = elfIndex.phdrs().size();
+	size_t nSHdrNum = elfIndex.sections().size();
 
 #if DEBUG_ELF_FILE
 	if (nReadMode == ERM_Mapping) {
 		if (msgFile) {
 			(*msgFile) << "    Program Header Table Entry Count: " << nPHdrNum << "\n";
 			(*msgFile) << "    Section Header Table Entry Count: " << nSHdrNum << "\n";
-			(*msgFile) << "    Section Header String Table Index: " << nSHdrStrNdx << "\n";
 		}
 	}
 #endif
@@ -391,10 +513,7 @@ bool CELFDataFileConverter::_ReadDataFile(ELF_READ_MODE_ENUM nReadMode, CDisasse
 	CMemRanges rangesRAMInit;		// Ranges for RAM init
 
 	for (size_t ndxP = 0; ndxP < nPHdrNum; ++ndxP) {
-		GElf_Phdr phdr;
-		if (gelf_getphdr(pElf, ndxP, &phdr) != &phdr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-												std::string("getphdr() failed on index ") + std::to_string(ndxP) +
-															": " + std::string(elf_errmsg(-1)));
+		const GElf_Phdr &phdr = elfIndex.phdrs().at(ndxP);
 
 		// Get mapping for all marked "LOAD":
 		if (phdr.p_type == PT_LOAD) {
@@ -470,22 +589,12 @@ bool CELFDataFileConverter::_ReadDataFile(ELF_READ_MODE_ENUM nReadMode, CDisasse
 				printField(*msgFile, TString(), 1, phdr.p_align);(*msgFile) << " ";
 			}
 
-			for (size_t ndxS = 0; ndxS < nSHdrNum; ++ndxS) {
-				Elf_Scn *pScn = nullptr;
-				GElf_Shdr shdr;
-				pScn = elf_getscn(pElf, ndxS);
-				if (pScn == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-															std::string("getscn() failed: ") + std::string(elf_errmsg(-1)));
-				if (gelf_getshdr(pScn, &shdr) != &shdr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-															std::string("getshdr() failed: ") + std::string(elf_errmsg(-1)));
+			for (auto const & section : elfIndex.sections()) {
+				const GElf_Shdr &shdr = section.m_shdr;
 				if ((shdr.sh_offset == phdr.p_offset) &&
 					(shdr.sh_addr == phdr.p_vaddr)) {
-					char *pName;
-					pName = elf_strptr(pElf, nSHdrStrNdx, shdr.sh_name);
-					if (pName == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-												std::string("strptr() failed for string index ") + std::to_string(shdr.sh_name) + ": " + std::string(elf_errmsg(-1)));
 					if (msgFile) {
-						(*msgFile) << " " << pName;
+						(*msgFile) << " " << section.m_strName;
 					}
 					break;
 				}
@@ -559,23 +668,13 @@ bool CELFDataFileConverter::_ReadDataFile(ELF_READ_MODE_ENUM nReadMode, CDisasse
 		}
 
 		for (size_t ndx = 0; ndx < nSHdrNum; ++ndx) {
-			Elf_Scn *pScn = nullptr;
-			GElf_Shdr shdr;
-			char *pName;
-			pScn = elf_getscn(pElf, ndx);
-			if (pScn == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-														std::string("getscn() failed: ") + std::string(elf_errmsg(-1)));
-			if (gelf_getshdr(pScn, &shdr) != &shdr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-														std::string("getshdr() failed: ") + std::string(elf_errmsg(-1)));
-			pName = elf_strptr(pElf, nSHdrStrNdx, shdr.sh_name);
-			if (pName == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-										std::string("strptr() failed for string index ") + std::to_string(shdr.sh_name) + ": " + std::string(elf_errmsg(-1)));
+			const GElf_Shdr &shdr = elfIndex.sections().at(ndx).m_shdr;
 
 			if (msgFile) {
 				(*msgFile) << "  ";
-				TString strTemp = "[" + padString(std::to_string(elf_ndxscn(pScn)), 2, ' ', true) + "]";
+				TString strTemp = "[" + padString(std::to_string(ndx), 2, ' ', true) + "]";
 				(*msgFile) << padString(strTemp, 5) << " ";
-				(*msgFile) << padString(pName, 24).substr(0, 24) << " ";
+				(*msgFile) << padString(TString(elfIndex.sections().at(ndx).m_strName), 24).substr(0, 24) << " ";
 				(*msgFile) << padString(getSHdrType(shdr.sh_type), 15) << " ";
 				printField(*msgFile, TString(), 4, shdr.sh_addr); (*msgFile) << " ";
 				printField(*msgFile, TString(), 3, shdr.sh_offset); (*msgFile) << " ";
@@ -611,21 +710,13 @@ bool CELFDataFileConverter::_ReadDataFile(ELF_READ_MODE_ENUM nReadMode, CDisasse
 	// --------------------
 	if (nReadMode == ERM_Data) {
 		for (size_t ndxP = 0; ndxP < nPHdrNum; ++ndxP) {
-			GElf_Phdr phdr;
-			if (gelf_getphdr(pElf, ndxP, &phdr) != &phdr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-													std::string("getphdr() failed on index ") + std::to_string(ndxP) +
-																": " + std::string(elf_errmsg(-1)));
+			const GElf_Phdr &phdr = elfIndex.phdrs().at(ndxP);
 
 			// Read ones marked as "LOAD":
 			if (phdr.p_type == PT_LOAD) {
-				for (size_t ndxS = 0; ndxS < nSHdrNum; ++ndxS) {
-					Elf_Scn *pScn = nullptr;
-					GElf_Shdr shdr;
-					pScn = elf_getscn(pElf, ndxS);
-					if (pScn == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-																std::string("getscn() failed: ") + std::string(elf_errmsg(-1)));
-					if (gelf_getshdr(pScn, &shdr) != &shdr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-																std::string("getshdr() failed: ") + std::string(elf_errmsg(-1)));
+				for (auto const & section : elfIndex.sections()) {
+					Elf_Scn *pScn = section.m_pScn;
+					const GElf_Shdr &shdr = section.m_shdr;
 					if ((shdr.sh_offset == phdr.p_offset) &&
 						(shdr.sh_addr == phdr.p_vaddr) &&
 						(shdr.sh_type == SHT_PROGBITS)) {		// Check PROGBITS : .text, .data, .eeprom, etc
@@ -770,21 +861,11 @@ bool CELFDataFileConverter::_ReadDataFile(ELF_READ_MODE_ENUM nReadMode, CDisasse
 	// Symbol Tables:
 	// --------------
 	if (nReadMode == ERM_Data) {
-		size_t nStrTabNdx = getStrTabSectionIndex(pElf);		// String table section index
-		if (nStrTabNdx == 0) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0, "Can't find .strtab");
+		if (elfIndex.strTabIndex() == 0) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0, "Can't find .strtab");
 
-		for (size_t ndx = 0; ndx < nSHdrNum; ++ndx) {
-			Elf_Scn *pScn = nullptr;
-			GElf_Shdr shdr;
-			char *pName;
-			pScn = elf_getscn(pElf, ndx);
-			if (pScn == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-														std::string("getscn() failed: ") + std::string(elf_errmsg(-1)));
-			if (gelf_getshdr(pScn, &shdr) != &shdr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-														std::string("getshdr() failed: ") + std::string(elf_errmsg(-1)));
-			pName = elf_strptr(pElf, nSHdrStrNdx, shdr.sh_name);
-			if (pName == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-										std::string("strptr() failed for string index ") + std::to_string(shdr.sh_name) + ": " + std::string(elf_errmsg(-1)));
+		for (auto const & section : elfIndex.sections()) {
+			Elf_Scn *pScn = section.m_pScn;
+			const GElf_Shdr &shdr = section.m_shdr;
 
 			if (shdr.sh_type != SHT_SYMTAB) continue;
 			if (shdr.sh_size == 0) continue;
@@ -793,7 +874,7 @@ bool CELFDataFileConverter::_ReadDataFile(ELF_READ_MODE_ENUM nReadMode, CDisasse
 
 #if REPORT_SYMTABLE
 			if (msgFile) {
-				(*msgFile) << "Symbol table '" << pName << "' contains " << nNumSyms << " entries:\n";
+				(*msgFile) << "Symbol table '" << section.m_strName << "' contains " << nNumSyms << " entries:\n";
 				(*msgFile) << "   Num: Value      Size  Type    Bind    Vis       Ndx Name\n";
 			}
 #endif
@@ -807,15 +888,12 @@ bool CELFDataFileConverter::_ReadDataFile(ELF_READ_MODE_ENUM nReadMode, CDisasse
 											": " + std::string(elf_errmsg(-1)));
 
 				for (size_t ndxSym = 0; ndxSym < nNumSyms; ++ndxSym) {
-					char *pSymName;
 					GElf_Sym sym;
 					if (gelf_getsym(pData, ndxSym, &sym) == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
 																			std::string("getsym() failed for symbol ") + std::to_string(ndxSym) +
 																			": " + std::string(elf_errmsg(-1)));
 
-					pSymName = elf_strptr(pElf, nStrTabNdx, sym.st_name);
-					if (pSymName == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-												std::string("strptr() failed for string index ") + std::to_string(sym.st_name) + ": " + std::string(elf_errmsg(-1)));
+					std::string_view strSymName = elfIndex.symbolName(sym.st_name);		// View into the mapped .strtab, only copied if the symbol gets added
 
 #if REPORT_SYMTABLE
 					if (msgFile) {
@@ -836,7 +914,7 @@ bool CELFDataFileConverter::_ReadDataFile(ELF_READ_MODE_ENUM nReadMode, CDisasse
 						} else {
 							(*msgFile) << padString(std::to_string(sym.st_shndx), 3, ' ', true) << " ";
 						}
-						(*msgFile) << pSymName;
+						(*msgFile) << strSymName;
 
 						(*msgFile) << "\n";
 					}
@@ -844,10 +922,8 @@ bool CELFDataFileConverter::_ReadDataFile(ELF_READ_MODE_ENUM nReadMode, CDisasse
 
 					// Add symbols to Disassembler:
 					unsigned char nSymType = GELF_ST_TYPE(sym.st_info);
-					TLabel strSymbol = pSymName;
-					TLabel strLabel = pSymName;
 					if (pDisassembler &&
-						!strLabel.empty() &&				// Must have a label
+						!strSymName.empty() &&				// Must have a label
 						((nSymType == STT_NOTYPE) ||		// NOTYPE can be data, function, or something else
 						(nSymType == STT_OBJECT) ||			// OBJECT is data (either RAM or ROM)
 						(nSymType == STT_FUNC) ||			// FUNC is a function (Note: we cannot use the size to label memory as "code" because this area could contain indirect vectors and such that isn't "code")
@@ -858,13 +934,9 @@ bool CELFDataFileConverter::_ReadDataFile(ELF_READ_MODE_ENUM nReadMode, CDisasse
 						 (sym.st_shndx < SHN_LORESERVE))) {	// Ignore reserved sections
 
 						// Get the referenced section for the symbol:
-						Elf_Scn *pScnRef = nullptr;
-						GElf_Shdr shdrRef;
-						pScnRef = elf_getscn(pElf, sym.st_shndx);
-						if (pScnRef == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-																	std::string("getscn() failed: ") + std::string(elf_errmsg(-1)));
-						if (gelf_getshdr(pScnRef, &shdrRef) != &shdrRef) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-																	std::string("getshdr() failed: ") + std::string(elf_errmsg(-1)));
+						const GElf_Shdr &shdrRef = elfIndex.section(sym.st_shndx).m_shdr;
+						TLabel strSymbol(strSymName);
+						TLabel strLabel(strSymName);
 
 						bool bIsEE = false;
 						TAddress nAddress = sym.st_value;
@@ -966,60 +1038,41 @@ bool CELFDataFileConverter::RetrieveFileMapping(CDisassembler &disassembler,
 		const std::string &strFilePathName, TAddress nNewBase,
 		std::ostream *msgFile, std::ostream *errFile) const
 {
-	if (elf_version(EV_CURRENT) == EV_NONE) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_LIBRARY_INIT_FAILED, 0,
-												std::string("ELF Initialization Failed: ") + std::string(elf_errmsg(-1)));
-
-	int fd = open(strFilePathName.c_str(), O_RDONLY);
-	if (fd < 0) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_OPENREAD);
-
-	bool bRetVal = false;
-	Elf *pElf = elf_begin(fd, ELF_C_READ, nullptr);
-	if (pElf == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-												std::string("elf_begin() failed: ") + std::string(elf_errmsg(-1)));
-
-	try {
-		bRetVal = _ReadDataFile(ERM_Mapping, &disassembler, pElf,
-								nNewBase, nullptr, nullptr, CDisassembler::DMEM_NOTLOADED, msgFile, errFile);
-	} catch (...) {
-		elf_end(pElf);
-		close(fd);
-		throw;
-	}
+	CELFFile elfFile(strFilePathName);
+	CELFFileIndex elfIndex(elfFile.elf());
 
-	elf_end(pElf);
-	close(fd);
-
-	return bRetVal;
+	return _ReadDataFile(ERM_Mapping, &disassembler, elfIndex,
+							nNewBase, nullptr, nullptr, CDisassembler::DMEM_NOTLOADED, msgFile, errFile);
 }
 
 bool CELFDataFileConverter::ReadDataFile(CDisassembler &disassembler,
 		const std::string &strFilePathName, TAddress nNewBase, TDescElement nDesc,
 		std::ostream *msgFile, std::ostream *errFile) const
 {
-	if (elf_version(EV_CURRENT) == EV_NONE) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_LIBRARY_INIT_FAILED, 0,
-												std::string("ELF Initialization Failed: ") + std::string(elf_errmsg(-1)));
-
-	int fd = open(strFilePathName.c_str(), O_RDONLY);
-	if (fd < 0) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_OPENREAD);
-
-	bool bRetVal = false;
-	Elf *pElf = elf_begin(fd, ELF_C_READ, nullptr);
-	if (pElf == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-												std::string("elf_begin() failed: ") + std::string(elf_errmsg(-1)));
-
-	try {
-		bRetVal = _ReadDataFile(ERM_Data, &disassembler, pElf,
-								nNewBase, nullptr, nullptr, nDesc, msgFile, errFile);
-	} catch (...) {
-		elf_end(pElf);
-		close(fd);
-		throw;
-	}
+	CELFFile elfFile(strFilePathName);
+	CELFFileIndex elfIndex(elfFile.elf());
 
-	elf_end(pElf);
-	close(fd);
+	return _ReadDataFile(ERM_Data, &disassembler, elfIndex,
+							nNewBase, nullptr, nullptr, nDesc, msgFile, errFile);
+}
 
-	return bRetVal;
+bool CELFDataFileConverter::LoadDataFile(CDisassembler &disassembler,
+		const std::string &strFilePathName, TAddress nNewBase, TDescElement nDesc,
+		std::ostream *msgFile, std::ostream *errFile) const
+{
+	// Open and index the file once and run both passes on it:
+	CELFFile elfFile(strFilePathName);
+	CELFFileIndex elfIndex(elfFile.elf());
+
+	if (!_ReadDataFile(ERM_Mapping, &disassembler, elfIndex,
+						nNewBase, nullptr, nullptr, CDisassembler::DMEM_NOTLOADED, msgFile, errFile)) {
+		if (errFile) {
+			(*errFile) << "*** Unable to completely retrieve the file mapping for \"" << strFilePathName << "\"\n";
+		}
+	}
+
+	return _ReadDataFile(ERM_Data, &disassembler, elfIndex,
+							nNewBase, nullptr, nullptr, nDesc, msgFile, errFile);
 }
 
 bool CELFDataFileConverter::WriteDataFile(CDisassembler &disassembler,
@@ -1056,29 +1109,13 @@ bool CELFDataFileConverter::RetrieveFileMapping(std::istream &aFile, TAddress nN
 													std::ostream *msgFile, std::ostream *errFile) const
 {
 #ifdef __GLIBCXX__
-	if (elf_version(EV_CURRENT) == EV_NONE) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_LIBRARY_INIT_FAILED, 0,
-												std::string("ELF Initialization Failed: ") + std::string(elf_errmsg(-1)));
-
 	aFile.seekg(0L, std::ios_base::beg);
 
-	int fd = static_cast< __gnu_cxx::stdio_filebuf< char > * const >(aFile.rdbuf())->fd();
+	CELFFile elfFile(static_cast< __gnu_cxx::stdio_filebuf< char > * >(aFile.rdbuf())->fd(), false);
+	CELFFileIndex elfIndex(elfFile.elf());
 
-	bool bRetVal = false;
-	Elf *pElf = elf_begin(fd, ELF_C_READ, nullptr);
-	if (pElf == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-												std::string("elf_begin() failed: ") + std::string(elf_errmsg(-1)));
-
-	try {
-		bRetVal = _ReadDataFile(ERM_Mapping, nullptr, pElf,
-								nNewBase, nullptr, &aRange, CDisassembler::DMEM_NOTLOADED, msgFile, errFile);
-	} catch (...) {
-		elf_end(pElf);
-		throw;
-	}
-
-	elf_end(pElf);
-
-	return bRetVal;
+	return _ReadDataFile(ERM_Mapping, nullptr, elfIndex,
+							nNewBase, nullptr, &aRange, CDisassembler::DMEM_NOTLOADED, msgFile, errFile);
 #else
 	THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_NOT_IMPLEMENTED, 0, "ELF I/O Stream Reading only implemented on GCC builds");
 #endif
@@ -1101,29 +1138,13 @@ bool CELFDataFileConverter::ReadDataFile(std::istream &aFile, TAddress nNewBase,
 												std::ostream *msgFile, std::ostream *errFile) const
 {
 #ifdef __GLIBCXX__
-	if (elf_version(EV_CURRENT) == EV_NONE) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_LIBRARY_INIT_FAILED, 0,
-												std::string("ELF Initialization Failed: ") + std::string(elf_errmsg(-1)));
-
 	aFile.seekg(0L, std::ios_base::beg);
 
-	int fd = static_cast< __gnu_cxx::stdio_filebuf< char > * const >(aFile.rdbuf())->fd();
+	CELFFile elfFile(static_cast< __gnu_cxx::stdio_filebuf< char > * >(aFile.rdbuf())->fd(), false);
+	CELFFileIndex elfIndex(elfFile.elf());
 
-	bool bRetVal = true;
-	Elf *pElf = elf_begin(fd, ELF_C_READ, nullptr);
-	if (pElf == nullptr) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED, 0,
-												std::string("elf_begin() failed: ") + std::string(elf_errmsg(-1)));
-
-	try {
-		bRetVal = _ReadDataFile(ERM_Data, nullptr, pElf,
-								nNewBase, &aMemory, nullptr, nDesc, msgFile, errFile);
-	} catch (...) {
-		elf_end(pElf);
-		throw;
-	}
-
-	elf_end(pElf);
-
-	return bRetVal;
+	return _ReadDataFile(ERM_Data, nullptr, elfIndex,
+							nNewBase, &aMemory, nullptr, nDesc, msgFile, errFile);
 #else
 	THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_NOT_IMPLEMENTED, 0, "ELF I/O Stream Reading only implemented on GCC builds");
 #endif
@@ -14,6 +14,7 @@
 #include <memclass.h>
 #include <errmsgs.h>
 
+class CELFFileIndex;		// Cached headers of an open ELF file (defined in elfdfc.cpp)
 
 class CELFDataFileConverter : virtual public CDataFileConverter {
 public:
@@ -34,6 +35,10 @@ public:
 			const std::string &strFilePathName, TAddress nNewBase, TDescElement nDesc,
 			std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr) const override;
 
+	virtual bool LoadDataFile(CDisassembler &disassembler,
+			const std::string &strFilePathName, TAddress nNewBase, TDescElement nDesc,
+			std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr) const override;
+
 	virtual bool WriteDataFile(CDisassembler &disassembler,
 			const std::string &strFilePathName, const CMemRanges &aRange, TAddress nNewBase,
 			const CMemBlocks &aMemory, TDescElement nDesc, bool bUsePhysicalAddr,
@@ -60,7 +65,7 @@ private:
 		ERM_Data = 1,			// Read only the data
 	};
 
-	bool _ReadDataFile(ELF_READ_MODE_ENUM nReadMode, CDisassembler *pDisassembler, struct Elf *pElf, TAddress nNewBase,
+	bool _ReadDataFile(ELF_READ_MODE_ENUM nReadMode, CDisassembler *pDisassembler, const CELFFileIndex &elfIndex, TAddress nNewBase,
 						CMemBlocks *pMemory, CMemRanges *pRange, TDescElement nDesc,
 						std::ostream *msgFile, std::ostream *errFile) const;
 
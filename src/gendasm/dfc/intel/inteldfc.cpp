@@ -48,7 +48,7 @@ bool CIntelDataFileConverter::RetrieveFileMapping(std::istream &aFile, TAddress
 	UNUSED(msgFile);
 	UNUSED(errFile);
 
-	return _ReadDataFile(aFile, nNewBase, nullptr, &aRange, 0);
+	return _ReadDataFile(readFileData(aFile), nNewBase, nullptr, &aRange, nullptr, 0);
 }
 
 
@@ -70,7 +70,27 @@ bool CIntelDataFileConverter::ReadDataFile(std::istream &aFile, TAddress nNewBas
 	UNUSED(msgFile);
 	UNUSED(errFile);
 
-	return _ReadDataFile(aFile, nNewBase, &aMemory, nullptr, nDesc);
+	return _ReadDataFile(readFileData(aFile), nNewBase, &aMemory, nullptr, nullptr, nDesc);
+}
+
+
+// LoadDataFile:
+//
+//    Single-pass version of RetrieveFileMapping() and ReadDataFile() that
+//    reads the file only once, collecting its mapping and data together,
+//    and then initializes the disassembler's memory from them.
+bool CIntelDataFileConverter::LoadDataFile(CDisassembler &disassembler,
+		const std::string &strFilePathName, TAddress nNewBase, TDescElement nDesc,
+		std::ostream *msgFile, std::ostream *errFile) const
+{
+	UNUSED(msgFile);
+	UNUSED(errFile);
+
+	CMemRanges ranges;
+	CMemoryArray arrData;
+	_ReadDataFile(readFileData(strFilePathName), nNewBase, nullptr, &ranges, &arrData, 0);
+
+	return loadMemory(disassembler, ranges, arrData, nDesc);
 }
 
 
@@ -81,12 +101,14 @@ bool CIntelDataFileConverter::ReadDataFile(std::istream &aFile, TAddress nNewBas
 //    This is a private function called by the regular ReadDataFile and
 //    RetrieveFileMapping.  If pMemory is nullptr then memory is not filled.  If
 //    pRange is nullptr, the mapping is not generated.  If either or both is
-//    not nullptr, then the corresponding operation is performed.
-bool CIntelDataFileConverter::_ReadDataFile(std::istream &aFile, TAddress nNewBase, CMemBlocks *pMemory, CMemRanges *pRange, TDescElement nDesc) const
+//    not nullptr, then the corresponding operation is performed.  If pData
+//    isn't nullptr, the data bytes are appended to it in file order, which
+//    is the order of the ranges in pRange, for LoadDataFile.
+bool CIntelDataFileConverter::_ReadDataFile(const std::string &strData, TAddress nNewBase, CMemBlocks *pMemory, CMemRanges *pRange, CMemoryArray *pData, TDescElement nDesc) const
 {
 	bool bRetVal = true;
 	int nLineCount = 0;				// Line Counter
-	std::string strBuffer;			// Line Buffer
+	std::string::size_type nLinePos = 0;	// Position of the next line in strData
 	TAddress nExtendedAddr = 0;		// Will be either the SBA (Segment Base Address) times 16 or the Extended Linear Address times 65536
 	unsigned int nBytes;			// Number of bytes supposed to be on line
 	TAddress nOffsetAddr;			// Offset Address read on line
@@ -103,15 +125,19 @@ bool CIntelDataFileConverter::_ReadDataFile(std::istream &aFile, TAddress nNewBa
 		pRange->clear();
 	}
 
-	aFile.seekg(0L, std::ios_base::beg);
-	while ((!aFile.eof()) && (aFile.peek() != std::istream::traits_type::eof()) && aFile.good() && !bEndReached) {	// Note: peek needed because eof() doesn't set until following read
-		std::getline(aFile, strBuffer);
-		if (!aFile.good()) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED);
+	while ((nLinePos < strData.size()) && !bEndReached) {
+		std::string::size_type nLineEnd = strData.find('\n', nLinePos);
+		if (nLineEnd == std::string::npos) nLineEnd = strData.size();
+		std::string_view strBuffer(strData.data() + nLinePos, nLineEnd - nLinePos);
+		nLinePos = nLineEnd + 1;
 		++nLineCount;
 
 		trim(strBuffer);
+		const char *pBuffer = strBuffer.data();
 		if (starts_with(strBuffer, ":") && (strBuffer.size() >= 11)) {
-			sscanf(&strBuffer.c_str()[1], "%2X%4X%2X", &nBytes, &nOffsetAddr, &nMode);
+			nBytes = decodeHex(&pBuffer[1], 2, nLineCount);
+			nOffsetAddr = decodeHex(&pBuffer[3], 4, nLineCount);
+			nMode = decodeHex(&pBuffer[7], 2, nLineCount);
 			nChecksum = nBytes + (nOffsetAddr/256) + (nOffsetAddr%256) + nMode;
 
 			if (strBuffer.size() < (11 + (nBytes*2)))
@@ -138,9 +164,9 @@ bool CIntelDataFileConverter::_ReadDataFile(std::istream &aFile, TAddress nNewBa
 			switch (nMode) {
 				case 0:			// Data Entry
 					for (unsigned int i = 0; i < nBytes; ++i) {
-						unsigned int nTempByte;
-						sscanf(&strBuffer.c_str()[9+i*2], "%2X", &nTempByte);
+						unsigned int nTempByte = decodeHex(&pBuffer[9+i*2], 2, nLineCount);
 						nChecksum += nTempByte;
+						if (pData) pData->push_back(nTempByte);
 						if (pMemory) {
 							if (!pMemory->setElement(nCurrAddr, nTempByte)) {
 								THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_OVERFLOW, nLineCount);
@@ -164,7 +190,7 @@ bool CIntelDataFileConverter::_ReadDataFile(std::istream &aFile, TAddress nNewBa
 					if (nBytes != 2) {
 						THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_INVALID_RECORD, nLineCount, "Invalid Length");
 					}
-					sscanf(&strBuffer.c_str()[9], "%4X", &nExtendedAddr);
+					nExtendedAddr = decodeHex(&pBuffer[9], 4, nLineCount);
 					nChecksum = (nExtendedAddr/256) + (nExtendedAddr%256);
 					nExtendedAddr *= 16;		// Convert segment offset to linear
 					break;
@@ -173,8 +199,7 @@ bool CIntelDataFileConverter::_ReadDataFile(std::istream &aFile, TAddress nNewBa
 						THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_INVALID_RECORD, nLineCount, "Invalid Length");
 					}
 					for (unsigned int i = 0; i < nBytes; ++i) {
-						unsigned int nTempByte;
-						sscanf(&strBuffer.c_str()[9+i*2], "%2X", &nTempByte);
+						unsigned int nTempByte = decodeHex(&pBuffer[9+i*2], 2, nLineCount);
 						nChecksum += nTempByte;
 					}
 					// Ignore results -- TODO : Find a way to report this back to the CDisassembler class as an entry point!
@@ -183,7 +208,7 @@ bool CIntelDataFileConverter::_ReadDataFile(std::istream &aFile, TAddress nNewBa
 					if (nBytes != 2) {
 						THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_INVALID_RECORD, nLineCount, "Invalid Length");
 					}
-					sscanf(&strBuffer.c_str()[9], "%4X", &nExtendedAddr);
+					nExtendedAddr = decodeHex(&pBuffer[9], 4, nLineCount);
 					nChecksum = (nExtendedAddr/256) + (nExtendedAddr%256);
 					nExtendedAddr = nExtendedAddr << 16;		// Convert to upper word
 					break;
@@ -192,8 +217,7 @@ bool CIntelDataFileConverter::_ReadDataFile(std::istream &aFile, TAddress nNewBa
 						THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_INVALID_RECORD, nLineCount, "Invalid Length");
 					}
 					for (unsigned int i = 0; i < nBytes; ++i) {
-						unsigned int nTempByte;
-						sscanf(&strBuffer.c_str()[9+i*2], "%2X", &nTempByte);
+						unsigned int nTempByte = decodeHex(&pBuffer[9+i*2], 2, nLineCount);
 						nChecksum += nTempByte;
 					}
 					// Ignore results -- TODO : Find a way to report this back to the CDisassembler class as an entry point!
@@ -203,8 +227,7 @@ bool CIntelDataFileConverter::_ReadDataFile(std::istream &aFile, TAddress nNewBa
 					break;
 			}
 
-			unsigned int nTempByte;
-			sscanf(&strBuffer.c_str()[9+nBytes*2], "%2X", &nTempByte);
+			unsigned int nTempByte = decodeHex(&pBuffer[9+nBytes*2], 2, nLineCount);
 			nChecksum += nTempByte;
 			if ((nChecksum % 256) != 0) {
 				THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_CHECKSUM, nLineCount);
@@ -225,8 +248,7 @@ bool CIntelDataFileConverter::_ReadDataFile(std::istream &aFile, TAddress nNewBa
 	}
 
 	// Check EOF:
-	if (((aFile.eof()) || (aFile.peek() != std::istream::traits_type::eof()) || aFile.good()) &&
-		!bEndReached) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_UNEXPECTED_EOF);
+	if (!bEndReached) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_UNEXPECTED_EOF);
 
 	return bRetVal;
 }
@@ -31,13 +31,17 @@ public:
 													TDescElement nDesc,
 													std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr) const override;
 
+	virtual bool LoadDataFile(CDisassembler &disassembler,
+			const std::string &strFilePathName, TAddress nNewBase, TDescElement nDesc,
+			std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr) const override;
+
 	virtual bool WriteDataFile(std::ostream &aFile, const CMemRanges &aRange, TAddress nNewBase,
 													const CMemBlocks &aMemory, TDescElement nDesc, bool bUsePhysicalAddr,
 													DFC_FILL_MODE_ENUM nFillMode, TMemoryElement nFillValue,
 													std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr) const override;
 
 private:
-	bool _ReadDataFile(std::istream &aFile, TAddress nNewBase, CMemBlocks *pMemory, CMemRanges *pRange, TDescElement nDesc) const;
+	bool _ReadDataFile(const std::string &strData, TAddress nNewBase, CMemBlocks *pMemory, CMemRanges *pRange, CMemoryArray *pData, TDescElement nDesc) const;
 
 };
 
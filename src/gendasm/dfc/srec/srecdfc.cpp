@@ -72,7 +72,7 @@ bool CSrecDataFileConverter::RetrieveFileMapping(std::istream &aFile, TAddress n
 	UNUSED(msgFile);
 	UNUSED(errFile);
 
-	return _ReadDataFile(aFile, nNewBase, nullptr, &aRange, 0);
+	return _ReadDataFile(readFileData(aFile), nNewBase, nullptr, &aRange, nullptr, 0);
 }
 
 
@@ -94,7 +94,27 @@ bool CSrecDataFileConverter::ReadDataFile(std::istream &aFile, TAddress nNewBase
 	UNUSED(msgFile);
 	UNUSED(errFile);
 
-	return _ReadDataFile(aFile, nNewBase, &aMemory, nullptr, nDesc);
+	return _ReadDataFile(readFileData(aFile), nNewBase, &aMemory, nullptr, nullptr, nDesc);
+}
+
+
+// LoadDataFile:
+//
+//    Single-pass version of RetrieveFileMapping() and ReadDataFile() that
+//    reads the file only once, collecting its mapping and data together,
+//    and then initializes the disassembler's memory from them.
+bool CSrecDataFileConverter::LoadDataFile(CDisassembler &disassembler,
+		const std::string &strFilePathName, TAddress nNewBase, TDescElement nDesc,
+		std::ostream *msgFile, std::ostream *errFile) const
+{
+	UNUSED(msgFile);
+	UNUSED(errFile);
+
+	CMemRanges ranges;
+	CMemoryArray arrData;
+	_ReadDataFile(readFileData(strFilePathName), nNewBase, nullptr, &ranges, &arrData, 0);
+
+	return loadMemory(disassembler, ranges, arrData, nDesc);
 }
 
 
@@ -105,12 +125,14 @@ bool CSrecDataFileConverter::ReadDataFile(std::istream &aFile, TAddress nNewBase
 //    This is a private function called by the regular ReadDataFile and
 //    RetrieveFileMapping.  If pMemory is nullptr then memory is not filled.  If
 //    pRange is nullptr, the mapping is not generated.  If either or both is
-//    not nullptr, then the corresponding operation is performed.
-bool CSrecDataFileConverter::_ReadDataFile(std::istream &aFile, TAddress nNewBase, CMemBlocks *pMemory, CMemRanges *pRange, TDescElement nDesc) const
+//    not nullptr, then the corresponding operation is performed.  If pData
+//    isn't nullptr, the data bytes are appended to it in file order, which
+//    is the order of the ranges in pRange, for LoadDataFile.
+bool CSrecDataFileConverter::_ReadDataFile(const std::string &strData, TAddress nNewBase, CMemBlocks *pMemory, CMemRanges *pRange, CMemoryArray *pData, TDescElement nDesc) const
 {
 	bool bRetVal = true;
 	int nLineCount = 0;				// Line Counter
-	std::string strBuffer;			// Line Buffer
+	std::string::size_type nLinePos = 0;	// Position of the next line in strData
 	unsigned int nBytes;			// Number of bytes supposed to be on line
 	std::string::size_type nStrPos;	// Position in the string for processing
 	TAddress nOffsetAddr;			// Offset Address read on line
@@ -127,27 +149,34 @@ bool CSrecDataFileConverter::_ReadDataFile(std::istream &aFile, TAddress nNewBas
 		pRange->clear();
 	}
 
-	aFile.seekg(0L, std::ios_base::beg);
-	while ((!aFile.eof()) && (aFile.peek() != std::istream::traits_type::eof()) && aFile.good() && !bEndReached) {	// Note: peek needed because eof() doesn't set until following read
-		std::getline(aFile, strBuffer);
-		if (!aFile.good()) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_READFAILED);
+	while ((nLinePos < strData.size()) && !bEndReached) {
+		std::string::size_type nLineEnd = strData.find('\n', nLinePos);
+		if (nLineEnd == std::string::npos) nLineEnd = strData.size();
+		std::string_view strBuffer(strData.data() + nLinePos, nLineEnd - nLinePos);
+		nLinePos = nLineEnd + 1;
 		++nLineCount;
 
 		trim(strBuffer);
+		const char *pBuffer = strBuffer.data();
 		if (starts_with(strBuffer, "S") && (strBuffer.size() >= 6)) {	// Must have a minimum of Sxnnkk ('S', mode, byte count, checksum)
-			sscanf(&strBuffer.c_str()[1], "%1X%2X", &nMode, &nBytes);
+			nMode = decodeHex(&pBuffer[1], 1, nLineCount);
+			nBytes = decodeHex(&pBuffer[2], 2, nLineCount);
 			nChecksum = nBytes;
 			nStrPos = 4;		// Start at the address field
 			if (strBuffer.size() < (4 + (nBytes*2)))
 				THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_INVALID_RECORD, nLineCount, "Line too short");
 			// NOTE: nBytes includes addresss, data, and checksum fields in the count!!  (unlike Intel which is data only)
+			if (nBytes < 1)
+				THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_INVALID_RECORD, nLineCount, "Invalid Length");
 			nBytes -= 1;		// Don't count the checksum, since we aren't reading it with the data
 			switch (nMode) {
 				case 0:		// S0,S1,S5,S9 use 16-bit address field
 				case 1:
 				case 5:
 				case 9:
-					sscanf(&strBuffer.c_str()[nStrPos], "%4X", &nOffsetAddr);
+					if (nBytes < 2)
+						THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_INVALID_RECORD, nLineCount, "Invalid Length");
+					nOffsetAddr = decodeHex(&pBuffer[nStrPos], 4, nLineCount);
 					nChecksum += (nOffsetAddr/256) + (nOffsetAddr%256);
 					nStrPos += 4;
 					nBytes -= 2;
@@ -155,14 +184,18 @@ bool CSrecDataFileConverter::_ReadDataFile(std::istream &aFile, TAddress nNewBas
 				case 2:		// S2,S6,S8 use 24-bit address field
 				case 6:
 				case 8:
-					sscanf(&strBuffer.c_str()[nStrPos], "%6X", &nOffsetAddr);
+					if (nBytes < 3)
+						THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_INVALID_RECORD, nLineCount, "Invalid Length");
+					nOffsetAddr = decodeHex(&pBuffer[nStrPos], 6, nLineCount);
 					nChecksum += ((nOffsetAddr/65536ul)%256) + ((nOffsetAddr/256ul)%256) + (nOffsetAddr%256);
 					nStrPos += 6;
 					nBytes -= 3;
 					break;
 				case 3:		// S3,S7 use 32-bit address field
 				case 7:
-					sscanf(&strBuffer.c_str()[nStrPos], "%8X", &nOffsetAddr);
+					if (nBytes < 4)
+						THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_INVALID_RECORD, nLineCount, "Invalid Length");
+					nOffsetAddr = decodeHex(&pBuffer[nStrPos], 8, nLineCount);
 					nChecksum += ((nOffsetAddr/16777216ul)%256) + ((nOffsetAddr/65536ul)%256) + ((nOffsetAddr/256ul)%256) + (nOffsetAddr%256);
 					nStrPos += 8;
 					nBytes -= 4;
@@ -194,8 +227,7 @@ bool CSrecDataFileConverter::_ReadDataFile(std::istream &aFile, TAddress nNewBas
 			switch (nMode) {
 				case 0:			// ASCII Text Comment, encoded as data
 					for (unsigned int i = 0; i < nBytes; ++i) {
-						unsigned int nTempByte;
-						sscanf(&strBuffer.c_str()[nStrPos+i*2], "%2X", &nTempByte);
+						unsigned int nTempByte = decodeHex(&pBuffer[nStrPos+i*2], 2, nLineCount);
 						nChecksum += nTempByte;
 					}
 					// Ignore the comment data -- TODO : Find something to do with it?  like print it?
@@ -204,9 +236,9 @@ bool CSrecDataFileConverter::_ReadDataFile(std::istream &aFile, TAddress nNewBas
 				case 2:
 				case 3:
 					for (unsigned int i = 0; i < nBytes; ++i) {
-						unsigned int nTempByte;
-						sscanf(&strBuffer.c_str()[nStrPos+i*2], "%2X", &nTempByte);
+						unsigned int nTempByte = decodeHex(&pBuffer[nStrPos+i*2], 2, nLineCount);
 						nChecksum += nTempByte;
+						if (pData) pData->push_back(nTempByte);
 						if (pMemory) {
 							if (!pMemory->setElement(nCurrAddr, nTempByte)) {
 								THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_OVERFLOW, nLineCount);
@@ -237,8 +269,7 @@ bool CSrecDataFileConverter::_ReadDataFile(std::istream &aFile, TAddress nNewBas
 					break;
 			}
 
-			unsigned int nTempByte;
-			sscanf(&strBuffer.c_str()[nStrPos+nBytes*2], "%2X", &nTempByte);
+			unsigned int nTempByte = decodeHex(&pBuffer[nStrPos+nBytes*2], 2, nLineCount);
 			nChecksum += nTempByte;
 			if ((nChecksum % 256) != 0xFF) {		// Checksum is one's complement, so sum including it is 0xFF
 				THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_CHECKSUM, nLineCount);
@@ -259,8 +290,7 @@ bool CSrecDataFileConverter::_ReadDataFile(std::istream &aFile, TAddress nNewBas
 	}
 
 	// Check EOF:
-	if (((aFile.eof()) || (aFile.peek() != std::istream::traits_type::eof()) || aFile.good()) &&
-		!bEndReached) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_UNEXPECTED_EOF);
+	if (!bEndReached) THROW_EXCEPTION_ERROR(EXCEPTION_ERROR::ERR_UNEXPECTED_EOF);
 
 	return bRetVal;
 }
@@ -9,6 +9,8 @@
 #include "gdc.h"
 #include "dfc.h"
 #include "errmsgs.h"
+#include "perfstats.h"
+#include "threadhelp.h"
 
 #include <ctime>
 #include <ctype.h>
@@ -18,6 +20,12 @@
 #include <iterator>
 #include <regex>
 #include <filesystem>
+#include <mutex>
+#include <thread>
+
+#ifdef LIBIBERTY_SUPPORT
+#include <libiberty/demangle.h>
+#endif
 
 #define VERSION 0x300				// GDC Version number 3.00
 
@@ -27,9 +35,23 @@
 
 // ============================================================================
 
+// std::ctime returns a shared static buffer, so it's guarded here for
+//	disassemblers running in parallel (see gendasm --parallel):
+static std::string formatTime(time_t nTime)
+{
+	static std::mutex mtxCTime;
+	std::lock_guard<std::mutex> lock(mtxCTime);
+	return std::ctime(&nTime);
+}
+
+// Size of the buffer for the disassembly and functions output files, large
+//	enough to hold most outputs entirely, rather than writing them out in
+//	many small pieces:
+static constexpr std::size_t OUTPUT_BUFFER_SIZE = 1024*1024;
+
 typedef std::map<std::string, int> TKeywordMap;
 
-int parseKeyword(const TKeywordMap &map, const std::string &strKeyword)
+static int parseKeyword(const TKeywordMap &map, const std::string &strKeyword)
 {
 	for (auto const & itr : map) {
 		if (std::regex_match(strKeyword, std::regex(itr.first, std::regex::extended))) return itr.second;
@@ -143,7 +165,55 @@ namespace {
 	};
 };
 
-// ----------------------------------------------------------------------------
+// ============================================================================
+
+#ifdef LIBIBERTY_SUPPORT
+extern "C" {
+	static void demangle_callback(const char *pString, size_t nSize, void *pData)
+	{
+		std::string *pRetVal = (std::string *)(pData);
+		if (pRetVal) {
+			(*pRetVal) += std::string(pString, nSize);
+		}
+	}
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////
+// CDisassembler::CDemangleCache Class
+//////////////////////////////////////////////////////////////////////
+//		Memoised results of DemangleSymbol(), keyed by the mangled name,
+//		with separate maps for verbose and not.  Only the lookups and
+//		inserts are done while locked, so the demangling itself can run
+//		on multiple threads.  That's safe since libiberty's
+//		cplus_demangle_v3_callback() keeps all of its state on the stack.
+//		If two threads demangle the same symbol at once, the first result
+//		inserted is kept, and both are the same anyway.
+class CDisassembler::CDemangleCache
+{
+public:
+	bool find(const TLabel &strMangled, bool bVerbose, TLabel &strDemangled) const
+	{
+		std::lock_guard<std::mutex> lock(m_mtxCache);
+		const std::map<TLabel, TLabel> &mapCache = m_mapDemangled[bVerbose ? 1 : 0];
+		std::map<TLabel, TLabel>::const_iterator itrCache = mapCache.find(strMangled);
+		if (itrCache == mapCache.cend()) return false;
+		strDemangled = itrCache->second;
+		return true;
+	}
+
+	void insert(const TLabel &strMangled, bool bVerbose, const TLabel &strDemangled)
+	{
+		std::lock_guard<std::mutex> lock(m_mtxCache);
+		m_mapDemangled[bVerbose ? 1 : 0].try_emplace(strMangled, strDemangled);
+	}
+
+private:
+	mutable std::mutex m_mtxCache;
+	std::map<TLabel, TLabel> m_mapDemangled[2];
+};
+
+// ============================================================================
 
 CDisassembler::CDisassembler()
 	:	m_bDeterministic(false),
@@ -172,6 +242,7 @@ CDisassembler::CDisassembler()
 		m_nCtrlLine(0),
 		m_nFilesLoaded(0),
 		m_PC(0),
+		m_pDemangleCache(std::make_unique<CDemangleCache>()),
 		m_LAdrDplyCnt(0)
 {
 }
@@ -290,6 +361,7 @@ static void parseArgLine(const std::string aLine, CStringArray &args)
 
 bool CDisassembler::ReadControlFile(ifstreamControlFile& inFile, bool bLastFile, std::ostream *msgFile, std::ostream *errFile, int nStartLineCount)
 {
+	CPerfStats::CPhase phase("ReadControlFile");
 	bool bRetVal = true;
 
 	std::string aLine;
@@ -1046,6 +1118,7 @@ bool CDisassembler::ParseControlLine(const std::string & strLine, const CStringA
 
 bool CDisassembler::ReadSourceFile(const std::string & strFilename, TAddress nLoadAddress, const std::string & strDFCLibrary, std::ostream *msgFile, std::ostream *errFile)
 {
+	CPerfStats::CPhase phase("ReadSourceFile");
 	if (strDFCLibrary.empty()) return false;
 	if (strFilename.empty()) return false;
 
@@ -1068,13 +1141,7 @@ bool CDisassembler::ReadSourceFile(const std::string & strFilename, TAddress nLo
 		m_sInputFileList.push_back(strFilename);
 
 		try {
-			if (!pDFC->RetrieveFileMapping(*this, strFilename, nLoadAddress, msgFile, errFile)) {
-				if (errFile) {
-					(*errFile) << "*** Unable to completely retrieve the file mapping for \"" << strFilename << "\"\n";
-				}
-			}
-
-			bStatus = pDFC->ReadDataFile(*this, strFilename, nLoadAddress, DMEM_LOADED, msgFile, errFile);
+			bStatus = pDFC->LoadDataFile(*this, strFilename, nLoadAddress, DMEM_LOADED, msgFile, errFile);
 		}
 		catch (const EXCEPTION_ERROR &aErr) {
 			bRetVal = false;
@@ -1204,53 +1271,49 @@ bool CDisassembler::ScanIndirects(std::ostream *msgFile, std::ostream *errFile)
 
 bool CDisassembler::ScanEntries(std::ostream *msgFile, std::ostream *errFile)
 {
+	CPerfStats::CPhase phase("ScanEntries");
 	bool bRetVal = true;
-	CAddressSet::size_type nCount = m_EntryTable.size();
 
 	if (m_bSpitFlag) {
 		m_PC = m_Memory[MT_ROM].lowestLogicalAddress();		// In spit mode, we start at first address and just spit
 		return FindCode(msgFile, errFile);
 	}
 
-	CAddressSet::const_iterator itrEntry = m_EntryTable.cbegin();
-	while (bRetVal && (itrEntry != m_EntryTable.cend())) {
-		m_PC = *itrEntry;
-		++itrEntry;
+	// Each entry is followed once, lowest address first.  Any added during
+	//	the find process get added to m_PendingEntries by AddEntry():
+	while (bRetVal && !m_PendingEntries.empty()) {
+		m_PC = *m_PendingEntries.cbegin();
+		m_PendingEntries.erase(m_PendingEntries.cbegin());
+		CPerfStats::count(PC_ENTRIES_FOLLOWED);
 
 		bRetVal = bRetVal && FindCode(msgFile, errFile);
-
-		if (nCount != m_EntryTable.size()) {
-			nCount = m_EntryTable.size();
-			itrEntry = m_EntryTable.cbegin();			// If one gets added during the find process, our iterator gets invalidated and we must start over...
-		}
 	}
 	return bRetVal;
 }
 
 bool CDisassembler::ScanBranches(std::ostream *msgFile, std::ostream *errFile)
 {
+	CPerfStats::CPhase phase("ScanBranches");
 	bool bRetVal = true;
-	CAddressTableMap::size_type nCount = m_BranchTable.size();
 
 	if (m_bSpitFlag) return true;						// Don't do anything in spit mode cause we did it in ScanEntries!
 
-	CAddressTableMap::const_iterator itrEntry = m_BranchTable.cbegin();
-	while (bRetVal && (itrEntry != m_BranchTable.cend())) {
-		m_PC = itrEntry->first;
-		++itrEntry;
+	// Each branch is followed once, lowest address first, which is the same
+	//	order that walking m_BranchTable would visit them.  Those discovered
+	//	during the find process get added to m_PendingBranches by AddBranch():
+	while (bRetVal && !m_PendingBranches.empty()) {
+		m_PC = *m_PendingBranches.cbegin();
+		m_PendingBranches.erase(m_PendingBranches.cbegin());
+		CPerfStats::count(PC_BRANCHES_FOLLOWED);
 
 		bRetVal = bRetVal && FindCode(msgFile, errFile);
-
-		if (nCount != m_BranchTable.size()) {
-			nCount = m_BranchTable.size();
-			itrEntry = m_BranchTable.cbegin();			// If one gets added during the find process, our iterator gets invalidated and we must start over...
-		}
 	}
 	return bRetVal;
 }
 
 bool CDisassembler::ScanData(const std::string & strExcludeChars, std::ostream *msgFile, std::ostream *errFile)
 {
+	CPerfStats::CPhase phase("ScanData");
 	UNUSED(errFile);
 
 	TMemoryElement c;
@@ -1312,9 +1375,11 @@ bool CDisassembler::ScanData(const std::string & strExcludeChars, std::ostream *
 		if (m_Memory[nMemType].empty()) continue;
 
 		for (auto & itrMemory : m_Memory[nMemType]) {
-			m_PC = itrMemory.logicalAddr();
-			for (TSize nSize = 0; nSize < itrMemory.size(); ++nSize, ++m_PC) {
-				if (itrMemory.descriptor(m_PC) != DMEM_LOADED) continue;	// Only modify memory locations that have been loaded but not processed!
+			// Only modify memory locations that have been loaded but not processed!
+			for (TSize nSize = itrMemory.findDescriptor(itrMemory.logicalAddr(), itrMemory.size(), DMEM_LOADED);
+					nSize < itrMemory.size();
+					nSize += 1 + itrMemory.findDescriptor(itrMemory.logicalAddr() + nSize + 1, itrMemory.size() - nSize - 1, DMEM_LOADED)) {
+				m_PC = itrMemory.logicalAddr() + nSize;
 				c = itrMemory.element(m_PC);
 				if (isprint(c) && (strExcludeChars.find(c) == std::string::npos)) {
 					itrMemory.setDescriptor(m_PC, DMEM_PRINTDATA);
@@ -1327,15 +1392,18 @@ bool CDisassembler::ScanData(const std::string & strExcludeChars, std::ostream *
 	return true;
 }
 
-bool CDisassembler::Disassemble(std::ostream *msgFile, std::ostream *errFile, std::ostream *outFile)
+bool CDisassembler::Disassemble(std::ostream *msgFile, std::ostream *errFile, std::ostream *outFile, std::ostream *functionsFile)
 {
 	bool bRetVal = true;
 	std::ostream *theOutput;
+	std::vector<char> arrOutputBuffer;		// Must outlive aOutput
 	std::fstream aOutput;
 
 	if (outFile) {
 		theOutput = outFile;
 	} else {
+		arrOutputBuffer.resize(OUTPUT_BUFFER_SIZE);
+		aOutput.rdbuf()->pubsetbuf(arrOutputBuffer.data(), arrOutputBuffer.size());		// Must be set before opening
 		aOutput.open(m_sOutputFilename.c_str(), std::ios_base::out | std::ios_base::trunc);
 		if (!aOutput.is_open()) {
 			if (errFile) {
@@ -1358,12 +1426,12 @@ bool CDisassembler::Disassemble(std::ostream *msgFile, std::ostream *errFile, st
 		bRetVal = Pass2(*theOutput, msgFile, errFile);
 		if (!bRetVal) break;
 
-		if (!m_sFunctionsFilename.empty()) {
+		if (functionsFile || !m_sFunctionsFilename.empty()) {
 			if (*msgFile) {
 				(*msgFile) << "\n\nPass 3 - Creating Functions Output File...\n";
 			}
 			m_LAdrDplyCnt = 0;
-			bRetVal = Pass3(*theOutput, msgFile, errFile);
+			bRetVal = Pass3(*theOutput, msgFile, errFile, functionsFile);
 			if (!bRetVal) break;
 		}
 
@@ -1425,6 +1493,7 @@ bool CDisassembler::Pass1(std::ostream& outFile, std::ostream *msgFile, std::ost
 
 bool CDisassembler::Pass2(std::ostream& outFile, std::ostream *msgFile, std::ostream *errFile)
 {
+	CPerfStats::CPhase phase("Pass2");
 	bool bRetVal = true;
 
 	// Note that Short-Circuiting will keep following process stages from being called in the event of an error!
@@ -1440,24 +1509,32 @@ bool CDisassembler::Pass2(std::ostream& outFile, std::ostream *msgFile, std::ost
 	return bRetVal;
 }
 
-bool CDisassembler::Pass3(std::ostream& outFile, std::ostream *msgFile, std::ostream *errFile)
+bool CDisassembler::Pass3(std::ostream& outFile, std::ostream *msgFile, std::ostream *errFile, std::ostream *functionsFile)
 {
+	CPerfStats::CPhase phase("Pass3");
 	UNUSED(outFile);
 
 	const MEMORY_TYPE nMemType = MT_ROM;
 
 	bool bRetVal = true;
-	std::fstream aFunctionsFile;
+	std::vector<char> arrOutputBuffer;		// Must outlive aFunctionsOutput
+	std::fstream aFunctionsOutput;
 	bool bTempFlag;
 	bool bTempFlag2;
 
-	aFunctionsFile.open(m_sFunctionsFilename.c_str(), std::ios_base::out | std::ios_base::trunc);
-	if (!aFunctionsFile.is_open()) {
-		if (errFile) {
-			(*errFile) << "\n*** Error: Opening file \"" << m_sFunctionsFilename << "\" for writing...\n";
+	if (!functionsFile) {
+		arrOutputBuffer.resize(OUTPUT_BUFFER_SIZE);
+		aFunctionsOutput.rdbuf()->pubsetbuf(arrOutputBuffer.data(), arrOutputBuffer.size());		// Must be set before opening
+		aFunctionsOutput.open(m_sFunctionsFilename.c_str(), std::ios_base::out | std::ios_base::trunc);
+		if (!aFunctionsOutput.is_open()) {
+			if (errFile) {
+				(*errFile) << "\n*** Error: Opening file \"" << m_sFunctionsFilename << "\" for writing...\n";
+			}
+			return false;
 		}
-		return false;
+		functionsFile = &aFunctionsOutput;
 	}
+	std::ostream &aFunctionsFile = *functionsFile;
 
 	// Output File Header Comments:
 	aFunctionsFile << ";\n";
@@ -1512,7 +1589,7 @@ bool CDisassembler::Pass3(std::ostream& outFile, std::ostream *msgFile, std::ost
 
 	if (!m_bDeterministic) {
 		aFunctionsFile << ";\n";
-		aFunctionsFile << ";       Generated:  " << std::ctime(&m_StartTime);		// Note: std::ctime adds extra \n character, so no need to add our own
+		aFunctionsFile << ";       Generated:  " << formatTime(m_StartTime);		// Note: std::ctime adds extra \n character, so no need to add our own
 	}
 	aFunctionsFile << ";\n\n";
 
@@ -1782,9 +1859,7 @@ bool CDisassembler::Pass3(std::ostream& outFile, std::ostream *msgFile, std::ost
 				case DMEM_ILLEGALCODE:
 				{
 					static const std::set<MEM_DESC> setData = { DMEM_DATA, DMEM_PRINTDATA, DMEM_ALLOC };
-					std::ostringstream sstrTemp;
-					sstrTemp << std::uppercase << std::setfill('0') << std::setw(4) << std::setbase(16) << m_PC << "|";
-					m_sFunctionalOpcode = sstrTemp.str();
+					m_sFunctionalOpcode = hexString(m_PC, 4) + "|";
 
 					CLabelTableMap::const_iterator itrLabels = m_LabelTable[nMemType].find(m_PC);
 					if (itrLabels != m_LabelTable[nMemType].cend()) {
@@ -1796,9 +1871,7 @@ bool CDisassembler::Pass3(std::ostream& outFile, std::ostream *msgFile, std::ost
 					m_sFunctionalOpcode += "|";
 
 					do {
-						sstrTemp.str(std::string());
-						sstrTemp << std::uppercase << std::setfill('0') << std::setw(2) << std::setbase(16) << static_cast<unsigned int>(m_Memory[nMemType].element(m_PC));
-						m_sFunctionalOpcode += sstrTemp.str();
+						appendHex(m_sFunctionalOpcode, m_Memory[nMemType].element(m_PC), 2);
 
 						++m_PC;
 						++nSize;
@@ -1811,6 +1884,7 @@ bool CDisassembler::Pass3(std::ostream& outFile, std::ostream *msgFile, std::ost
 					break;
 				}
 				case DMEM_CODE:
+					CPerfStats::count(PC_OPCODES_DECODED);
 					bRetVal = ReadNextObj(nMemType, false, msgFile, errFile);
 					nSize += (m_PC - nSavedPC);		// NOTE: ReadNextObj automatically advanced m_PC while reading object!
 					break;
@@ -1823,9 +1897,7 @@ bool CDisassembler::Pass3(std::ostream& outFile, std::ostream *msgFile, std::ost
 			}
 
 			if (!m_sFunctionalOpcode.empty()) {
-				std::ostringstream sstrTemp;
-				sstrTemp << std::uppercase << std::setfill('0') << std::setw(4) << std::setbase(16) << (nSavedPC - nFuncAddr) << "|";
-				m_sFunctionalOpcode = sstrTemp.str() + m_sFunctionalOpcode;
+				m_sFunctionalOpcode = hexString(nSavedPC - nFuncAddr, 4) + "|" + m_sFunctionalOpcode;
 			}
 
 			if (bBranchOutFlag) {
@@ -1871,7 +1943,7 @@ bool CDisassembler::Pass3(std::ostream& outFile, std::ostream *msgFile, std::ost
 		}
 	}
 
-	aFunctionsFile.close();
+	if (aFunctionsOutput.is_open()) aFunctionsOutput.close();		// Close the functions file if we opened it
 
 	return bRetVal;
 }
@@ -1890,12 +1962,12 @@ bool CDisassembler::FindCode(std::ostream *msgFile, std::ostream *errFile)
 		// See if m_PC is in an area of memory that doesn't exist:
 		if (!m_Memory[nMemType].containsAddress(m_PC)) {
 			if (m_bSpitFlag) {
-				// In spit mode, find next address inside memory that hasn't been "looked at":
-				while (!m_Memory[nMemType].containsAddress(m_PC) && (m_PC <= nHighestAddress)) ++m_PC;	// Skip non-existant addresses
-				while (m_Memory[nMemType].containsAddress(m_PC) && (m_PC <= nHighestAddress) &&
-					   (m_Memory[nMemType].descriptor(m_PC) != DMEM_LOADED)) {
-					++m_PC;		// Skip "observed" locations (such as those from declared Data Blocks)
-					while (!m_Memory[nMemType].containsAddress(m_PC) && (m_PC <= nHighestAddress)) ++m_PC;	// Skip non-existant addresses
+				// In spit mode, find next address inside memory that hasn't been "looked at",
+				//	skipping non-existant addresses and "observed" locations (such as those
+				//	from declared Data Blocks).  If there isn't one, this leaves m_PC just
+				//	past nHighestAddress:
+				if (m_PC <= nHighestAddress) {
+					m_PC += m_Memory[nMemType].findDescriptor(m_PC, static_cast<TSize>(nHighestAddress - m_PC) + 1, DMEM_LOADED);
 				}
 			} else {
 				bDoneFlag = true;			// We are done with this find if there's nothing here in memory
@@ -1910,6 +1982,7 @@ bool CDisassembler::FindCode(std::ostream *msgFile, std::ostream *errFile)
 			bDoneFlag = true;				// Exit when we hit an area we've already looked at
 			continue;
 		}
+		CPerfStats::count(PC_OPCODES_DECODED);
 		if (ReadNextObj(nMemType, true, msgFile, errFile)) {		// Read next opcode and tag memory since we are finding code here, NOTE: This increments m_PC!
 			if (CurrentOpcodeIsStop() && !m_bSpitFlag) bDoneFlag = true;		// Done when we hit a code exit point, unless we're just spitting code out
 		}	// If the ReadNextObj returns false, that means we hit an illegal opcode byte.  The ReadNextObj will have incremented the m_PC past that byte, so we'll keep processing
@@ -1922,10 +1995,7 @@ bool CDisassembler::FindCode(std::ostream *msgFile, std::ostream *errFile)
 
 std::string CDisassembler::FormatAddress(TAddress nAddress) const
 {
-	std::ostringstream sstrTemp;
-
-	sstrTemp << std::uppercase << std::setfill('0') << std::setw(4) << std::setbase(16) << nAddress;
-	return sstrTemp.str();
+	return hexString(nAddress, 4);
 }
 
 TAddress CDisassembler::UnformatAddress(const std::string strAddress) const
@@ -1963,9 +2033,8 @@ std::string CDisassembler::FormatReferences(MEMORY_TYPE nMemoryType, MNEMONIC_CO
 				bFlag = true;
 				for (CAddressArray::size_type i=0; i<itrBranches->second.size(); ++i) {
 					if (i != 0) strRetVal += ",";
-					std::ostringstream sstrTemp;
-					sstrTemp << GetHexDelim() << std::uppercase << std::setfill('0') << std::setw(4) << std::setbase(16) << itrBranches->second.at(i);
-					strRetVal += sstrTemp.str();
+					strRetVal += GetHexDelim();
+					appendHex(strRetVal, itrBranches->second.at(i), 4);
 				}
 			}
 		}
@@ -1984,9 +2053,8 @@ std::string CDisassembler::FormatReferences(MEMORY_TYPE nMemoryType, MNEMONIC_CO
 			bFlag = true;
 			for (CAddressArray::size_type i=0; i<itrLabelRef->second.size(); ++i) {
 				if (i != 0) strRetVal += ",";
-				std::ostringstream sstrTemp;
-				sstrTemp << GetHexDelim() << std::uppercase << std::setfill('0') << std::setw(4) << std::setbase(16) << itrLabelRef->second.at(i);
-				strRetVal += sstrTemp.str();
+				strRetVal += GetHexDelim();
+				appendHex(strRetVal, itrLabelRef->second.at(i), 4);
 			}
 		}
 	}
@@ -2144,7 +2212,6 @@ std::string CDisassembler::MakeOutputLine(CStringArray& saOutputData) const
 {
 	std::string strOutput;
 	std::string strTemp;
-	std::string strTemp2;
 	std::string strItem;
 	std::string::size_type fw = 0;
 	std::string::size_type pos = 0;
@@ -2170,11 +2237,25 @@ std::string CDisassembler::MakeOutputLine(CStringArray& saOutputData) const
 	//	of the label -- not in the middle of it!.
 	//
 
+	// The field layout and comment delimiters don't change within a line, so
+	//	look them up once rather than once per use:
+	std::string::size_type arrFieldWidths[NUM_FIELD_CODES];
+	std::string::size_type nLineWidth = 0;
+	for (int i = 0; i < NUM_FIELD_CODES; ++i) {
+		arrFieldWidths[i] = GetFieldWidth(static_cast<FIELD_CODE>(i));
+		nLineWidth += arrFieldWidths[i];
+	}
+	const std::string strCommentStart = GetCommentStartDelim();
+	const std::string strCommentEnd = GetCommentEndDelim();
+	const std::string::size_type nCommentDelimSize = strCommentStart.size() + strCommentEnd.size() + 2;	// Size of delimiters, with their spacing, around a comment
+
+	strOutput.reserve(nLineWidth);
+
 	for (CStringArray::size_type i=0; i<saOutputData.size(); ++i) {
 		strItem = saOutputData[i];
 
 		tfw += fw;
-		fw = GetFieldWidth(static_cast<FIELD_CODE>(i));
+		fw = ((i < NUM_FIELD_CODES) ? arrFieldWidths[i] : GetFieldWidth(static_cast<FIELD_CODE>(i)));
 
 		if (!m_bAddrFlag && (i == FC_ADDRESS)) {
 			pos += fw;
@@ -2187,9 +2268,7 @@ std::string CDisassembler::MakeOutputLine(CStringArray& saOutputData) const
 
 		if (i == FC_LABEL) {			// Check for Label Break:
 			if (strItem.find('\v') != std::string::npos) {
-				while (strItem.find('\v') != std::string::npos) {
-					strItem = strItem.substr(0, strItem.find('\v')) + strItem.substr(strItem.find('\v')+1);
-				}
+				strItem.erase(std::remove(strItem.begin(), strItem.end(), '\v'), strItem.end());
 				strSaveLabel = strItem;
 				strItem.clear();
 				bLabelBreak = true;
@@ -2212,11 +2291,9 @@ std::string CDisassembler::MakeOutputLine(CStringArray& saOutputData) const
 			}
 		}
 		if (i == FC_COMMENT) {			// Check comment "wrap"
-			strTemp = GetCommentStartDelim() + " " + strItem + " " + GetCommentEndDelim();
-			strTemp2 = GetCommentStartDelim() + "  " + GetCommentEndDelim();
-			if ((strTemp.size() > fw) || (strTemp.find('\n') != std::string::npos)) {
+			if (((strItem.size() + nCommentDelimSize) > fw) || (strItem.find('\n') != std::string::npos)) {
 				bool bNeedsTossing = false;
-				strTemp = strItem.substr(0, fw - strTemp2.size());
+				strTemp = strItem.substr(0, fw - nCommentDelimSize);
 				nTempPos = strTemp.find('\n');			// We have to treat '\n' special to always break on the first
 				if (nTempPos == std::string::npos) {
 					nTempPos = strTemp.find_last_of(" \t,;:.!?");		// No need to check '\n' since we just did so above
@@ -2235,44 +2312,45 @@ std::string CDisassembler::MakeOutputLine(CStringArray& saOutputData) const
 					}
 					strItem = strTemp;
 				} else {
-					strCommentPart = "  " + strItem.substr(fw+1-strTemp2.size());
-					strItem = strItem.substr(0, fw-strTemp2.size());
+					strCommentPart = "  " + strItem.substr(fw+1-nCommentDelimSize);
+					strItem = strItem.substr(0, fw-nCommentDelimSize);
 				}
 			}
-		}
 
-		if (i == FC_COMMENT) {
-			if (!strItem.empty())
-				strItem = GetCommentStartDelim() + " " + strItem + " " + GetCommentEndDelim();
+			if (!strItem.empty()) {
+				strTemp.clear();
+				strTemp.reserve(strItem.size() + nCommentDelimSize);
+				strTemp.append(strCommentStart).append(" ").append(strItem).append(" ").append(strCommentEnd);
+				strItem.swap(strTemp);
+			}
 		}
 
 		if (m_bTabsFlag) {
-			while (pos < tfw) {
+			if (pos < tfw) {
 				if (m_nTabWidth != 0) {
-					while ((tfw - pos) % m_nTabWidth) {
-						strOutput += " ";
-						++pos;
-					}
-					while ((tfw - pos) / m_nTabWidth) {
-						strOutput += "\t";
-						pos += m_nTabWidth;
-					}
+					strOutput.append((tfw - pos) % m_nTabWidth, ' ');
+					strOutput.append((tfw - pos) / m_nTabWidth, '\t');
 				} else {
-					strOutput += " ";
-					++pos;
+					strOutput.append(tfw - pos, ' ');
 				}
+				pos = tfw;
 			}
 			strOutput += strItem;
 		} else {
-			strTemp.clear();
-			for (int j=0; j<m_nTabWidth; ++j) strTemp += " ";
-			while (strItem.find('\t') != std::string::npos) {
-				nTempPos = strItem.find('\t');
-				strItem = strItem.substr(0, nTempPos) + strTemp + strItem.substr(nTempPos+1);
+			if (strItem.find('\t') != std::string::npos) {
+				strTemp.clear();
+				for (auto const &ch : strItem) {
+					if (ch == '\t') {
+						strTemp.append(std::max(m_nTabWidth, 0), ' ');
+					} else {
+						strTemp.push_back(ch);
+					}
+				}
+				strItem.swap(strTemp);
 			}
-			while (pos < tfw) {
-				strOutput += " ";
-				++pos;
+			if (pos < tfw) {
+				strOutput.append(tfw - pos, ' ');
+				pos = tfw;
 			}
 			strOutput += strItem;
 		}
@@ -2406,7 +2484,7 @@ bool CDisassembler::WriteHeader(std::ostream& outFile, std::ostream *msgFile, st
 		saOutLine[FC_LABEL] = GetCommentStartDelim() + GetCommentEndDelim() + "\n";
 		outFile << MakeOutputLine(saOutLine) << "\n";
 		saOutLine[FC_LABEL] = GetCommentStartDelim() + "       Generated:  ";
-		saOutLine[FC_LABEL] += std::ctime(&m_StartTime);
+		saOutLine[FC_LABEL] += formatTime(m_StartTime);
 		saOutLine[FC_LABEL].erase(saOutLine[FC_LABEL].end()-1);		// Note: std::ctime adds extra \n character
 		saOutLine[FC_LABEL] += GetCommentEndDelim() + "\n";
 		outFile << MakeOutputLine(saOutLine) << "\n";
@@ -3035,6 +3113,7 @@ bool CDisassembler::WriteCodeSection(MEMORY_TYPE nMemoryType, const CMemBlock &m
 					break;
 				case DMEM_CODE:
 					fnWriteLabels(m_PC);	// Must do this before bumping m_PC
+					CPerfStats::count(PC_OPCODES_DECODED);
 					// If the following call returns false, that means that we erroneously
 					//	detected code in the first pass so instead of throwing an error or
 					//	causing problems, we will treat it as an illegal opcode:
@@ -3207,12 +3286,8 @@ bool CDisassembler::ValidateLabelName(const TLabel & aName)
 
 bool CDisassembler::IsAddressLoaded(MEMORY_TYPE nMemoryType, TAddress nAddress, TSize nSize)
 {
-	bool bRetVal = true;
-
-	for (TSize i=0; ((i<nSize) && (bRetVal)); ++i) {
-		bRetVal = bRetVal && (m_Memory[nMemoryType].descriptor(nAddress + i) != DMEM_NOTLOADED);
-	}
-	return bRetVal;
+	// Addresses outside of memory are DMEM_NOTLOADED too:
+	return (m_Memory[nMemoryType].findDescriptor(nAddress, nSize, DMEM_NOTLOADED) == nSize);
 }
 
 bool CDisassembler::IsAddressInRange(MEMORY_TYPE nRange, TAddress nAddress)
@@ -3279,6 +3354,7 @@ bool CDisassembler::AddBranch(TAddress nAddress, bool bAddRef, TAddress nRefAddr
 		m_BranchTable[nAddress] = CAddressArray();
 		itrRefList = m_BranchTable.find(nAddress);
 		assert(itrRefList != m_BranchTable.end());
+		m_PendingBranches.insert(nAddress);		// New branch for ScanBranches to follow
 	}
 	if (bAddRef) {				// Search and add reference
 		bool bFound = false;
@@ -3309,7 +3385,9 @@ bool CDisassembler::AddComment(MEMORY_TYPE nMemoryType, TAddress nAddress, const
 
 bool CDisassembler::AddEntry(TAddress nAddress)
 {
-	m_EntryTable.insert(nAddress);					// Add an entry to the entry table
+	if (m_EntryTable.insert(nAddress).second) {		// Add an entry to the entry table
+		m_PendingEntries.insert(nAddress);			// New entry for ScanEntries to follow
+	}
 	m_FunctionEntryTable[nAddress] = FUNCF_ENTRY;	// Entries are also considered start-of functions
 	return true;
 }
@@ -3346,6 +3424,41 @@ bool CDisassembler::AddObjectMapping(MEMORY_TYPE nMemoryType, TAddress nBaseObje
 
 // ----------------------------------------------------------------------------
 
+TLabel CDisassembler::DemangleSymbol(const TLabel &strMangled, bool bVerbose) const
+{
+	TLabel strDemangled;
+#ifdef LIBIBERTY_SUPPORT
+	if (strMangled.empty()) return strDemangled;
+	if (m_pDemangleCache->find(strMangled, bVerbose, strDemangled)) return strDemangled;
+
+	if (!bVerbose || !cplus_demangle_v3_callback(strMangled.c_str(), DMGL_PARAMS | DMGL_ANSI | DMGL_VERBOSE | DMGL_TYPES, demangle_callback, &strDemangled)) {
+		cplus_demangle_v3_callback(strMangled.c_str(), DMGL_NO_OPTS, demangle_callback, &strDemangled);
+	}
+	m_pDemangleCache->insert(strMangled, bVerbose, strDemangled);
+#else
+	UNUSED(strMangled);
+	UNUSED(bVerbose);
+#endif
+	return strDemangled;
+}
+
+void CDisassembler::DemangleSymbols(const std::vector<TLabel> &arrMangled, bool bVerbose) const
+{
+	// Large enough ranges that the threads aren't just fighting over the
+	//	cache lock and the counter, small enough to balance at the end:
+	constexpr std::size_t RANGE_SIZE = 64;
+	const std::size_t nRanges = (arrMangled.size() + RANGE_SIZE - 1) / RANGE_SIZE;
+
+	runParallelThreads(nRanges, std::max(std::thread::hardware_concurrency(), 1u), [&](std::size_t ndxRange)->void {
+		const std::size_t ndxEnd = std::min(arrMangled.size(), (ndxRange+1)*RANGE_SIZE);
+		for (std::size_t ndx = ndxRange*RANGE_SIZE; ndx < ndxEnd; ++ndx) {
+			DemangleSymbol(arrMangled.at(ndx), bVerbose);
+		}
+	}, "Demangle Symbols");
+}
+
+// ----------------------------------------------------------------------------
+
 void CDisassembler::GenDataLabel(MEMORY_TYPE nMemoryType, TAddress nAddress, TAddress nRefAddress, const TLabel & strLabel, std::ostream *msgFile, std::ostream *errFile)
 {
 	UNUSED(strLabel);
@@ -3399,10 +3512,8 @@ TLabel CDisassembler::GenLabel(MEMORY_TYPE nMemoryType, TAddress nAddress)
 {
 	UNUSED(nMemoryType);
 
-	std::ostringstream sstrTemp;
-
-	sstrTemp << "L" << std::uppercase << std::setfill('0') << std::setw(4) << std::setbase(16) << nAddress;
-	return sstrTemp.str();
+	TLabel strLabel = "L";
+	return appendHex(strLabel, nAddress, 4);
 }
 
 // ----------------------------------------------------------------------------
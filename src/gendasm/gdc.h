@@ -23,6 +23,8 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <memory>
+#include <span>
 #include <utility>
 
 #include <assert.h>
@@ -177,11 +179,23 @@ template<typename TDisassembler> using COpcodeEntryArray = std::vector< COpcodeE
 //		first TOpcodeSymbol first).
 //		It is also the users responsibility to not add duplicate or
 //		conflicting opcodes!
+//
+//		Since finding an opcode by masking the first symbol against each
+//		entry in turn is a linear search, BuildDecodeIndex() should be
+//		called once the table is populated.  It builds a direct index
+//		over every possible first symbol value listing the entries that
+//		can match it, in the same order as the array, so decodeCandidates()
+//		will give the same results as the linear search would.  The array
+//		itself remains the source of truth and adding another opcode
+//		discards the index until it is built again.
 template<typename TDisassembler>
 class COpcodeTableArray : public COpcodeEntryArray<TDisassembler>
 {
 	using array_type = COpcodeEntryArray<TDisassembler>;
+	using symbol_type = typename TDisassembler::TOpcodeSymbol;
 public:
+	typedef uint32_t index_type;
+
 	void AddOpcode(const COpcodeEntry<TDisassembler> & entry)
 	{
 		if (entry.opcode().empty() || entry.opcodeMask().empty()) {
@@ -194,7 +208,61 @@ public:
 		}
 
 		array_type::push_back(entry);
+		m_arrDecodeStart.clear();		// Index must be rebuilt
+	}
+
+	void BuildDecodeIndex()
+	{
+		// Count the candidates for each first symbol, then convert the
+		//	counts to starting offsets and fill them in array order:
+		m_arrDecodeStart.assign(NUM_FIRST_SYMBOLS + 1, 0);
+		for (auto const & entry : *this) {
+			forEachFirstSymbol(entry, [this](index_type nSymbol)->void { ++m_arrDecodeStart[nSymbol+1]; });
+		}
+		for (std::size_t ndx = 1; ndx < m_arrDecodeStart.size(); ++ndx) m_arrDecodeStart[ndx] += m_arrDecodeStart[ndx-1];
+
+		m_arrDecodeIndex.resize(m_arrDecodeStart.back());
+		std::vector<index_type> arrNext(m_arrDecodeStart.cbegin(), m_arrDecodeStart.cend() - 1);
+		for (index_type ndxEntry = 0; ndxEntry < array_type::size(); ++ndxEntry) {
+			forEachFirstSymbol(array_type::at(ndxEntry), [this, &arrNext, ndxEntry](index_type nSymbol)->void {
+				m_arrDecodeIndex[arrNext[nSymbol]++] = ndxEntry;
+			});
+		}
 	}
+
+	bool hasDecodeIndex() const { return !m_arrDecodeStart.empty(); }
+
+	// Indexes of the entries whose first symbol matches nFirstSymbol:
+	std::span<const index_type> decodeCandidates(symbol_type nFirstSymbol) const
+	{
+		assert(hasDecodeIndex());
+		const index_type nStart = m_arrDecodeStart[nFirstSymbol];
+		return std::span<const index_type>(m_arrDecodeIndex.data() + nStart, m_arrDecodeStart[nFirstSymbol+1] - nStart);
+	}
+
+private:
+	static_assert(sizeof(symbol_type) <= 2, "COpcodeTableArray decode index requires opcode symbols of no more than 16-bits");
+	static constexpr index_type NUM_FIRST_SYMBOLS = (1ul << (8*sizeof(symbol_type)));
+
+	// Calls fnMatch with each first symbol value the entry matches,
+	//	enumerating all combinations of the bits it doesn't mask:
+	template<typename TFunction>
+	static void forEachFirstSymbol(const COpcodeEntry<TDisassembler> &entry, const TFunction &fnMatch)
+	{
+		const index_type nMask = entry.opcodeMask().at(0) & (NUM_FIRST_SYMBOLS - 1);
+		const index_type nOpcode = entry.opcode().at(0) & (NUM_FIRST_SYMBOLS - 1);
+		if ((nOpcode & nMask) != nOpcode) return;		// Opcode bits outside of its mask can never match
+		const index_type nFree = ~nMask & (NUM_FIRST_SYMBOLS - 1);
+		index_type nBits = nFree;
+		while (true) {
+			fnMatch(nOpcode | nBits);
+			if (nBits == 0) break;
+			nBits = (nBits - 1) & nFree;
+		}
+	}
+
+	std::vector<index_type> m_arrDecodeStart;	// Offset into m_arrDecodeIndex of the candidates for each first symbol (plus one for the end of the last)
+	std::vector<index_type> m_arrDecodeIndex;	// Entry indexes for all first symbols
 };
 
 
@@ -210,11 +278,31 @@ public:
 //		there is only an "Add" function and no remove!
 //		It is also the users responsibility to not add duplicate or
 //		conflicting opcodes!
+//
+//		Like COpcodeTableArray, BuildDecodeIndex() should be called once
+//		the table is populated to build a flat index of the array for
+//		every possible first symbol, replacing the map search with a
+//		direct lookup in decodeCandidates().
 template<typename TDisassembler>
 class COpcodeTableMap : public std::map<typename TDisassembler::TOpcodeSymbol, COpcodeEntryArray<TDisassembler> >
 {
 	using map_type = std::map<typename TDisassembler::TOpcodeSymbol, COpcodeEntryArray<TDisassembler> >;
+	using symbol_type = typename TDisassembler::TOpcodeSymbol;
 public:
+	COpcodeTableMap() = default;
+	COpcodeTableMap(const COpcodeTableMap &other)
+		:	map_type(other)
+	{
+		if (other.hasDecodeIndex()) BuildDecodeIndex();		// Index points into the map, so it must be rebuilt rather than copied
+	}
+	COpcodeTableMap &operator=(const COpcodeTableMap &other)
+	{
+		map_type::operator=(other);
+		m_arrDecodeIndex.clear();
+		if (other.hasDecodeIndex()) BuildDecodeIndex();
+		return *this;
+	}
+
 	void AddOpcode(const COpcodeEntry<TDisassembler> & entry)
 	{
 		if (entry.opcode().empty() || entry.opcodeMask().empty()) {
@@ -231,10 +319,34 @@ public:
 			COpcodeEntryArray<TDisassembler> anArray;
 			anArray.push_back(entry);
 			map_type::insert({ entry.opcode().at(0) & entry.opcodeMask().at(0), anArray});
+			m_arrDecodeIndex.clear();		// Index must be rebuilt
 		} else {
 			itrArray->second.push_back(entry);
 		}
 	}
+
+	void BuildDecodeIndex()
+	{
+		m_arrDecodeIndex.assign(NUM_FIRST_SYMBOLS, nullptr);
+		for (auto const & itrArray : *this) {
+			m_arrDecodeIndex[itrArray.first] = &itrArray.second;
+		}
+	}
+
+	bool hasDecodeIndex() const { return !m_arrDecodeIndex.empty(); }
+
+	// Array of opcodes for nFirstSymbol or nullptr if there are none:
+	const COpcodeEntryArray<TDisassembler> *decodeCandidates(symbol_type nFirstSymbol) const
+	{
+		assert(hasDecodeIndex());
+		return m_arrDecodeIndex[nFirstSymbol];
+	}
+
+private:
+	static_assert(sizeof(symbol_type) <= 2, "COpcodeTableMap decode index requires opcode symbols of no more than 16-bits");
+	static constexpr std::size_t NUM_FIRST_SYMBOLS = (1ul << (8*sizeof(symbol_type)));
+
+	std::vector<const COpcodeEntryArray<TDisassembler> *> m_arrDecodeIndex;		// Array in the map for each first symbol
 };
 
 // ============================================================================
@@ -408,6 +520,7 @@ public:
 	virtual unsigned int GetVersionNumber() const;		// Base function returns GDC version is most-significant word.  Overrides should call this parent to get the GDC version and then set the least-significant word with the specific disassembler version.
 	virtual std::string GetGDCLongName() const = 0;		// Pure virtual.  Defines the long name for this disassembler
 	virtual std::string GetGDCShortName() const = 0;	// Pure virtual.  Defines the short name for this disassembler
+	virtual std::unique_ptr<CDisassembler> CreateDisassembler() const = 0;		// Pure virtual.  Creates a new independent disassembler of this same type (default settings)
 
 	virtual CStringArray GetMCUList() const;
 	virtual bool SetMCU(const std::string &strMCUName);
@@ -417,13 +530,15 @@ public:
 
 	virtual bool ReadControlFile(ifstreamControlFile& inFile, bool bLastFile = true, std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr, int nStartLineCount = 0);	// Read already open control file 'infile', outputs messages to 'msgFile' and errors to 'errFile', nStartLineCount = initial m_nCtrlLine value
 	virtual bool ReadSourceFile(const std::string & strFilename, TAddress nLoadAddress, const std::string & strDFCLibrary, std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr);	// Reads source file named strFilename using DFC strDFCLibrary
-	virtual bool Disassemble(std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr, std::ostream *outFile = nullptr);		// Disassembles entire loaded memory and outputs info to outFile if non-nullptr or opens and writes the file specified by m_sOutputFilename -- calls Pass1 and Pass2 to perform this processing
+	virtual bool Disassemble(std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr, std::ostream *outFile = nullptr, std::ostream *functionsFile = nullptr);		// Disassembles entire loaded memory and outputs info to outFile if non-nullptr or opens and writes the file specified by m_sOutputFilename -- calls Pass1 and Pass2 to perform this processing, and Pass3 if functionsFile is non-nullptr or there's a m_sFunctionsFilename
 
 	// --------------------------------
 
 	virtual bool deterministic() const { return m_bDeterministic; }
 	virtual void setDeterministic(bool bDeterministic) { m_bDeterministic = bDeterministic; }
 
+	virtual std::string functionsFilename() const { return m_sFunctionsFilename; }	// Functions output filename (if any) from the control file
+
 	virtual bool flagAddr() const { return m_bAddrFlag; }
 	virtual void setFlagAddr(bool bFlag) { m_bAddrFlag = bFlag; }
 
@@ -481,7 +596,7 @@ protected:
 
 	virtual bool Pass1(std::ostream& outFile, std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr);	// Performs Pass1 which finds code and data -- i.e. calls Scan functions
 	virtual bool Pass2(std::ostream& outFile, std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr);	// Performs Pass2 which is the actual disassemble stage
-	virtual bool Pass3(std::ostream& outFile, std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr);	// Performs Pass3 which creates the function output file
+	virtual bool Pass3(std::ostream& outFile, std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr, std::ostream *functionsFile = nullptr);	// Performs Pass3 which creates the function output in functionsFile if non-nullptr or opens and writes the file specified by m_sFunctionsFilename
 
 	virtual bool FindCode(std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr);		// Iterates through memory using m_PC finding and marking code.  It should add branches and labels as necessary and return when it hits an end-of-code or runs into other code found
 	virtual bool ReadNextObj(MEMORY_TYPE nMemoryType, bool bTagMemory, std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr) = 0;	// Pure Virtual as it's depenent on processor.  Procedure to read next object code from memory.  The memory type is flagged as code (or illegal code).  Returns True if current code legal, else False.  OpMemory = object code from memory.  CurrentOpcode = Copy of COpcodeEntry for the opcode located.  PC is automatically advanced.
@@ -572,6 +687,16 @@ public:
 	virtual bool AddSymbol(MEMORY_TYPE nMemoryType, TAddress nAddress, const TLabel &strLabel);
 	virtual bool AddObjectMapping(MEMORY_TYPE nMemoryType, TAddress nBaseObjectAddress, TSize nSize);
 
+	// Demangling:
+	//		The ELF symbols are kept mangled in m_SymbolTable and only get
+	//		demangled when something using them is output or referenced.  The
+	//		results are memoised by mangled name, so each is only demangled
+	//		once.  If bVerbose, the parameters and types are demangled too, falling back
+	//		to no options if that fails.  Returns empty if the symbol isn't
+	//		mangled or if built without LIBIBERTY_SUPPORT:
+	TLabel DemangleSymbol(const TLabel &strMangled, bool bVerbose = true) const;
+	void DemangleSymbols(const std::vector<TLabel> &arrMangled, bool bVerbose = true) const;	// Fills the cache for all of arrMangled at once, in ranges across the hardware threads, for callers needing many of them up front
+
 protected:
 	virtual void GenDataLabel(MEMORY_TYPE nMemoryType, TAddress nAddress, TAddress nRefAddress, const TLabel & strLabel = TLabel(), std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr);	// Calls AddLabel to create a label for nAddress -- unlike calling direct, this function outputs the new label to msgFile if specified...
 	virtual void GenAddrLabel(TAddress nAddress, TAddress nRefAddress, const TLabel & strLabel = TLabel(), std::ostream *msgFile = nullptr, std::ostream *errFile = nullptr);	// (Always MT_ROM) Calls AddLabel to create a label for nAddress, then calls AddBranch to add a branch address -- unlike calling direct, this function outputs the new label to msgFile if specified and displays "out of source" errors for the branches to errFile...
@@ -650,6 +775,8 @@ protected:
 
 	CAddressSet m_FuncExitAddresses;	// (Always MT_ROM) Table of address that are equivalent to function exit like RTS or RTI.  Any JMP or BRA or execution into one of these addresses will equate to a function exit
 	CAddressTableMap m_BranchTable;		// (Always MT_ROM) Table mapping branch addresses encountered with the address that referenced it in disassembly.
+	CAddressSet m_PendingEntries;		// (Always MT_ROM) Entries added to m_EntryTable that ScanEntries hasn't yet followed
+	CAddressSet m_PendingBranches;		// (Always MT_ROM) Branches added to m_BranchTable that ScanBranches hasn't yet followed
 	CLabelTableMap m_LabelTable[NUM_MEMORY_TYPES];		// Table of labels both specified by the user and from disassembly.  Entry is pointer to array of labels.  An empty entry equates back to Lxxxx.  First entry is default for "Get" function.
 	CCommentTableMap m_CommentTable[NUM_MEMORY_TYPES];	// Table of comments by address
 
@@ -664,6 +791,9 @@ protected:
 
 	TAddress		m_PC;				// Program counter
 
+	class CDemangleCache;
+	std::unique_ptr<CDemangleCache> m_pDemangleCache;	// See DemangleSymbol()
+
 	CMemBlocks		m_Memory[NUM_MEMORY_TYPES];			// Memory object for the processor.
 	CMemRanges		m_MemoryRanges[NUM_MEMORY_TYPES];	// ROM, RAM, I/O Ranges/Mapping
 
@@ -8,10 +8,19 @@
 #include <iostream>
 #include <sstream>
 #include <iomanip>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <string>
+#include <utility>
 
 #include "gdc.h"
 #include "dfc.h"
 #include "stringhelp.h"
+#include "threadhelp.h"
+#include "capturedoutput.h"
+#include "perfstats.h"
 
 #include <dfc/binary/binarydfc.h>
 #include <dfc/intel/inteldfc.h>
@@ -43,6 +52,57 @@ static std::string formatDisassemblerVersion(unsigned int nVersion)
 	return ssTemp.str();
 }
 
+// ============================================================================
+
+// Disassembles each control file independently with its own disassembler
+//	(rather than combining them into one disassembly), running them on up
+//	to nThreadCount threads.  The output of each is captured and written
+//	to std::cout/std::cerr in the order of the control files as soon as it
+//	and all of those before it are done, so the output is the same
+//	regardless of the number of threads:
+static int disassembleParallel(const CDisassembler &aPrototype, const CStringArray &arrControlFiles,
+								bool bDeterministic, unsigned int nThreadCount)
+{
+	std::vector< std::unique_ptr<CCapturedOutput> > arrOutputs;
+	for (CStringArray::size_type ndx = 0; ndx < arrControlFiles.size(); ++ndx) {
+		arrOutputs.push_back(std::make_unique<CCapturedOutput>());
+	}
+	std::vector<bool> arrDone(arrControlFiles.size(), false);
+	CStringArray::size_type nNextOutput = 0;		// Next control file whose output hasn't been written
+	std::mutex mtxOutput;
+	bool bOpenError = false;
+
+	runParallelThreads(arrControlFiles.size(), nThreadCount, [&](std::size_t ndx)->void {
+		CCapturedOutput &output = *arrOutputs.at(ndx);
+		bool bOpened = true;
+
+		ifstreamControlFile CtrlFile(arrControlFiles.at(ndx));
+		if (!CtrlFile.is_open()) {
+			output.errFile() << "*** Error: Opening control file \"" << arrControlFiles.at(ndx) << "\" for reading..." << std::endl;
+			bOpened = false;
+		} else {
+			std::unique_ptr<CDisassembler> pDisassembler = aPrototype.CreateDisassembler();
+			pDisassembler->setDeterministic(bDeterministic);
+			bool bOkFlag = pDisassembler->ReadControlFile(CtrlFile, true, &output.msgFile(), &output.errFile());
+			CtrlFile.close();
+			if (bOkFlag) pDisassembler->Disassemble(&output.msgFile(), &output.errFile());
+		}
+
+		std::lock_guard<std::mutex> lock(mtxOutput);
+		if (!bOpened) bOpenError = true;
+		arrDone[ndx] = true;
+		while ((nNextOutput < arrOutputs.size()) && arrDone[nNextOutput]) {
+			arrOutputs.at(nNextOutput)->replay(std::cout, std::cerr);
+			arrOutputs.at(nNextOutput).reset();			// Done with it
+			++nNextOutput;
+		}
+	}, "Parallel Disassembly");
+
+	return (bOpenError ? -2 : 0);
+}
+
+// ============================================================================
+
 int main(int argc, char *argv[])
 {
 	// Data File Converters:
@@ -69,6 +129,9 @@ int main(int argc, char *argv[])
 	CStringArray arrControlFiles;
 	bool bNeedDisassembler = true;
 	bool bNeedUsage = false;
+	unsigned int nParallelThreads = 0;		// Non-zero for independent parallel disassembly of each control file
+	bool bStats = false;
+	std::string strStatsFilename;			// JSON statistics output, if any
 
 	for (int ndx = 1; ndx < argc; ++ndx) {
 		std::string strArg = argv[ndx];
@@ -81,6 +144,17 @@ int main(int argc, char *argv[])
 			}
 		} else if (strArg == "--deterministic") {
 			bDeterministic = true;
+		} else if (strArg == "--parallel") {
+			nParallelThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		} else if (starts_with(strArg, "--parallel=")) {
+			nParallelThreads = strtoul(strArg.substr(11).c_str(), nullptr, 10);
+			if (nParallelThreads == 0) bNeedUsage = true;
+		} else if (strArg == "--stats") {
+			bStats = true;
+		} else if (starts_with(strArg, "--stats=")) {
+			bStats = true;
+			strStatsFilename = strArg.substr(8);
+			if (strStatsFilename.empty()) bNeedUsage = true;
 		} else {
 			bNeedUsage = true;
 		}
@@ -96,11 +170,21 @@ int main(int argc, char *argv[])
 	}
 	std::cout << std::endl;
 	if (bNeedUsage) {
-		std::cout << "Usage: gendasm [--deterministic] <disassembler> <ctrl-filename1> [<ctrl-filename2> <ctrl-filename3> ...]" << std::endl;
+		std::cout << "Usage: gendasm [--deterministic] [--parallel[=<n>]] [--stats[=<json-fn>]] <disassembler> <ctrl-filename1> [<ctrl-filename2> <ctrl-filename3> ...]" << std::endl;
 		std::cout << std::endl;
 		std::cout <<"The following switches can be specified but are optional:\n"
 					"    --deterministic  Skip output like dates and version numbers so that the\n"
-					"                     output can be compared with other content for tests.\n\n";
+					"                     output can be compared with other content for tests.\n"
+					"    --parallel[=<n>] Disassemble each control file independently, as if\n"
+					"                     gendasm was run separately for each, running up to <n>\n"
+					"                     at a time (default is the number of hardware threads).\n"
+					"                     Their output is written in control file order.\n"
+					"                     Without this, all control files are combined into a\n"
+					"                     single disassembly.\n"
+					"    --stats[=<json-fn>]\n"
+					"                     Output performance statistics, which are the time of\n"
+					"                     each phase and the counts of what was done, to stderr\n"
+					"                     when complete, and also as JSON to <json-fn> if given.\n\n";
 		std::cout << "Valid <disassembler> types:" << std::endl;
 		for (auto const & itrDisassemblers : disassemblers) {
 			CStringArray arrMCUs = itrDisassemblers->GetMCUList();
@@ -129,9 +213,16 @@ int main(int argc, char *argv[])
 		return -1;
 	}
 
+	if (bStats) CPerfStats::enable();
+	CPerfStats::CReport statsReport("gendasm", strStatsFilename);
+
 	std::cout << "Using: " << pDisassembler->GetGDCLongName() << std::endl;
 	std::cout << std::endl;
 
+	if (nParallelThreads) {
+		return disassembleParallel(*pDisassembler, arrControlFiles, bDeterministic, nParallelThreads);
+	}
+
 	pDisassembler->setDeterministic(bDeterministic);
 
 	bool bOkFlag = true;
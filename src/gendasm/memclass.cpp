@@ -26,6 +26,8 @@
 
 #include <algorithm>
 #include <iterator>
+#include <limits>
+#include <bit>
 #include <assert.h>
 
 // ============================================================================
@@ -268,6 +270,50 @@ TAddress CMemRanges::highestAddress() const
 // ============================================================================
 
 
+std::size_t CMemBlock::findDescCode(TDescElement nValue) const
+{
+	return std::distance(m_arrDescValues.cbegin(), std::find(m_arrDescValues.cbegin(), m_arrDescValues.cend(), nValue));
+}
+
+uint64_t CMemBlock::matchDescWord(std::size_t ndxWord, std::size_t nCode) const
+{
+	uint64_t nMatch = ~uint64_t(0);
+	for (std::size_t ndxPlane = 0; ndxPlane < m_arrDescPlanes.size(); ++ndxPlane) {
+		const uint64_t nWord = m_arrDescPlanes[ndxPlane][ndxWord];
+		nMatch &= ((nCode & (std::size_t(1) << ndxPlane)) ? nWord : ~nWord);
+	}
+	return nMatch;
+}
+
+TSize CMemBlock::findDescriptor(TAddress nLogicalAddr, TSize nSize, TDescElement nValue, bool bMatch) const
+{
+	if ((nLogicalAddr < m_nLogicalAddr) || (nSize == 0)) return nSize;
+	const TSize ndxStart = (nLogicalAddr - m_nLogicalAddr);
+	if (ndxStart >= m_arrMemoryData.size()) return nSize;
+	const TSize ndxEnd = ndxStart + std::min(nSize, m_arrMemoryData.size() - ndxStart);
+
+	// Without descriptors, everything is 0, same as descriptor() returns:
+	if (!m_bUseDescriptors) return (((nValue == 0) == bMatch) ? 0 : nSize);
+
+	// If it's a value that's never been set in this block, then either
+	//	nothing matches or everything does:
+	const std::size_t nCode = findDescCode(nValue);
+	if (nCode == m_arrDescValues.size()) return (bMatch ? nSize : 0);
+
+	for (std::size_t ndxWord = ndxStart / 64; ndxWord <= (ndxEnd - 1) / 64; ++ndxWord) {
+		uint64_t nFound = matchDescWord(ndxWord, nCode);
+		if (!bMatch) nFound = ~nFound;
+		if (ndxWord == (ndxStart / 64)) nFound &= (~uint64_t(0) << (ndxStart % 64));
+		if ((ndxWord == ((ndxEnd - 1) / 64)) && (ndxEnd % 64)) nFound &= ~(~uint64_t(0) << (ndxEnd % 64));
+		if (nFound) return (ndxWord * 64) + std::countr_zero(nFound) - ndxStart;
+	}
+	return nSize;
+}
+
+
+// ============================================================================
+
+
 void CMemBlocks::initFromRanges(const CMemRanges &ranges, TAddressOffset nPhysicalAddrOffset,
 					bool bUseDescriptors, TMemoryElement nFillValue, TDescElement nDescValue)
 {
@@ -283,6 +329,80 @@ void CMemBlocks::initFromRanges(const CMemRanges &ranges, TAddressOffset nPhysic
 		push_back(CMemBlock(itr->startAddr(), itr->startAddr() + nPhysicalAddrOffset, bUseDescriptors,
 							itr->size(), nFillValue, nDescValue));
 	}
+	reindex();
+}
+
+void CMemBlocks::addBlock(const CMemBlock &aBlock)
+{
+	push_back(aBlock);
+	reindex();
+}
+
+//	reindex
+//		Builds the sorted interval index.  Every block boundary splits
+//		the address space into elementary intervals, each of which is
+//		owned by the first block containing it, same as walking the
+//		blocks in order would find.  Adjacent intervals of the same
+//		block are then merged so that each block typically has exactly
+//		one interval (unless it's partially hidden by earlier ones).
+void CMemBlocks::reindex()
+{
+	std::vector<uint64_t> arrBoundaries;
+	arrBoundaries.reserve(size() * 2);
+	for (auto const & itr : *this) {
+		if (itr.size() == 0) continue;
+		arrBoundaries.push_back(itr.logicalAddr());
+		arrBoundaries.push_back(static_cast<uint64_t>(itr.logicalAddr()) + itr.size());
+	}
+	std::sort(arrBoundaries.begin(), arrBoundaries.end());
+	arrBoundaries.erase(std::unique(arrBoundaries.begin(), arrBoundaries.end()), arrBoundaries.end());
+
+	m_arrIntervals.clear();
+	for (std::size_t ndx = 1; ndx < arrBoundaries.size(); ++ndx) {
+		const TAddress nStartAddr = static_cast<TAddress>(arrBoundaries.at(ndx-1));
+		for (size_type nBlock = 0; nBlock < size(); ++nBlock) {
+			if (!at(nBlock).containsAddress(nStartAddr)) continue;
+			if (!m_arrIntervals.empty() && (m_arrIntervals.back().m_nBlock == nBlock) &&
+				(m_arrIntervals.back().m_nEndAddr == nStartAddr)) {
+				m_arrIntervals.back().m_nEndAddr = arrBoundaries.at(ndx);
+			} else {
+				m_arrIntervals.push_back({ nStartAddr, arrBoundaries.at(ndx), nBlock });
+			}
+			break;
+		}
+	}
+	m_nIndexedBlocks = size();
+}
+
+const CMemBlocks::CBlockInterval *CMemBlocks::findInterval(TAddress nLogicalAddr) const
+{
+	assert(isIndexed());
+	// Find the last interval starting at or before the address:
+	auto itrInterval = std::upper_bound(m_arrIntervals.cbegin(), m_arrIntervals.cend(), nLogicalAddr,
+										[](TAddress nAddr, const CBlockInterval &anInterval)->bool { return (nAddr < anInterval.m_nStartAddr); });
+	if (itrInterval == m_arrIntervals.cbegin()) return nullptr;
+	--itrInterval;
+	if (nLogicalAddr >= itrInterval->m_nEndAddr) return nullptr;
+	return &(*itrInterval);
+}
+
+const CMemBlock *CMemBlocks::findBlock(TAddress nLogicalAddr) const
+{
+	if (isIndexed()) {
+		const CBlockInterval *pInterval = findInterval(nLogicalAddr);
+		return (pInterval ? &at(pInterval->m_nBlock) : nullptr);
+	}
+	for (auto const & itr : *this) {
+		if (itr.containsAddress(nLogicalAddr)) return &itr;
+	}
+	return nullptr;
+}
+
+CMemBlock *CMemBlocks::findBlock(TAddress nLogicalAddr)
+{
+	if (!isIndexed()) reindex();
+	const CBlockInterval *pInterval = findInterval(nLogicalAddr);
+	return (pInterval ? &at(pInterval->m_nBlock) : nullptr);
 }
 
 CMemRanges CMemBlocks::ranges() const
@@ -298,34 +418,73 @@ CMemRanges CMemBlocks::ranges() const
 
 TMemoryElement CMemBlocks::element(TAddress nLogicalAddr) const
 {
-	for (auto const & itr : *this) {
-		if (itr.containsAddress(nLogicalAddr)) return itr.element(nLogicalAddr);
-	}
-	return 0;
+	const CMemBlock *pBlock = findBlock(nLogicalAddr);
+	return (pBlock ? pBlock->element(nLogicalAddr) : 0);
 }
 
 bool CMemBlocks::setElement(TAddress nLogicalAddr, TMemoryElement nValue)
 {
-	for (auto & itr : *this) {
-		if (itr.containsAddress(nLogicalAddr)) return itr.setElement(nLogicalAddr, nValue);
-	}
-	return false;
+	CMemBlock *pBlock = findBlock(nLogicalAddr);
+	return (pBlock ? pBlock->setElement(nLogicalAddr, nValue) : false);
 }
 
 TDescElement CMemBlocks::descriptor(TAddress nLogicalAddr) const
 {
-	for (auto const & itr : *this) {
-		if (itr.containsAddress(nLogicalAddr)) return itr.descriptor(nLogicalAddr);
-	}
-	return 0;
+	const CMemBlock *pBlock = findBlock(nLogicalAddr);
+	return (pBlock ? pBlock->descriptor(nLogicalAddr) : 0);
 }
 
 bool CMemBlocks::setDescriptor(TAddress nLogicalAddr, TDescElement nValue)
 {
-	for (auto & itr : *this) {
-		if (itr.containsAddress(nLogicalAddr)) return itr.setDescriptor(nLogicalAddr, nValue);
+	CMemBlock *pBlock = findBlock(nLogicalAddr);
+	return (pBlock ? pBlock->setDescriptor(nLogicalAddr, nValue) : false);
+}
+
+std::span<const TMemoryElement> CMemBlocks::elements(TAddress nLogicalAddr, TSize nSize) const
+{
+	if (isIndexed()) {
+		// The range must be entirely within an interval, otherwise part
+		//	of it would either be outside of memory or in another block:
+		const CBlockInterval *pInterval = findInterval(nLogicalAddr);
+		if ((pInterval == nullptr) || ((static_cast<uint64_t>(nLogicalAddr) + nSize) > pInterval->m_nEndAddr)) return std::span<const TMemoryElement>();
+		return at(pInterval->m_nBlock).elements(nLogicalAddr, nSize);
 	}
-	return false;
+	const CMemBlock *pBlock = findBlock(nLogicalAddr);
+	return (pBlock ? pBlock->elements(nLogicalAddr, nSize) : std::span<const TMemoryElement>());
+}
+
+TSize CMemBlocks::findDescriptor(TAddress nLogicalAddr, TSize nSize, TDescElement nValue, bool bMatch) const
+{
+	const uint64_t nEndAddr = std::min<uint64_t>(static_cast<uint64_t>(nLogicalAddr) + nSize, uint64_t(std::numeric_limits<TAddress>::max()) + 1);
+
+	if (!isIndexed()) {
+		for (uint64_t nAddr = nLogicalAddr; nAddr < nEndAddr; ++nAddr) {
+			if ((descriptor(static_cast<TAddress>(nAddr)) == nValue) == bMatch) return (nAddr - nLogicalAddr);
+		}
+		return nSize;
+	}
+
+	// Walk the intervals from the one containing the address, letting
+	//	each block search its part, and checking the gaps in between:
+	const bool bGapsMatch = ((nValue == 0) == bMatch);
+	auto itrInterval = std::upper_bound(m_arrIntervals.cbegin(), m_arrIntervals.cend(), nLogicalAddr,
+										[](TAddress nAddr, const CBlockInterval &anInterval)->bool { return (nAddr < anInterval.m_nStartAddr); });
+	if ((itrInterval != m_arrIntervals.cbegin()) && (nLogicalAddr < std::prev(itrInterval)->m_nEndAddr)) --itrInterval;
+	uint64_t nAddr = nLogicalAddr;
+	while (nAddr < nEndAddr) {
+		if ((itrInterval == m_arrIntervals.cend()) || (nAddr < itrInterval->m_nStartAddr)) {
+			if (bGapsMatch) return (nAddr - nLogicalAddr);
+			if (itrInterval == m_arrIntervals.cend()) break;
+			nAddr = itrInterval->m_nStartAddr;
+			continue;
+		}
+		const TSize nIntervalSize = std::min(nEndAddr, itrInterval->m_nEndAddr) - nAddr;
+		const TSize nFound = at(itrInterval->m_nBlock).findDescriptor(static_cast<TAddress>(nAddr), nIntervalSize, nValue, bMatch);
+		if (nFound < nIntervalSize) return (nAddr + nFound - nLogicalAddr);
+		nAddr += nIntervalSize;
+		++itrInterval;
+	}
+	return nSize;
 }
 
 TSize CMemBlocks::totalMemorySize() const
@@ -358,10 +517,7 @@ TAddress CMemBlocks::highestLogicalAddress() const
 
 bool CMemBlocks::containsAddress(TAddress nLogicalAddr) const
 {
-	for (auto const & itr : *this) {
-		if (itr.containsAddress(nLogicalAddr)) return true;
-	}
-	return false;
+	return (findBlock(nLogicalAddr) != nullptr);
 }
 
 void CMemBlocks::clearMemory(TMemoryElement nFillByte)
@@ -380,10 +536,8 @@ void CMemBlocks::clearDescriptors(TDescElement nDescValue)
 
 TAddress CMemBlocks::physicalAddr(TAddress nLogicalAddr) const
 {
-	for (auto const & itr : *this) {
-		if (itr.containsAddress(nLogicalAddr)) return itr.physicalAddr(nLogicalAddr);
-	}
-	return 0;
+	const CMemBlock *pBlock = findBlock(nLogicalAddr);
+	return (pBlock ? pBlock->physicalAddr(nLogicalAddr) : 0);
 }
 
 
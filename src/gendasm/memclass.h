@@ -14,6 +14,8 @@
 #include <stdint.h>
 #include <cstddef>
 #include <vector>
+#include <span>
+#include <bit>
 
 // ============================================================================
 
@@ -25,7 +27,7 @@ typedef unsigned int TUserData;								// UserData type (arbitrary type)
 typedef uint8_t TMemoryElement;								// Basic Memory Element type (should be numeric)
 typedef std::vector<TMemoryElement> CMemoryArray;
 typedef uint32_t TDescElement;								// Memory Descriptor Element type (must be mappable to MEM_DESC enum in the CDisassembler object)
-typedef std::vector<TDescElement> CDescArray;
+typedef std::vector<uint64_t> CDescPlane;					// One bit of the descriptor code of each address, 64 addresses per word (see CMemBlock)
 
 // ============================================================================
 
@@ -108,7 +110,18 @@ protected:
 	// ----
 	bool m_bUseDescriptors;
 	CMemoryArray m_arrMemoryData;
-	CDescArray m_arrMemoryDescriptors;
+	// Descriptors:
+	//		Rather than a full TDescElement for every address, each distinct
+	//		descriptor value used in the block gets a code, its index in
+	//		m_arrDescValues, and the codes are stored bit-sliced.  Each plane
+	//		holds one bit of the code of every address, 64 addresses to a
+	//		word, and there are only as many planes as the number of codes
+	//		needs, which is at most four for the disassembler's MEM_DESC values, and
+	//		none until something is set to other than the initial value.
+	//		Testing 64 addresses for a value is then just a few word
+	//		operations, so findDescriptor() skips through a word at a time:
+	std::vector<TDescElement> m_arrDescValues;		// Descriptor value of each code, code 0 is the initial value
+	std::vector<CDescPlane> m_arrDescPlanes;		// Bit planes of the codes, bit 0 first
 
 public:
 	CMemBlock(TAddress nLogicalAddr, TAddress nPhysicalAddr, bool bUseDescriptors,
@@ -118,7 +131,7 @@ public:
 			m_bUseDescriptors(bUseDescriptors)
 	{
 		m_arrMemoryData.resize(nSize, nFillValue);
-		m_arrMemoryDescriptors.resize(nSize, nDescValue);
+		m_arrDescValues.push_back(nDescValue);
 	}
 
 	inline TAddress logicalAddr() const { return m_nLogicalAddr; }
@@ -136,6 +149,13 @@ public:
 		if ((nLogicalAddr - m_nLogicalAddr) >= m_arrMemoryData.size()) return false;
 		return true;
 	}
+	inline bool containsRange(TAddress nLogicalAddr, TSize nSize) const
+	{
+		if (nLogicalAddr < m_nLogicalAddr) return false;
+		CMemoryArray::size_type nIndex = (nLogicalAddr - m_nLogicalAddr);
+		if (nIndex > m_arrMemoryData.size()) return false;
+		return (nSize <= (m_arrMemoryData.size() - nIndex));
+	}
 	// ----
 	inline bool useDescriptors() const { return m_bUseDescriptors; }
 	// ----
@@ -148,7 +168,8 @@ public:
 	void clearDescriptors(TDescElement nDescValue)
 	{
 		if (!m_bUseDescriptors) return;
-		m_arrMemoryDescriptors.resize(m_arrMemoryDescriptors.size(), nDescValue);
+		m_arrDescValues.assign(1, nDescValue);
+		m_arrDescPlanes.clear();
 	}
 	// ----
 	TMemoryElement element(TAddress nLogicalAddr) const
@@ -171,28 +192,81 @@ public:
 	{
 		if (!m_bUseDescriptors) return 0;
 		if (nLogicalAddr < m_nLogicalAddr) return 0;
-		CDescArray::size_type nIndex = (nLogicalAddr - m_nLogicalAddr);
-		if (nIndex >= m_arrMemoryDescriptors.size()) return 0;
-		return m_arrMemoryDescriptors.at(nIndex);
+		CMemoryArray::size_type nIndex = (nLogicalAddr - m_nLogicalAddr);
+		if (nIndex >= m_arrMemoryData.size()) return 0;
+		std::size_t nCode = 0;
+		for (std::size_t ndxPlane = 0; ndxPlane < m_arrDescPlanes.size(); ++ndxPlane) {
+			nCode |= ((m_arrDescPlanes[ndxPlane][nIndex / 64] >> (nIndex % 64)) & 1) << ndxPlane;
+		}
+		return m_arrDescValues[nCode];
 	}
 	bool setDescriptor(TAddress nLogicalAddr, TDescElement nValue)
 	{
 		if (!m_bUseDescriptors) return false;
 		if (nLogicalAddr < m_nLogicalAddr) return false;
-		CDescArray::size_type nIndex = (nLogicalAddr - m_nLogicalAddr);
-		if (nIndex >= m_arrMemoryDescriptors.size()) return false;
-		m_arrMemoryDescriptors[nIndex] = nValue;
+		CMemoryArray::size_type nIndex = (nLogicalAddr - m_nLogicalAddr);
+		if (nIndex >= m_arrMemoryData.size()) return false;
+		const std::size_t nCode = addDescCode(nValue);
+		const uint64_t nBit = (uint64_t(1) << (nIndex % 64));
+		for (std::size_t ndxPlane = 0; ndxPlane < m_arrDescPlanes.size(); ++ndxPlane) {
+			uint64_t &nWord = m_arrDescPlanes[ndxPlane][nIndex / 64];
+			if (nCode & (std::size_t(1) << ndxPlane)) {
+				nWord |= nBit;
+			} else {
+				nWord &= ~nBit;
+			}
+		}
 		return true;
 	}
+	// Returns the offset from nLogicalAddr of the first of the nSize addresses
+	//	whose descriptor is nValue, or if not bMatch, isn't nValue.  Only the
+	//	part of the range in this block is searched.  Returns nSize if none:
+	TSize findDescriptor(TAddress nLogicalAddr, TSize nSize, TDescElement nValue, bool bMatch = true) const;
+	// ----
+	// Contiguous view of a range of memory, empty if the block
+	//	doesn't contain the whole range:
+	std::span<const TMemoryElement> elements(TAddress nLogicalAddr, TSize nSize) const
+	{
+		if (!containsRange(nLogicalAddr, nSize)) return std::span<const TMemoryElement>();
+		return std::span<const TMemoryElement>(m_arrMemoryData.data() + (nLogicalAddr - m_nLogicalAddr), nSize);
+	}
+
+protected:
+	std::size_t findDescCode(TDescElement nValue) const;	// Returns m_arrDescValues.size() if nValue isn't used in this block
+	std::size_t addDescCode(TDescElement nValue)			// Same as findDescCode(), but adds a code (and plane if needed) for new values
+	{
+		std::size_t nCode = findDescCode(nValue);
+		if (nCode == m_arrDescValues.size()) {
+			m_arrDescValues.push_back(nValue);
+			while (m_arrDescPlanes.size() < static_cast<std::size_t>(std::bit_width(nCode))) {
+				m_arrDescPlanes.emplace_back((m_arrMemoryData.size() + 63) / 64, 0);		// New planes are zero so existing codes are unchanged
+			}
+		}
+		return nCode;
+	}
+	uint64_t matchDescWord(std::size_t ndxWord, std::size_t nCode) const;	// Bits set for each of the 64 addresses of the word with that code
 };
 
 // ----------------------------------------------------------------------------
 
+//	CMemBlocks
+//		Memory is a collection of blocks, where an address belongs to the
+//		first block (in order) that contains it.  To find that block
+//		without walking every block, an index of the non-overlapping
+//		address intervals owned by each block is kept, sorted by address,
+//		for a binary search.  The index is rebuilt whenever blocks are
+//		added through initFromRanges() or addBlock().  If blocks are
+//		added to the underlying vector directly, the index is only
+//		rebuilt by the next modifying call (setElement, setDescriptor,
+//		or reindex) and until then the lookups fall back to walking
+//		the blocks.
 class CMemBlocks : public std::vector<CMemBlock>
 {
 public:
 	void initFromRanges(const CMemRanges &ranges, TAddressOffset nPhysicalAddrOffset,		// Note: ranges will be the logical addresses
 						bool bUseDescriptors, TMemoryElement nFillValue, TDescElement nDescValue = 0);
+	void addBlock(const CMemBlock &aBlock);
+	void reindex();			// Rebuilds the address index after blocks are added directly
 
 	CMemRanges ranges() const;
 
@@ -202,6 +276,15 @@ public:
 	TDescElement descriptor(TAddress nLogicalAddr) const;
 	bool setDescriptor(TAddress nLogicalAddr, TDescElement nValue);
 	// ----
+	// Same as CMemBlock::findDescriptor(), but across all of the blocks,
+	//	with addresses not in any block having a descriptor of 0, the
+	//	same as descriptor() returns for them:
+	TSize findDescriptor(TAddress nLogicalAddr, TSize nSize, TDescElement nValue, bool bMatch = true) const;
+	// ----
+	// Contiguous view of a range of memory, empty if the entire range
+	//	isn't within a single block:
+	std::span<const TMemoryElement> elements(TAddress nLogicalAddr, TSize nSize) const;
+	// ----
 	TSize totalMemorySize() const;
 	TAddress lowestLogicalAddress() const;		// Returns 0 if there's no memory defined
 	TAddress highestLogicalAddress() const;		// Returns 0 if there's no memory defined
@@ -211,6 +294,22 @@ public:
 	void clearDescriptors(TDescElement nDescValue);
 	// ----
 	TAddress physicalAddr(TAddress nLogicalAddr) const;
+
+protected:
+	struct CBlockInterval {
+		TAddress m_nStartAddr;			// First logical address of interval
+		uint64_t m_nEndAddr;			// One past last logical address of interval (64-bit so a block can end at the top of the address space)
+		size_type m_nBlock;				// Index of the block owning the interval
+	};
+
+	bool isIndexed() const { return (m_nIndexedBlocks == size()); }
+	const CBlockInterval *findInterval(TAddress nLogicalAddr) const;		// Index must be valid, returns nullptr if address isn't in any block
+	const CMemBlock *findBlock(TAddress nLogicalAddr) const;
+	CMemBlock *findBlock(TAddress nLogicalAddr);
+
+private:
+	std::vector<CBlockInterval> m_arrIntervals;		// Sorted, non-overlapping intervals of addresses owned by each block
+	size_type m_nIndexedBlocks = 0;					// Number of blocks m_arrIntervals was built from
 };
 
 // ============================================================================
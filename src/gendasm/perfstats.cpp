@@ -0,0 +1,487 @@
+//
+//	Performance Statistics
+//
+//
+//	Generic Code-Seeking Disassembler
+//	Copyright(c)2021 by Donna Whisnant
+//
+
+#include "perfstats.h"
+
+#include <iomanip>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+#include <assert.h>
+
+// ============================================================================
+
+std::atomic<bool> CPerfStats::g_bEnabled = false;
+std::atomic<uint64_t> CPerfStats::g_arrCounters[PC_COUNT] = {};
+
+namespace {
+	const char *g_arrCounterNames[PC_COUNT] = {		// Indexed by PERF_COUNTER
+		"opcodes_decoded",
+		"entries_followed",
+		"branches_followed",
+		"compare_calls",
+		"compare_cells",
+		"diff_calls",
+		"allocations",
+		"allocated_bytes",
+	};
+
+	const char *g_arrCounterDescriptions[PC_COUNT] = {
+		"Opcodes Decoded",
+		"Entries Followed",
+		"Branches Followed",
+		"CompareFunctions Calls",
+		"CompareFunctions Cells (M*N)",
+		"DiffFunctions Calls",
+		"Allocations",
+		"Allocated Bytes",
+	};
+
+	struct TPhaseStats {
+		const char *m_pszName = nullptr;
+		uint64_t m_nCount = 0;
+		double m_nWallSeconds = 0.0;
+		double m_nCPUSeconds = 0.0;
+		uint64_t m_nAllocatedBytes = 0;
+	};
+
+	struct TThreadPoolStats {
+		const char *m_pszName = nullptr;
+		uint64_t m_nRuns = 0;
+		double m_nWallSeconds = 0.0;
+		std::vector<CPerfStats::TThreadUsage> m_arrThreads;
+	};
+
+	// Recorded statistics, other than the counters, which are kept in
+	//	order of first use:
+	struct TStats {
+		std::mutex m_mtxStats;
+		std::chrono::steady_clock::time_point m_tWallStart;
+		std::clock_t m_tCPUStart = 0;
+		std::vector<TPhaseStats> m_arrPhases;
+		std::vector<TThreadPoolStats> m_arrThreadPools;
+		std::atomic<uint64_t> m_arrCompareCells[CPerfStats::COMPARE_CELL_BUCKETS] = {};
+	};
+
+	TStats &stats()
+	{
+		static TStats g_stats;
+		return g_stats;
+	}
+
+	double seconds(std::chrono::steady_clock::duration tDuration)
+	{
+		return std::chrono::duration<double>(tDuration).count();
+	}
+
+	double cpuSeconds(std::clock_t tStart, std::clock_t tEnd)
+	{
+		return static_cast<double>(tEnd - tStart) / CLOCKS_PER_SEC;
+	}
+
+	std::string jsonString(const std::string &strText)
+	{
+		std::string strRetVal = "\"";
+		for (auto const & ch : strText) {
+			if ((ch == '"') || (ch == '\\')) {
+				strRetVal.push_back('\\');
+				strRetVal.push_back(ch);
+			} else if (static_cast<unsigned char>(ch) < 0x20) {
+				char arrTemp[8];
+				std::snprintf(arrTemp, sizeof(arrTemp), "\\u%04x", static_cast<unsigned int>(ch));
+				strRetVal += arrTemp;
+			} else {
+				strRetVal.push_back(ch);
+			}
+		}
+		strRetVal.push_back('"');
+		return strRetVal;
+	}
+}
+
+// ============================================================================
+
+void CPerfStats::enable()
+{
+	TStats &aStats = stats();
+	std::lock_guard<std::mutex> lock(aStats.m_mtxStats);
+	aStats.m_tWallStart = std::chrono::steady_clock::now();
+	aStats.m_tCPUStart = std::clock();
+	g_bEnabled = true;
+}
+
+void CPerfStats::countCompare(uint64_t nCells)
+{
+	if (!isEnabled()) return;
+	g_arrCounters[PC_COMPARE_CALLS].fetch_add(1, std::memory_order_relaxed);
+	g_arrCounters[PC_COMPARE_CELLS].fetch_add(nCells, std::memory_order_relaxed);
+	int nBucket = 0;
+	while ((nBucket < (COMPARE_CELL_BUCKETS-1)) && ((nCells >> (nBucket+1)) != 0)) ++nBucket;
+	stats().m_arrCompareCells[nBucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+// ----------------------------------------------------------------------------
+
+CPerfStats::CPhase::CPhase(const char *pszName)
+	:	m_pszName(isEnabled() ? pszName : nullptr),
+		m_tCPUStart(0),
+		m_nAllocStart(0)
+{
+	if (m_pszName) {
+		m_tWallStart = std::chrono::steady_clock::now();
+		m_tCPUStart = std::clock();
+		m_nAllocStart = g_arrCounters[PC_ALLOCATED_BYTES].load(std::memory_order_relaxed);
+	}
+}
+
+CPerfStats::CPhase::~CPhase()
+{
+	if (m_pszName == nullptr) return;
+
+	const double nWallSeconds = seconds(std::chrono::steady_clock::now() - m_tWallStart);
+	const double nCPUSeconds = cpuSeconds(m_tCPUStart, std::clock());
+	const uint64_t nAllocatedBytes = g_arrCounters[PC_ALLOCATED_BYTES].load(std::memory_order_relaxed) - m_nAllocStart;
+
+	TStats &aStats = stats();
+	std::lock_guard<std::mutex> lock(aStats.m_mtxStats);
+	auto itrPhase = std::find_if(aStats.m_arrPhases.begin(), aStats.m_arrPhases.end(), [this](const TPhaseStats &aPhase)->bool {
+		return (std::strcmp(aPhase.m_pszName, m_pszName) == 0);
+	});
+	if (itrPhase == aStats.m_arrPhases.end()) {
+		itrPhase = aStats.m_arrPhases.emplace(aStats.m_arrPhases.end());
+		itrPhase->m_pszName = m_pszName;
+	}
+	++itrPhase->m_nCount;
+	itrPhase->m_nWallSeconds += nWallSeconds;
+	itrPhase->m_nCPUSeconds += nCPUSeconds;
+	itrPhase->m_nAllocatedBytes += nAllocatedBytes;
+}
+
+// ----------------------------------------------------------------------------
+
+void CPerfStats::addThreadPoolRun(const char *pszName, double nWallSeconds, const std::vector<TThreadUsage> &arrThreads)
+{
+	if (!isEnabled()) return;
+
+	TStats &aStats = stats();
+	std::lock_guard<std::mutex> lock(aStats.m_mtxStats);
+	auto itrPool = std::find_if(aStats.m_arrThreadPools.begin(), aStats.m_arrThreadPools.end(), [pszName](const TThreadPoolStats &aPool)->bool {
+		return (std::strcmp(aPool.m_pszName, pszName) == 0);
+	});
+	if (itrPool == aStats.m_arrThreadPools.end()) {
+		itrPool = aStats.m_arrThreadPools.emplace(aStats.m_arrThreadPools.end());
+		itrPool->m_pszName = pszName;
+	}
+	++itrPool->m_nRuns;
+	itrPool->m_nWallSeconds += nWallSeconds;
+	if (itrPool->m_arrThreads.size() < arrThreads.size()) itrPool->m_arrThreads.resize(arrThreads.size());
+	for (std::vector<TThreadUsage>::size_type ndx = 0; ndx < arrThreads.size(); ++ndx) {
+		itrPool->m_arrThreads[ndx].m_nItems += arrThreads[ndx].m_nItems;
+		itrPool->m_arrThreads[ndx].m_nBusySeconds += arrThreads[ndx].m_nBusySeconds;
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+void CPerfStats::report(std::ostream &outFile)
+{
+	TStats &aStats = stats();
+	std::lock_guard<std::mutex> lock(aStats.m_mtxStats);
+
+	const std::ios_base::fmtflags nSavedFlags = outFile.flags();
+	const std::streamsize nSavedPrecision = outFile.precision();
+	outFile << std::fixed << std::setprecision(3);
+
+	outFile << "\nPerformance Statistics:\n";
+	outFile << "    Total : " << seconds(std::chrono::steady_clock::now() - aStats.m_tWallStart) << " s wall, "
+			<< cpuSeconds(aStats.m_tCPUStart, std::clock()) << " s CPU\n";
+
+	outFile << "\n    " << std::left << std::setw(32) << "Phase" << std::right
+			<< std::setw(8) << "Count" << std::setw(12) << "Wall (s)" << std::setw(12) << "CPU (s)"
+			<< std::setw(16) << "Allocated" << "\n";
+	for (auto const & aPhase : aStats.m_arrPhases) {
+		outFile << "    " << std::left << std::setw(32) << aPhase.m_pszName << std::right
+				<< std::setw(8) << aPhase.m_nCount << std::setw(12) << aPhase.m_nWallSeconds << std::setw(12) << aPhase.m_nCPUSeconds
+				<< std::setw(16) << aPhase.m_nAllocatedBytes << "\n";
+	}
+
+	outFile << "\n    Counters:\n";
+	for (int nCounter = 0; nCounter < PC_COUNT; ++nCounter) {
+		outFile << "        " << std::left << std::setw(30) << g_arrCounterDescriptions[nCounter] << std::right
+				<< " : " << g_arrCounters[nCounter].load() << "\n";
+	}
+
+	if (g_arrCounters[PC_COMPARE_CALLS].load() != 0) {
+		outFile << "\n    CompareFunctions Calls by Cells (M*N):\n";
+		for (int nBucket = 0; nBucket < COMPARE_CELL_BUCKETS; ++nBucket) {
+			const uint64_t nCalls = aStats.m_arrCompareCells[nBucket].load();
+			if (nCalls == 0) continue;
+			std::string strRange = std::to_string(nBucket ? (uint64_t(1) << nBucket) : 0) + " - " +
+									((nBucket < (COMPARE_CELL_BUCKETS-1)) ? std::to_string((uint64_t(2) << nBucket) - 1) : std::string("up"));
+			outFile << "        " << std::left << std::setw(30) << strRange << std::right << " : " << nCalls << "\n";
+		}
+	}
+
+	for (auto const & aPool : aStats.m_arrThreadPools) {
+		outFile << "\n    Thread Pool \"" << aPool.m_pszName << "\" : " << aPool.m_nRuns << " run(s), "
+				<< aPool.m_nWallSeconds << " s wall\n";
+		for (std::vector<TThreadUsage>::size_type ndx = 0; ndx < aPool.m_arrThreads.size(); ++ndx) {
+			const TThreadUsage &aThread = aPool.m_arrThreads[ndx];
+			outFile << "        Thread " << std::setw(3) << ndx << " : " << std::setw(10) << aThread.m_nItems << " items, "
+					<< std::setw(10) << aThread.m_nBusySeconds << " s busy ("
+					<< std::setprecision(1) << ((aPool.m_nWallSeconds > 0.0) ? (aThread.m_nBusySeconds * 100.0 / aPool.m_nWallSeconds) : 0.0)
+					<< std::setprecision(3) << "%)\n";
+		}
+	}
+	outFile << "\n";
+
+	outFile.flags(nSavedFlags);
+	outFile.precision(nSavedPrecision);
+}
+
+bool CPerfStats::writeJSON(std::ostream &outFile, const std::string &strProgram)
+{
+	TStats &aStats = stats();
+	std::lock_guard<std::mutex> lock(aStats.m_mtxStats);
+
+	const std::ios_base::fmtflags nSavedFlags = outFile.flags();
+	const std::streamsize nSavedPrecision = outFile.precision();
+	outFile << std::setprecision(9);
+
+	outFile << "{\n";
+	outFile << "\t\"program\": " << jsonString(strProgram) << ",\n";
+	outFile << "\t\"wall_seconds\": " << seconds(std::chrono::steady_clock::now() - aStats.m_tWallStart) << ",\n";
+	outFile << "\t\"cpu_seconds\": " << cpuSeconds(aStats.m_tCPUStart, std::clock()) << ",\n";
+
+	outFile << "\t\"phases\": [";
+	for (std::vector<TPhaseStats>::size_type ndx = 0; ndx < aStats.m_arrPhases.size(); ++ndx) {
+		const TPhaseStats &aPhase = aStats.m_arrPhases[ndx];
+		outFile << (ndx ? "," : "") << "\n\t\t{ \"name\": " << jsonString(aPhase.m_pszName)
+				<< ", \"count\": " << aPhase.m_nCount
+				<< ", \"wall_seconds\": " << aPhase.m_nWallSeconds
+				<< ", \"cpu_seconds\": " << aPhase.m_nCPUSeconds
+				<< ", \"allocated_bytes\": " << aPhase.m_nAllocatedBytes << " }";
+	}
+	outFile << "\n\t],\n";
+
+	outFile << "\t\"counters\": {";
+	for (int nCounter = 0; nCounter < PC_COUNT; ++nCounter) {
+		outFile << (nCounter ? "," : "") << "\n\t\t" << jsonString(g_arrCounterNames[nCounter]) << ": " << g_arrCounters[nCounter].load();
+	}
+	outFile << "\n\t},\n";
+
+	outFile << "\t\"compare_cells_histogram\": [";
+	bool bFirst = true;
+	for (int nBucket = 0; nBucket < COMPARE_CELL_BUCKETS; ++nBucket) {
+		const uint64_t nCalls = aStats.m_arrCompareCells[nBucket].load();
+		if (nCalls == 0) continue;
+		outFile << (bFirst ? "" : ",") << "\n\t\t{ \"min_cells\": " << (nBucket ? (uint64_t(1) << nBucket) : 0) << ", \"calls\": " << nCalls << " }";
+		bFirst = false;
+	}
+	outFile << "\n\t],\n";
+
+	outFile << "\t\"thread_pools\": [";
+	for (std::vector<TThreadPoolStats>::size_type ndxPool = 0; ndxPool < aStats.m_arrThreadPools.size(); ++ndxPool) {
+		const TThreadPoolStats &aPool = aStats.m_arrThreadPools[ndxPool];
+		outFile << (ndxPool ? "," : "") << "\n\t\t{ \"name\": " << jsonString(aPool.m_pszName)
+				<< ", \"runs\": " << aPool.m_nRuns
+				<< ", \"wall_seconds\": " << aPool.m_nWallSeconds
+				<< ", \"threads\": [";
+		for (std::vector<TThreadUsage>::size_type ndx = 0; ndx < aPool.m_arrThreads.size(); ++ndx) {
+			outFile << (ndx ? ", " : " ") << "{ \"items\": " << aPool.m_arrThreads[ndx].m_nItems
+					<< ", \"busy_seconds\": " << aPool.m_arrThreads[ndx].m_nBusySeconds << " }";
+		}
+		outFile << " ] }";
+	}
+	outFile << "\n\t]\n";
+	outFile << "}\n";
+
+	outFile.flags(nSavedFlags);
+	outFile.precision(nSavedPrecision);
+	return outFile.good();
+}
+
+// ----------------------------------------------------------------------------
+
+CPerfStats::CReport::~CReport()
+{
+	if (!isEnabled()) return;
+
+	report(std::cerr);
+	if (!m_strJSONFilename.empty()) {
+		std::ofstream fileJSON(m_strJSONFilename, std::ios_base::out | std::ios_base::trunc);
+		if (!fileJSON.is_open() || !writeJSON(fileJSON, m_strProgram)) {
+			std::cerr << "*** Error: Writing Statistics File \"" << m_strJSONFilename << "\"\n";
+		}
+	}
+}
+
+// ============================================================================
+
+// Global allocation functions, replaced to count allocations while the
+//	statistics are enabled.  Every standard form is replaced, including the
+//	nothrow and aligned ones, so that the operator delete forms, which all
+//	end in std::free(), never get memory from the library's own allocator:
+
+namespace {
+	// Returns nullptr on failure if !bThrow:
+	void *allocateMemory(std::size_t nSize, bool bThrow)
+	{
+		CPerfStats::count(PC_ALLOCATIONS);
+		CPerfStats::count(PC_ALLOCATED_BYTES, nSize);
+		if (nSize == 0) nSize = 1;
+		while (true) {
+			void *pMemory = std::malloc(nSize);
+			if (pMemory) return pMemory;
+			std::new_handler pfnHandler = std::get_new_handler();
+			if (pfnHandler == nullptr) {
+				if (bThrow) throw std::bad_alloc();
+				return nullptr;
+			}
+			if (bThrow) {
+				pfnHandler();
+			} else {
+				try {
+					pfnHandler();
+				} catch (...) {
+					return nullptr;
+				}
+			}
+		}
+	}
+
+	// The aligned forms over-allocate from allocateMemory() and keep the
+	//	original pointer just ahead of the aligned block for freeAligned():
+	void *allocateAligned(std::size_t nSize, std::align_val_t nAlignment, bool bThrow)
+	{
+		std::size_t nAlign = static_cast<std::size_t>(nAlignment);
+		if (nAlign < alignof(void *)) nAlign = alignof(void *);
+		const std::size_t nExtra = nAlign - 1 + sizeof(void *);
+		if (nSize > (static_cast<std::size_t>(-1) - nExtra)) {
+			if (bThrow) throw std::bad_alloc();
+			return nullptr;
+		}
+		void *pMemory = allocateMemory(nSize + nExtra, bThrow);
+		if (pMemory == nullptr) return nullptr;
+		std::uintptr_t nAligned = (reinterpret_cast<std::uintptr_t>(pMemory) + nExtra) & ~static_cast<std::uintptr_t>(nAlign - 1);
+		reinterpret_cast<void **>(nAligned)[-1] = pMemory;
+		return reinterpret_cast<void *>(nAligned);
+	}
+
+	void freeAligned(void *pMemory) noexcept
+	{
+		if (pMemory) std::free(static_cast<void **>(pMemory)[-1]);
+	}
+}
+
+void *operator new(std::size_t nSize)
+{
+	return allocateMemory(nSize, true);
+}
+
+void *operator new[](std::size_t nSize)
+{
+	return allocateMemory(nSize, true);
+}
+
+void *operator new(std::size_t nSize, const std::nothrow_t &) noexcept
+{
+	return allocateMemory(nSize, false);
+}
+
+void *operator new[](std::size_t nSize, const std::nothrow_t &) noexcept
+{
+	return allocateMemory(nSize, false);
+}
+
+void *operator new(std::size_t nSize, std::align_val_t nAlignment)
+{
+	return allocateAligned(nSize, nAlignment, true);
+}
+
+void *operator new[](std::size_t nSize, std::align_val_t nAlignment)
+{
+	return allocateAligned(nSize, nAlignment, true);
+}
+
+void *operator new(std::size_t nSize, std::align_val_t nAlignment, const std::nothrow_t &) noexcept
+{
+	return allocateAligned(nSize, nAlignment, false);
+}
+
+void *operator new[](std::size_t nSize, std::align_val_t nAlignment, const std::nothrow_t &) noexcept
+{
+	return allocateAligned(nSize, nAlignment, false);
+}
+
+void operator delete(void *pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete[](void *pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete(void *pMemory, std::size_t) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete[](void *pMemory, std::size_t) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete(void *pMemory, const std::nothrow_t &) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete[](void *pMemory, const std::nothrow_t &) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete(void *pMemory, std::align_val_t) noexcept
+{
+	freeAligned(pMemory);
+}
+
+void operator delete[](void *pMemory, std::align_val_t) noexcept
+{
+	freeAligned(pMemory);
+}
+
+void operator delete(void *pMemory, std::size_t, std::align_val_t) noexcept
+{
+	freeAligned(pMemory);
+}
+
+void operator delete[](void *pMemory, std::size_t, std::align_val_t) noexcept
+{
+	freeAligned(pMemory);
+}
+
+void operator delete(void *pMemory, std::align_val_t, const std::nothrow_t &) noexcept
+{
+	freeAligned(pMemory);
+}
+
+void operator delete[](void *pMemory, std::align_val_t, const std::nothrow_t &) noexcept
+{
+	freeAligned(pMemory);
+}
+
+// ============================================================================
@@ -0,0 +1,121 @@
+//
+//	Performance Statistics
+//
+//
+//	Generic Code-Seeking Disassembler
+//	Copyright(c)2021 by Donna Whisnant
+//
+
+#ifndef PERF_STATS_H
+#define PERF_STATS_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <stdint.h>
+
+// ============================================================================
+
+enum PERF_COUNTER {
+	PC_OPCODES_DECODED,			// Opcodes read with ReadNextObj(), in any pass
+	PC_ENTRIES_FOLLOWED,		// Code entry points followed by ScanEntries()
+	PC_BRANCHES_FOLLOWED,		// Branch table entries followed by ScanBranches()
+	PC_COMPARE_CALLS,			// CompareFunctions() calls (see countCompare())
+	PC_COMPARE_CELLS,			// Total of M*N, the objects of the two functions compared, over all CompareFunctions() calls
+	PC_DIFF_CALLS,				// DiffFunctions() calls
+	PC_ALLOCATIONS,				// operator new calls
+	PC_ALLOCATED_BYTES,			// Bytes requested from operator new
+	PC_COUNT
+};
+
+//////////////////////////////////////////////////////////////////////
+// CPerfStats Class
+//////////////////////////////////////////////////////////////////////
+//		Opt-in instrumentation for seeing where the time goes (--stats).
+//		While disabled, which is the default, everything here is a flag
+//		check and nothing is recorded.  Once enabled, it records:
+//
+//			Phases : Wall and CPU time, and bytes allocated, of each named
+//				phase (see CPhase), summed over every time it ran.  The CPU
+//				time is of the whole process, so it includes any threads
+//				running at the same time.  Phases can nest, such as the
+//				ReadSourceFile inside of ReadControlFile.
+//			Counters : See PERF_COUNTER, and a histogram of the M*N cells
+//				of the CompareFunctions() calls in powers of two.
+//			Thread Pools : Items run and busy time of each thread of each
+//				runParallelThreads() given a name, summed over its runs.
+//
+//		Everything can be recorded from multiple threads at once.
+class CPerfStats
+{
+public:
+	static constexpr int COMPARE_CELL_BUCKETS = 48;		// Histogram of M*N cells, 0-1, 2-3, 4-7, ..., 2^47 and up
+
+	static void enable();
+	static bool isEnabled() { return g_bEnabled.load(std::memory_order_relaxed); }
+
+	static void count(PERF_COUNTER nCounter, uint64_t nAmount = 1)
+	{
+		if (isEnabled()) g_arrCounters[nCounter].fetch_add(nAmount, std::memory_order_relaxed);
+	}
+	static void countCompare(uint64_t nCells);		// One CompareFunctions() call of M*N cells
+
+	// Times the enclosing scope as the named phase, which should be a
+	//	string literal, as the pointer is kept:
+	class CPhase
+	{
+	public:
+		explicit CPhase(const char *pszName);
+		~CPhase();
+
+		CPhase(const CPhase &) = delete;
+		CPhase &operator=(const CPhase &) = delete;
+
+	private:
+		const char *m_pszName;		// nullptr if not enabled
+		std::chrono::steady_clock::time_point m_tWallStart;
+		std::clock_t m_tCPUStart;
+		uint64_t m_nAllocStart;
+	};
+
+	struct TThreadUsage {
+		uint64_t m_nItems = 0;
+		double m_nBusySeconds = 0.0;
+	};
+	static void addThreadPoolRun(const char *pszName, double nWallSeconds, const std::vector<TThreadUsage> &arrThreads);
+
+	static void report(std::ostream &outFile);		// Human readable summary
+	static bool writeJSON(std::ostream &outFile, const std::string &strProgram);
+
+	// Outputs the statistics, if enabled, when it goes out of scope, so
+	//	that it's done for any exit from main().  That's the summary on
+	//	std::cerr and, if a filename is given, the JSON dump to that file:
+	class CReport
+	{
+	public:
+		CReport(const std::string &strProgram, const std::string &strJSONFilename)
+			:	m_strProgram(strProgram),
+				m_strJSONFilename(strJSONFilename)
+		{ }
+		~CReport();
+
+		CReport(const CReport &) = delete;
+		CReport &operator=(const CReport &) = delete;
+
+	private:
+		std::string m_strProgram;
+		std::string m_strJSONFilename;
+	};
+
+private:
+	static std::atomic<bool> g_bEnabled;
+	static std::atomic<uint64_t> g_arrCounters[PC_COUNT];
+};
+
+// ============================================================================
+
+#endif	// PERF_STATS_H
+
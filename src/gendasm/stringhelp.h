@@ -16,6 +16,7 @@
 #include <locale>
 #include <string_view>
 #include <vector>
+#include <charconv>
 
 typedef std::string TString;
 typedef std::vector<TString> CStringArray;
@@ -47,6 +48,14 @@ static inline TString &trim(TString &s)
 	return ltrim(rtrim(s));
 }
 
+// trim a view from both ends
+static inline std::string_view &trim(std::string_view &s)
+{
+	while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) s.remove_prefix(1);
+	while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) s.remove_suffix(1);
+	return s;
+}
+
 static inline TString &makeUpper(TString &s)
 {
 	std::transform(s.begin(), s.end(), s.begin(), ::toupper);
@@ -69,17 +78,17 @@ static inline int compareNoCase(const TString &s1, const TString &s2)
 	return ((strUpper1 < strUpper2) ? -1 : ((strUpper1 > strUpper2) ? 1 : 0));
 }
 
-static bool equals(std::string_view s1, std::string_view s2) {
+static inline bool equals(std::string_view s1, std::string_view s2) {
 	return (s1.size() == s2.size())
 			&& std::equal(s1.begin(),s1.end(),s2.begin());
 }
 
-static bool starts_with(std::string_view s, std::string_view prefix) {
+static inline bool starts_with(std::string_view s, std::string_view prefix) {
 	return equals(s.substr(0,prefix.size()), prefix);
 }
 
 // padString : Pads a string with spaces up to the specified length.
-static TString padString(const TString &s, TString::size_type nWidth, TString::value_type chrPadChar = ' ', bool bPrepend = false)
+static inline TString padString(const TString &s, TString::size_type nWidth, TString::value_type chrPadChar = ' ', bool bPrepend = false)
 {
 	TString strRetVal = s;
 
@@ -91,6 +100,28 @@ static TString padString(const TString &s, TString::size_type nWidth, TString::v
 	return strRetVal;
 }
 
+// appendHex : Appends nValue in uppercase hex, zero-padded to at least nWidth
+//	digits.  Same output as streaming it with std::uppercase, std::setfill('0'),
+//	std::setw(nWidth), and std::setbase(16), but without a stringstream:
+static inline TString &appendHex(TString &s, unsigned long long nValue, int nWidth = 0)
+{
+	char arrDigits[16];
+	char *pEnd = std::to_chars(arrDigits, arrDigits + sizeof(arrDigits), nValue, 16).ptr;
+	int nDigits = static_cast<int>(pEnd - arrDigits);
+	if (nDigits < nWidth) s.append(nWidth - nDigits, '0');
+	for (char *pDigit = arrDigits; pDigit < pEnd; ++pDigit) {
+		s.push_back(((*pDigit >= 'a') && (*pDigit <= 'f')) ? (*pDigit - 'a' + 'A') : *pDigit);
+	}
+	return s;
+}
+
+// hexString : Returns nValue formatted by appendHex:
+static inline TString hexString(unsigned long long nValue, int nWidth = 0)
+{
+	TString strHex;
+	return appendHex(strHex, nValue, nWidth);
+}
+
 // ============================================================================
 
 #endif		// STRING_HELP_H
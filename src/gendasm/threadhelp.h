@@ -0,0 +1,71 @@
+//
+//	Thread Helper Functions
+//
+//
+//	Generic Code-Seeking Disassembler
+//	Copyright(c)2021 by Donna Whisnant
+//
+
+#ifndef THREAD_HELP_H
+#define THREAD_HELP_H
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+
+#include "perfstats.h"
+
+// ============================================================================
+
+// Runs fnWork(0) through fnWork(nCount-1) across nThreadCount threads, one
+//	of which is the calling thread.  Each thread claims the next work item
+//	from a shared atomic counter as it finishes its last one, so no thread
+//	sits idle while work remains.  Callers should order the items with the
+//	most expensive ones first so the cheap ones fill in the gaps at the end.
+//	If pszStatsName is given and CPerfStats is enabled, the items and busy
+//	time of each thread are recorded under that name:
+template<typename TFunction>
+void runParallelThreads(std::size_t nCount, unsigned int nThreadCount, const TFunction &fnWork, const char *pszStatsName = nullptr)
+{
+	nThreadCount = std::max<std::size_t>(std::min<std::size_t>(nThreadCount, nCount), 1);
+	const bool bStats = (pszStatsName != nullptr) && CPerfStats::isEnabled();
+	std::vector<CPerfStats::TThreadUsage> arrUsage(bStats ? nThreadCount : 0);
+	const auto tStart = std::chrono::steady_clock::now();
+
+	std::atomic<std::size_t> nNextItem = 0;
+	auto const &&fnWorker = [&](unsigned int nThread)->void {
+		std::size_t ndxItem;
+		if (bStats) {
+			CPerfStats::TThreadUsage &aUsage = arrUsage[nThread];
+			while ((ndxItem = nNextItem++) < nCount) {
+				const auto tItemStart = std::chrono::steady_clock::now();
+				fnWork(ndxItem);
+				aUsage.m_nBusySeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - tItemStart).count();
+				++aUsage.m_nItems;
+			}
+		} else {
+			while ((ndxItem = nNextItem++) < nCount) fnWork(ndxItem);
+		}
+	};
+
+	std::vector<std::unique_ptr<std::thread>> arrThreads;
+	for (unsigned int nThread = 1; nThread < nThreadCount; ++nThread) {
+		arrThreads.push_back(std::make_unique<std::thread>(fnWorker, nThread));
+	}
+	fnWorker(0);		// Main thread does work too
+	for (auto &pThread : arrThreads) {
+		pThread->join();
+	}
+
+	if (bStats) {
+		CPerfStats::addThreadPoolRun(pszStatsName, std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count(), arrUsage);
+	}
+}
+
+// ============================================================================
+
+#endif	// THREAD_HELP_H
+